@@ -0,0 +1,120 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      Synthetic cassettes generator.
+ * @discussion Generator compose chapters from \c seed and chapter's index, so same chapter can be written to cassette and re-created
+ *             later to send request which will match to it.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVCassetteGenerator : NSObject
+
+
+#pragma mark Information
+
+/**
+ * @brief  Stores number of chapters which will be written to cassette.
+ */
+@property (nonatomic, readonly, assign) NSUInteger chaptersCount;
+
+/**
+ * @brief      Stores number of hosts between which requests will be spread.
+ * @discussion By default set to: \c 4.
+ */
+@property (nonatomic, assign) NSUInteger hostsCount;
+
+/**
+ * @brief      Stores ratio (from \c 0 to \c 1) of \c POST requests with JSON body.
+ * @discussion By default set to: \c 0.3.
+ */
+@property (nonatomic, assign) double POSTRequestsRatio;
+
+/**
+ * @brief      Stores ratio (from \c 0 to \c 1) of responses with JSON body. Rest of responses will have binary body.
+ * @discussion By default set to: \c 0.7.
+ */
+@property (nonatomic, assign) double JSONResponsesRatio;
+
+/**
+ * @brief      Stores minimum length of response body.
+ * @discussion By default set to: \c 0.
+ */
+@property (nonatomic, assign) NSUInteger minimumBodyLength;
+
+/**
+ * @brief      Stores maximum length of response body.
+ * @discussion By default set to: \c 16384.
+ */
+@property (nonatomic, assign) NSUInteger maximumBodyLength;
+
+/**
+ * @brief      Stores value which is used to generate chapters.
+ * @discussion By default set to: \c 1.
+ */
+@property (nonatomic, assign) uint64_t seed;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Create and configure cassettes generator.
+ *
+ * @param count Number of chapters which should be written to cassette.
+ *
+ * @return Configured and ready to use generator.
+ */
++ (instancetype)generatorWithChaptersCount:(NSUInteger)count;
+
+
+#pragma mark - Chapters
+
+/**
+ * @brief  Create request which is recorded in chapter at specified \c index.
+ *
+ * @param index Index of chapter for which request should be created.
+ *
+ * @return Reference on new request instance (each call return new instance which doesn't have any VCR data attached).
+ */
+- (NSMutableURLRequest *)requestAtIndex:(NSUInteger)index;
+
+/**
+ * @brief  Create response which is recorded in chapter at specified \c index.
+ *
+ * @param index Index of chapter for which response should be created.
+ *
+ * @return Reference on HTTP response.
+ */
+- (NSHTTPURLResponse *)responseAtIndex:(NSUInteger)index;
+
+/**
+ * @brief  Create response body which is recorded in chapter at specified \c index.
+ *
+ * @param index Index of chapter for which response body should be created.
+ *
+ * @return Reference on response body.
+ */
+- (NSData *)dataAtIndex:(NSUInteger)index;
+
+
+#pragma mark - Cassette
+
+/**
+ * @brief      Write generated chapters to cassette's file.
+ * @discussion Cassette written in same format as recorded by VCR (\c .json or \c .plist depending from \c path extension).
+ *
+ * @param path Full path to cassette's file.
+ *
+ * @return Whether cassette has been written or not.
+ */
+- (BOOL)writeCassetteToPath:(NSString *)path;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,265 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVCassetteGenerator.h"
+#import <YAHTTPVCR/YHVScene.h>
+
+
+#pragma mark Functions
+
+/**
+ * @brief      Compute pseudo-random value.
+ * @discussion Function implement \c splitmix64 generator step, so same \c state always give same value.
+ *
+ * @param state Pointer on generator state which will be advanced.
+ *
+ * @return Pseudo-random value.
+ */
+static uint64_t YHVCassetteGeneratorNextValue(uint64_t *state) {
+    
+    uint64_t value = (*state += 0x9E3779B97F4A7C15ULL);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    
+    return value ^ (value >> 31);
+}
+
+
+#pragma mark - Structures
+
+/**
+ * @brief  Parameters of generated chapter.
+ */
+typedef struct YHVGeneratedChapter {
+    
+    /**
+     * @brief  Index of host to which request has been sent.
+     */
+    NSUInteger host;
+    
+    /**
+     * @brief  Whether request is \c POST request or not.
+     */
+    BOOL POSTRequest;
+    
+    /**
+     * @brief  Whether response body is JSON or not.
+     */
+    BOOL JSONResponse;
+    
+    /**
+     * @brief  Response body length.
+     */
+    NSUInteger bodyLength;
+    
+    /**
+     * @brief  Generator state which can be used to generate chapter's data.
+     */
+    uint64_t state;
+} YHVGeneratedChapter;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Private interface declaration
+
+@interface YHVCassetteGenerator ()
+
+
+#pragma mark - Information
+
+@property (nonatomic, assign) NSUInteger chaptersCount;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize cassettes generator.
+ *
+ * @param count Number of chapters which should be written to cassette.
+ *
+ * @return Initialized and ready to use generator.
+ */
+- (instancetype)initWithChaptersCount:(NSUInteger)count;
+
+
+#pragma mark - Chapters
+
+/**
+ * @brief  Compute parameters of chapter at specified \c index.
+ *
+ * @param index Index of chapter for which parameters should be computed.
+ *
+ * @return Chapter's parameters.
+ */
+- (YHVGeneratedChapter)chapterAtIndex:(NSUInteger)index;
+
+/**
+ * @brief  Compose unique identifier of chapter at specified \c index.
+ *
+ * @param index Index of chapter for which identifier should be created.
+ *
+ * @return Chapter's identifier.
+ */
+- (NSString *)identifierForChapterAtIndex:(NSUInteger)index;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVCassetteGenerator
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)generatorWithChaptersCount:(NSUInteger)count {
+    
+    return [[self alloc] initWithChaptersCount:count];
+}
+
+- (instancetype)initWithChaptersCount:(NSUInteger)count {
+    
+    if ((self = [super init])) {
+        _maximumBodyLength = 16384;
+        _JSONResponsesRatio = 0.7f;
+        _POSTRequestsRatio = 0.3f;
+        _chaptersCount = count;
+        _hostsCount = 4;
+        _seed = 1;
+    }
+    
+    return self;
+}
+
+
+#pragma mark - Chapters
+
+- (NSMutableURLRequest *)requestAtIndex:(NSUInteger)index {
+    
+    YHVGeneratedChapter chapter = [self chapterAtIndex:index];
+    NSString *url = [NSString stringWithFormat:@"https://host%@.yahttpvcr.test/api/v1/resources/%@?page=%@&limit=50&token=%016llx",
+                     @(chapter.host), @(index), @(index % 50), YHVCassetteGeneratorNextValue(&chapter.state)];
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:url]];
+    [request setValue:@"application/json" forHTTPHeaderField:@"Accept"];
+    [request setValue:[@(index) stringValue] forHTTPHeaderField:@"X-Request-Index"];
+    
+    if (chapter.POSTRequest) {
+        NSDictionary *body = @{ @"index": @(index), @"query": [NSString stringWithFormat:@"%016llx", chapter.state] };
+        
+        request.HTTPMethod = @"POST";
+        request.HTTPBody = [NSJSONSerialization dataWithJSONObject:body options:(NSJSONWritingOptions)0 error:nil];
+        [request setValue:@"application/json" forHTTPHeaderField:@"Content-Type"];
+    }
+    
+    return request;
+}
+
+- (NSHTTPURLResponse *)responseAtIndex:(NSUInteger)index {
+    
+    YHVGeneratedChapter chapter = [self chapterAtIndex:index];
+    NSString *contentType = chapter.JSONResponse ? @"application/json" : @"application/octet-stream";
+    NSDictionary *headers = @{
+        @"Content-Type": contentType,
+        @"Cache-Control": @"no-cache"
+    };
+    
+    return [[NSHTTPURLResponse alloc] initWithURL:[self requestAtIndex:index].URL
+                                       statusCode:200
+                                      HTTPVersion:@"HTTP/1.1"
+                                     headerFields:headers];
+}
+
+- (NSData *)dataAtIndex:(NSUInteger)index {
+    
+    YHVGeneratedChapter chapter = [self chapterAtIndex:index];
+    NSMutableData *data = [NSMutableData dataWithLength:chapter.bodyLength];
+    uint8_t *bytes = data.mutableBytes;
+    
+    if (chapter.JSONResponse) {
+        NSData *prefix = [[NSString stringWithFormat:@"{\"index\":%@,\"payload\":\"", @(index)] dataUsingEncoding:NSUTF8StringEncoding];
+        static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+        
+        if (chapter.bodyLength < prefix.length + 2) {
+            return [NSJSONSerialization dataWithJSONObject:@{ @"index": @(index) } options:(NSJSONWritingOptions)0 error:nil];
+        }
+        
+        memcpy(bytes, prefix.bytes, prefix.length);
+        
+        for (NSUInteger byteIdx = prefix.length; byteIdx < chapter.bodyLength - 2; byteIdx++) {
+            bytes[byteIdx] = (uint8_t)alphabet[YHVCassetteGeneratorNextValue(&chapter.state) % (sizeof(alphabet) - 1)];
+        }
+        
+        memcpy(bytes + chapter.bodyLength - 2, "\"}", 2);
+    } else {
+        for (NSUInteger byteIdx = 0; byteIdx < chapter.bodyLength; byteIdx += sizeof(uint64_t)) {
+            uint64_t value = YHVCassetteGeneratorNextValue(&chapter.state);
+            
+            memcpy(bytes + byteIdx, &value, MIN(sizeof(uint64_t), chapter.bodyLength - byteIdx));
+        }
+    }
+    
+    return data;
+}
+
+- (YHVGeneratedChapter)chapterAtIndex:(NSUInteger)index {
+    
+    YHVGeneratedChapter chapter;
+    chapter.state = self.seed ^ ((uint64_t)index * 0xD6E8FEB86659FD93ULL);
+    NSUInteger bodyLengthRange = self.maximumBodyLength > self.minimumBodyLength ? self.maximumBodyLength - self.minimumBodyLength : 0;
+    
+    chapter.host = (NSUInteger)(YHVCassetteGeneratorNextValue(&chapter.state) % MAX(self.hostsCount, 1));
+    chapter.POSTRequest = (YHVCassetteGeneratorNextValue(&chapter.state) % 1000) < self.POSTRequestsRatio * 1000;
+    chapter.JSONResponse = (YHVCassetteGeneratorNextValue(&chapter.state) % 1000) < self.JSONResponsesRatio * 1000;
+    chapter.bodyLength = self.minimumBodyLength + (NSUInteger)(YHVCassetteGeneratorNextValue(&chapter.state) % (bodyLengthRange + 1));
+    
+    return chapter;
+}
+
+- (NSString *)identifierForChapterAtIndex:(NSUInteger)index {
+    
+    return [NSString stringWithFormat:@"00000000-0000-0000-%04llX-%012lX", self.seed & 0xFFFF, (unsigned long)index];
+}
+
+
+#pragma mark - Cassette
+
+- (BOOL)writeCassetteToPath:(NSString *)path {
+    
+    NSMutableArray<NSDictionary *> *scenes = [NSMutableArray arrayWithCapacity:self.chaptersCount * 4];
+    
+    for (NSUInteger chapterIdx = 0; chapterIdx < self.chaptersCount; chapterIdx++) {
+        @autoreleasepool {
+            NSString *identifier = [self identifierForChapterAtIndex:chapterIdx];
+            NSHTTPURLResponse *response = [self responseAtIndex:chapterIdx];
+            YHVScene *dataScene = [YHVScene sceneWithIdentifier:identifier type:YHVDataScene data:[self dataAtIndex:chapterIdx]];
+            dataScene.contentType = response.allHeaderFields[@"Content-Type"];
+            
+            [scenes addObject:[[YHVScene sceneWithIdentifier:identifier type:YHVRequestScene data:[self requestAtIndex:chapterIdx]]
+                               YHV_dictionaryRepresentation]];
+            [scenes addObject:[[YHVScene sceneWithIdentifier:identifier type:YHVResponseScene data:response]
+                               YHV_dictionaryRepresentation]];
+            [scenes addObject:[dataScene YHV_dictionaryRepresentation]];
+            [scenes addObject:[[YHVScene sceneWithIdentifier:identifier type:YHVClosingScene data:nil] YHV_dictionaryRepresentation]];
+        }
+    }
+    
+    if ([[path pathExtension] isEqualToString:@"json"]) {
+        NSData *jsonData = [NSJSONSerialization dataWithJSONObject:scenes options:(NSJSONWritingOptions)0 error:nil];
+        
+        return [jsonData writeToFile:path atomically:YES];
+    }
+    
+    return [scenes writeToFile:path atomically:YES];
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,438 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import <XCTest/XCTest.h>
+#import <YAHTTPVCR/YHVLoadReplayReport+Private.h>
+#import <YAHTTPVCR/YHVVCR+Recorder.h>
+#import <YAHTTPVCR/YHVVCR+Player.h>
+#import <YAHTTPVCR/YAHTTPVCR.h>
+#import "YHVCassetteGenerator.h"
+#import <mach/mach.h>
+
+
+#pragma mark Constants
+
+/**
+ * @brief  Name of environment variable which can be used to pass comma-separated list of generated cassettes chapters count.
+ * @discussion Benchmarks will be skipped if this variable not set (for example: '10,1000').
+ */
+static NSString * const kYHVBenchmarkChaptersEnvironmentKey = @"YHV_BENCHMARK_CHAPTERS";
+
+/**
+ * @brief  Name of environment variable which can be used to pass full path to file into which results should be written.
+ */
+static NSString * const kYHVBenchmarkResultsPathEnvironmentKey = @"YHV_BENCHMARK_RESULTS_PATH";
+
+/**
+ * @brief  Maximum number of requests which is used to measure matching latency.
+ */
+static NSUInteger const kYHVBenchmarkMatchedRequestsCount = 1000;
+
+/**
+ * @brief  Maximum number of requests which is sent through \a NSURLSession during replay.
+ */
+static NSUInteger const kYHVBenchmarkReplayedRequestsCount = 10000;
+
+
+#pragma mark - Functions
+
+/**
+ * @brief  Retrieve current process memory footprint.
+ *
+ * @return Memory footprint in bytes.
+ */
+static uint64_t YHVBenchmarkMemoryFootprint(void) {
+    
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+    task_vm_info_data_t info;
+    
+    if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    
+    return info.phys_footprint;
+}
+
+
+@interface YHVCassettePerformanceTest : XCTestCase
+
+
+#pragma mark - Information
+
+@property (nonatomic, copy) NSString *cassettesPath;
+
+/**
+ * @brief  Stores reference on list of generated cassettes chapters count.
+ */
+@property (nonatomic, copy) NSArray<NSNumber *> *chaptersCounts;
+
+
+#pragma mark - Results
+
+/**
+ * @brief  Stores reference on list of results which will be written at the end of test case run.
+ */
++ (NSMutableArray<NSDictionary *> *)results;
+
+/**
+ * @brief  Store benchmark results.
+ *
+ * @param result    Reference on measured values.
+ * @param benchmark Name of benchmark for which values has been measured.
+ */
+- (void)storeResult:(NSDictionary *)result forBenchmark:(NSString *)benchmark;
+
+
+#pragma mark - Misc
+
+/**
+ * @brief  Execute block and measure it's duration and peak memory usage.
+ *
+ * @param block Reference on block which should be measured.
+ *
+ * @return Dictionary with \c duration (in seconds) and \c peakMemory (in bytes above footprint before block call).
+ */
+- (NSDictionary *)durationAndPeakMemoryOfBlock:(dispatch_block_t)block;
+
+/**
+ * @brief  Compose list of matchers mixes which should be used to measure matching latency.
+ *
+ * @return Dictionary where each key is name of mix and value is list of matchers.
+ */
+- (NSDictionary<NSString *, NSArray<NSString *> *> *)matchersMixes;
+
+#pragma mark -
+
+
+@end
+
+
+@implementation YHVCassettePerformanceTest
+
+
+#pragma mark - Results
+
++ (NSMutableArray<NSDictionary *> *)results {
+    
+    static NSMutableArray<NSDictionary *> *_results;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _results = [NSMutableArray new];
+    });
+    
+    return _results;
+}
+
+- (void)storeResult:(NSDictionary *)result forBenchmark:(NSString *)benchmark {
+    
+    NSMutableDictionary *storedResult = [NSMutableDictionary dictionaryWithDictionary:result];
+    storedResult[@"benchmark"] = benchmark;
+    
+    [[[self class] results] addObject:storedResult];
+}
+
+
+#pragma mark - Setup / Tear down
+
++ (void)tearDown {
+    
+    if (![self results].count) {
+        [super tearDown];
+        
+        return;
+    }
+    
+    NSString *path = NSProcessInfo.processInfo.environment[kYHVBenchmarkResultsPathEnvironmentKey];
+    path = path ?: [NSTemporaryDirectory() stringByAppendingPathComponent:@"YHVBenchmarkResults.json"];
+    NSDictionary *report = @{
+        @"system": NSProcessInfo.processInfo.operatingSystemVersionString,
+        @"processors": @(NSProcessInfo.processInfo.activeProcessorCount),
+        @"date": @((NSUInteger)[NSDate date].timeIntervalSince1970),
+        @"results": [self results]
+    };
+    
+    NSData *reportData = [NSJSONSerialization dataWithJSONObject:report options:NSJSONWritingPrettyPrinted error:nil];
+    
+    if ([reportData writeToFile:path atomically:YES]) {
+        NSLog(@"Benchmark results written to: %@", path);
+    }
+    
+    [super tearDown];
+}
+
+- (BOOL)setUpWithError:(NSError **)error {
+    
+    NSString *chaptersCounts = NSProcessInfo.processInfo.environment[kYHVBenchmarkChaptersEnvironmentKey];
+    
+    // Benchmarks generate and replay large cassettes, so they run only on demand and doesn't slow down regular unit tests run.
+    XCTSkipUnless(chaptersCounts.length, @"Set %@ (for example '10,1000') to run cassette benchmarks.", kYHVBenchmarkChaptersEnvironmentKey);
+    
+    return [super setUpWithError:error];
+}
+
+- (void)setUp {
+    
+    [super setUp];
+    
+    NSString *chaptersCounts = NSProcessInfo.processInfo.environment[kYHVBenchmarkChaptersEnvironmentKey];
+    self.cassettesPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    self.chaptersCounts = [[chaptersCounts componentsSeparatedByString:@","] valueForKey:@"integerValue"];
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+    }];
+}
+
+- (void)tearDown {
+    
+    [YHVVCR ejectCassette];
+    [NSFileManager.defaultManager removeItemAtPath:self.cassettesPath error:nil];
+    
+    [super tearDown];
+}
+
+
+#pragma mark - Tests :: Load / Save
+
+- (void)testCassettePerformance_ShouldLoadGeneratedCassettes {
+    
+    for (NSNumber *chaptersCount in self.chaptersCounts) {
+        for (NSString *extension in @[@"json", @"plist"]) {
+            YHVCassetteGenerator *generator = [YHVCassetteGenerator generatorWithChaptersCount:chaptersCount.unsignedIntegerValue];
+            NSString *cassettePath = [NSString stringWithFormat:@"load-%@.%@", chaptersCount, extension];
+            NSString *path = [self.cassettesPath stringByAppendingPathComponent:cassettePath];
+            __block YHVCassette *cassette = nil;
+            
+            XCTAssertTrue([generator writeCassetteToPath:path]);
+            
+            NSDictionary *result = [self durationAndPeakMemoryOfBlock:^{
+                cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+                    configuration.cassettePath = cassettePath;
+                    configuration.recordMode = YHVRecordNone;
+                }];
+            }];
+            
+            XCTAssertEqual(cassette.requests.count, chaptersCount.unsignedIntegerValue);
+            [YHVVCR ejectCassette];
+            
+            NSMutableDictionary *storedResult = [result mutableCopy];
+            storedResult[@"fileSize"] = [NSFileManager.defaultManager attributesOfItemAtPath:path error:nil][NSFileSize];
+            storedResult[@"chapters"] = chaptersCount;
+            storedResult[@"format"] = extension;
+            [self storeResult:storedResult forBenchmark:@"load"];
+        }
+    }
+}
+
+- (void)testCassettePerformance_ShouldRecordAndSaveGeneratedChapters {
+    
+    for (NSNumber *chaptersCount in self.chaptersCounts) {
+        YHVCassetteGenerator *generator = [YHVCassetteGenerator generatorWithChaptersCount:chaptersCount.unsignedIntegerValue];
+        NSString *cassettePath = [NSString stringWithFormat:@"record-%@.json", chaptersCount];
+        CFAbsoluteTime recordDuration = 0.f;
+        NSUInteger recordedBytes = 0;
+        
+        YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+            configuration.cassettePath = cassettePath;
+            configuration.recordMode = YHVRecordAll;
+        }];
+        
+        for (NSUInteger chapterIdx = 0; chapterIdx < generator.chaptersCount; chapterIdx++) {
+            @autoreleasepool {
+                NSHTTPURLResponse *response = [generator responseAtIndex:chapterIdx];
+                NSURLRequest *request = [generator requestAtIndex:chapterIdx];
+                NSData *data = [generator dataAtIndex:chapterIdx];
+                CFAbsoluteTime startDate = CFAbsoluteTimeGetCurrent();
+                
+                [YHVVCR canPlayResponseForRequest:request];
+                [YHVVCR beginRecordingRequest:request];
+                [YHVVCR recordResponse:response forRequest:request];
+                [YHVVCR recordData:data forRequest:request];
+                [YHVVCR recordCompletionWithError:nil forRequest:request];
+                
+                recordDuration += CFAbsoluteTimeGetCurrent() - startDate;
+                recordedBytes += data.length;
+            }
+        }
+        
+        XCTAssertEqual(cassette.requests.count, generator.chaptersCount);
+        
+        NSMutableDictionary *result = [[self durationAndPeakMemoryOfBlock:^{
+            [YHVVCR ejectCassette];
+        }] mutableCopy];
+        
+        result[@"chapters"] = chaptersCount;
+        [self storeResult:result forBenchmark:@"save"];
+        [self storeResult:@{
+            @"chapters": chaptersCount,
+            @"duration": @(recordDuration),
+            @"requestsPerSecond": @(recordDuration > 0.f ? generator.chaptersCount / recordDuration : 0.f),
+            @"bytesPerSecond": @(recordDuration > 0.f ? recordedBytes / recordDuration : 0.f)
+        } forBenchmark:@"record"];
+    }
+}
+
+
+#pragma mark - Tests :: Match
+
+- (void)testCassettePerformance_ShouldMatchRequestsWithMatchersMixes {
+    
+    NSDictionary<NSString *, NSArray<NSString *> *> *matchersMixes = [self matchersMixes];
+    
+    for (NSNumber *chaptersCount in self.chaptersCounts) {
+        YHVCassetteGenerator *generator = [YHVCassetteGenerator generatorWithChaptersCount:chaptersCount.unsignedIntegerValue];
+        NSString *cassettePath = [NSString stringWithFormat:@"match-%@.json", chaptersCount];
+        NSUInteger matchedCount = MIN(generator.chaptersCount, kYHVBenchmarkMatchedRequestsCount);
+        NSUInteger step = MAX(generator.chaptersCount / MAX(matchedCount, 1), 1);
+        
+        XCTAssertTrue([generator writeCassetteToPath:[self.cassettesPath stringByAppendingPathComponent:cassettePath]]);
+        
+        for (NSString *mix in matchersMixes) {
+            NSMutableArray<NSNumber *> *latencies = [NSMutableArray arrayWithCapacity:matchedCount];
+            
+            [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+                configuration.playbackMode = YHVMomentaryPlayback;
+                configuration.matchers = matchersMixes[mix];
+                configuration.cassettePath = cassettePath;
+                configuration.recordMode = YHVRecordNone;
+            }];
+            
+            for (NSUInteger requestIdx = 0; requestIdx < matchedCount; requestIdx++) {
+                NSURLRequest *request = [generator requestAtIndex:(requestIdx * step) % generator.chaptersCount];
+                CFAbsoluteTime startDate = CFAbsoluteTimeGetCurrent();
+                BOOL canPlay = [YHVVCR canPlayResponseForRequest:request];
+                
+                [latencies addObject:@(CFAbsoluteTimeGetCurrent() - startDate)];
+                XCTAssertTrue(canPlay);
+            }
+            
+            [YHVVCR ejectCassette];
+            
+            // Load replay report used to get same nearest-rank percentiles as reported by load replayer.
+            YHVLoadReplayReport *report = [YHVLoadReplayReport reportWithLatencies:latencies requestsCount:matchedCount
+                                                               failedRequestsCount:0 mismatchedResponsesCount:0 mismatches:@[]
+                                                                          duration:0.f];
+            
+            [self storeResult:@{
+                @"chapters": chaptersCount,
+                @"matchers": mix,
+                @"requests": @(matchedCount),
+                @"mean": [latencies valueForKeyPath:@"@avg.doubleValue"],
+                @"p50": @(report.medianLatency),
+                @"p99": @(report.p99Latency),
+                @"max": @(report.maximumLatency)
+            } forBenchmark:@"match"];
+        }
+    }
+}
+
+
+#pragma mark - Tests :: Replay
+
+- (void)testCassettePerformance_ShouldReplayResponsesThroughURLProtocol {
+    
+    for (NSNumber *chaptersCount in self.chaptersCounts) {
+        YHVCassetteGenerator *generator = [YHVCassetteGenerator generatorWithChaptersCount:chaptersCount.unsignedIntegerValue];
+        NSString *cassettePath = [NSString stringWithFormat:@"replay-%@.json", chaptersCount];
+        NSUInteger requestsCount = MIN(generator.chaptersCount, kYHVBenchmarkReplayedRequestsCount);
+        NSMutableArray<NSURLRequest *> *requests = [NSMutableArray arrayWithCapacity:requestsCount];
+        
+        XCTAssertTrue([generator writeCassetteToPath:[self.cassettesPath stringByAppendingPathComponent:cassettePath]]);
+        
+        for (NSUInteger requestIdx = 0; requestIdx < requestsCount; requestIdx++) {
+            [requests addObject:[generator requestAtIndex:requestIdx]];
+        }
+        
+        [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+            configuration.playbackMode = YHVMomentaryPlayback;
+            configuration.cassettePath = cassettePath;
+            configuration.recordMode = YHVRecordNone;
+        }];
+        
+        NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+        configuration.HTTPMaximumConnectionsPerHost = 16;
+        NSURLSession *session = [NSURLSession sessionWithConfiguration:configuration];
+        dispatch_group_t group = dispatch_group_create();
+        __block NSUInteger failedCount = 0;
+        __block NSUInteger receivedBytes = 0;
+        
+        NSMutableDictionary *result = [[self durationAndPeakMemoryOfBlock:^{
+            for (NSURLRequest *request in requests) {
+                dispatch_group_enter(group);
+                
+                [[session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+                    @synchronized (group) {
+                        failedCount += error ? 1 : 0;
+                        receivedBytes += data.length;
+                    }
+                    
+                    dispatch_group_leave(group);
+                }] resume];
+            }
+            
+            dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+        }] mutableCopy];
+        
+        [session invalidateAndCancel];
+        [YHVVCR ejectCassette];
+        XCTAssertEqual(failedCount, 0);
+        
+        double duration = ((NSNumber *)result[@"duration"]).doubleValue;
+        result[@"chapters"] = chaptersCount;
+        result[@"requests"] = @(requestsCount);
+        result[@"failed"] = @(failedCount);
+        result[@"requestsPerSecond"] = @(duration > 0.f ? requestsCount / duration : 0.f);
+        result[@"bytesPerSecond"] = @(duration > 0.f ? receivedBytes / duration : 0.f);
+        [self storeResult:result forBenchmark:@"replay"];
+    }
+}
+
+
+#pragma mark - Misc
+
+- (NSDictionary *)durationAndPeakMemoryOfBlock:(dispatch_block_t)block {
+    
+    dispatch_queue_t queue = dispatch_queue_create("com.yetanotherhttpvcr.benchmark", DISPATCH_QUEUE_SERIAL);
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, queue);
+    uint64_t initialFootprint = YHVBenchmarkMemoryFootprint();
+    __block uint64_t peakFootprint = initialFootprint;
+    
+    dispatch_source_set_timer(timer, DISPATCH_TIME_NOW, NSEC_PER_MSEC, 0);
+    dispatch_source_set_event_handler(timer, ^{
+        peakFootprint = MAX(peakFootprint, YHVBenchmarkMemoryFootprint());
+    });
+    dispatch_resume(timer);
+    
+    CFAbsoluteTime startDate = CFAbsoluteTimeGetCurrent();
+    
+    @autoreleasepool {
+        block();
+    }
+    
+    CFAbsoluteTime duration = CFAbsoluteTimeGetCurrent() - startDate;
+    dispatch_source_cancel(timer);
+    
+    dispatch_sync(queue, ^{
+        peakFootprint = MAX(peakFootprint, YHVBenchmarkMemoryFootprint());
+    });
+    
+    return @{ @"duration": @(duration), @"peakMemory": @(peakFootprint - initialFootprint) };
+}
+
+- (NSDictionary<NSString *, NSArray<NSString *> *> *)matchersMixes {
+    
+    NSArray<NSString *> *components = @[YHVMatcher.method, YHVMatcher.scheme, YHVMatcher.host, YHVMatcher.port, YHVMatcher.path,
+                                        YHVMatcher.query];
+    
+    return @{
+        @"method+uri": @[YHVMatcher.method, YHVMatcher.uri],
+        @"components": components,
+        @"components+headers+body": [components arrayByAddingObjectsFromArray:@[YHVMatcher.headers, YHVMatcher.body]]
+    };
+}
+
+#pragma mark -
+
+
+@end
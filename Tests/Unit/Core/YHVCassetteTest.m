@@ -0,0 +1,707 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import <XCTest/XCTest.h>
+#import <YAHTTPVCR/NSURLRequest+YHVPlayer.h>
+#import <YAHTTPVCR/YHVCassette+Private.h>
+#import <YAHTTPVCR/YHVVCR+Recorder.h>
+#import <YAHTTPVCR/YHVVCR+Player.h>
+#import <YAHTTPVCR/YHVMatchIndex.h>
+#import <YAHTTPVCR/YAHTTPVCR.h>
+#import <YAHTTPVCR/YHVScene.h>
+
+
+@interface YHVCassetteTest : XCTestCase <NSURLSessionDataDelegate>
+
+
+#pragma mark - Information
+
+@property (nonatomic, copy) NSString *cassettesPath;
+@property (nonatomic, copy) NSString *cassettePath;
+
+/**
+ * @brief      Stores reference on list of chunks which has been received by session's delegate.
+ * @discussion Each entry contain chunk's \c data, \c date when it has been received and whether data scene has been marked as
+ *             \c played at that moment.
+ */
+@property (nonatomic, strong) NSMutableArray<NSDictionary *> *receivedChunks;
+@property (nonatomic, strong) XCTestExpectation *completionExpectation;
+
+
+#pragma mark - Misc
+
+/**
+ * @brief  Record chapters with specified body for each of \c requests and save cassette.
+ *
+ * @param requests Reference on list of requests for which chapters should be recorded.
+ * @param data     Reference on response body which should be recorded for each request.
+ */
+- (void)recordChaptersForRequests:(NSArray<NSURLRequest *> *)requests withData:(NSData *)data;
+
+/**
+ * @brief      Start \c request recording and pass response body to recorder in chunks.
+ * @discussion Request completion not recorded, so caller can inspect cassette state before chapter will be closed.
+ *
+ * @param data        Reference on response body which should be recorded.
+ * @param chunkLength Maximum length of single chunk which is passed to recorder.
+ * @param response    Reference on response which should be recorded before body.
+ * @param request     Reference on request for which chapter should be recorded.
+ */
+- (void)recordData:(NSData *)data
+   inChunksOfLength:(NSUInteger)chunkLength
+       withResponse:(NSHTTPURLResponse *)response
+         forRequest:(NSURLRequest *)request;
+
+/**
+ * @brief  Send \c request using \a NSURLSession and wait till it completion.
+ *
+ * @param request Reference on request which should be played from cassette.
+ *
+ * @return Date when request has been sent.
+ */
+- (CFAbsoluteTime)sendRequest:(NSURLRequest *)request;
+
+/**
+ * @brief  Create data with specified length.
+ *
+ * @param length Number of bytes which should be in data object.
+ *
+ * @return Data with specified length.
+ */
+- (NSData *)dataWithLength:(NSUInteger)length;
+
+#pragma mark -
+
+
+@end
+
+
+@implementation YHVCassetteTest
+
+
+#pragma mark - Setup / Tear down
+
+- (void)setUp {
+    
+    [super setUp];
+    
+    self.cassettesPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    self.cassettePath = [NSUUID UUID].UUIDString;
+    self.receivedChunks = [NSMutableArray new];
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+    }];
+}
+
+- (void)tearDown {
+    
+    [YHVVCR ejectCassette];
+    [NSFileManager.defaultManager removeItemAtPath:self.cassettesPath error:nil];
+    
+    [super tearDown];
+}
+
+
+#pragma mark - Tests :: Throttled playback
+
+- (void)testPlayback_ShouldDeliverDataInChunks_WhenChunkSizeConfigured {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/100"]];
+    NSData *expectedData = [self dataWithLength:100];
+    NSMutableData *receivedData = [NSMutableData new];
+    
+    [self recordChaptersForRequests:@[request] withData:expectedData];
+    [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+        configuration.playbackBytesPerSecond = 3200;
+        configuration.playbackChunkSize = 32;
+    }];
+    
+    [self sendRequest:[NSURLRequest requestWithURL:request.URL]];
+    
+    XCTAssertEqualObjects([self.receivedChunks valueForKeyPath:@"data.length"], (@[@32, @32, @32, @4]));
+    
+    for (NSDictionary *chunk in self.receivedChunks) {
+        [receivedData appendData:chunk[@"data"]];
+    }
+    
+    XCTAssertEqualObjects(receivedData, expectedData);
+}
+
+- (void)testPlayback_ShouldMarkDataSceneAsPlayed_WhenLastChunkDelivered {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/64"]];
+    
+    [self recordChaptersForRequests:@[request] withData:[self dataWithLength:64]];
+    [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+        configuration.playbackBytesPerSecond = 1600;
+        configuration.playbackChunkSize = 16;
+    }];
+    
+    [self sendRequest:[NSURLRequest requestWithURL:request.URL]];
+    
+    XCTAssertEqualObjects([self.receivedChunks valueForKey:@"played"], (@[@NO, @NO, @NO, @YES]));
+}
+
+- (void)testPlayback_ShouldApplyInitialLatencyOnce_WhenChapterPlayedInChunks {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/64"]];
+    NSTimeInterval latency = 0.5f;
+    
+    [self recordChaptersForRequests:@[request] withData:[self dataWithLength:64]];
+    [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+        configuration.playbackInitialLatency = latency;
+        configuration.playbackChunkSize = 16;
+    }];
+    
+    CFAbsoluteTime startDate = [self sendRequest:[NSURLRequest requestWithURL:request.URL]];
+    CFAbsoluteTime firstChunkDate = ((NSNumber *)self.receivedChunks.firstObject[@"date"]).doubleValue;
+    CFAbsoluteTime lastChunkDate = ((NSNumber *)self.receivedChunks.lastObject[@"date"]).doubleValue;
+    
+    XCTAssertEqual(self.receivedChunks.count, 4);
+    XCTAssertGreaterThanOrEqual(firstChunkDate - startDate, latency);
+    XCTAssertLessThan(lastChunkDate - firstChunkDate, latency);
+}
+
+- (void)testPlayback_ShouldThrottleOnlyListedHosts_WhenThrottledHostsConfigured {
+    
+    NSURLRequest *throttledRequest = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/64"]];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://example.com/bytes/64"]];
+    
+    [self recordChaptersForRequests:@[throttledRequest, request] withData:[self dataWithLength:64]];
+    [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+        configuration.throttledHosts = @[@"HTTPBin.org"];
+        configuration.playbackChunkSize = 16;
+    }];
+    
+    [self sendRequest:[NSURLRequest requestWithURL:throttledRequest.URL]];
+    XCTAssertEqualObjects([self.receivedChunks valueForKeyPath:@"data.length"], (@[@16, @16, @16, @16]));
+    
+    [self.receivedChunks removeAllObjects];
+    [self sendRequest:[NSURLRequest requestWithURL:request.URL]];
+    XCTAssertEqualObjects([self.receivedChunks valueForKeyPath:@"data.length"], (@[@64]));
+}
+
+
+
+#pragma mark - Tests :: Recording
+
+- (void)testRecording_ShouldStoreLastReceivedBody_WhenFetchedDataClearedBeforeCompletion {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/redirect/1"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"application/octet-stream" }];
+    NSData *expectedData = [self dataWithLength:64];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    [YHVVCR canPlayResponseForRequest:request];
+    [YHVVCR beginRecordingRequest:request];
+    [YHVVCR recordResponse:response forRequest:request];
+    [YHVVCR recordData:[self dataWithLength:16] forRequest:request];
+    [cassette clearFetchedDataForRequest:request];
+    [YHVVCR recordData:expectedData forRequest:request];
+    [YHVVCR recordCompletionWithError:nil forRequest:request];
+    [YHVVCR ejectCassette];
+    
+    cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+    }];
+    
+    XCTAssertEqual(cassette.responses.count, 1);
+    XCTAssertEqualObjects(cassette.responses.firstObject.lastObject, expectedData);
+    XCTAssertEqual([cassette.availableScenes filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"type = %@", @(YHVDataScene)]].count, 1);
+}
+
+- (void)testRecording_ShouldPlaceRecordedChapterBeforeNotPlayedChapters_WhenRecordedDuringPlayback {
+    
+    NSURLRequest *playedRequest = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/1"]];
+    NSURLRequest *notPlayedRequest = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/2"]];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/3"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"application/octet-stream" }];
+    
+    [self recordChaptersForRequests:@[playedRequest, notPlayedRequest] withData:[self dataWithLength:16]];
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNew;
+    }];
+    
+    [self sendRequest:[NSURLRequest requestWithURL:playedRequest.URL]];
+    
+    XCTAssertFalse([YHVVCR canPlayResponseForRequest:request]);
+    [YHVVCR beginRecordingRequest:request];
+    [YHVVCR recordResponse:response forRequest:request];
+    [YHVVCR recordData:[self dataWithLength:16] forRequest:request];
+    [cassette clearFetchedDataForRequest:request];
+    [YHVVCR recordData:[self dataWithLength:32] forRequest:request];
+    [YHVVCR recordCompletionWithError:nil forRequest:request];
+    [YHVVCR ejectCassette];
+    
+    cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+    }];
+    
+    XCTAssertEqualObjects([cassette.requests valueForKey:@"URL"], (@[playedRequest.URL, request.URL, notPlayedRequest.URL]));
+    XCTAssertEqualObjects(cassette.responses[1].lastObject, [self dataWithLength:32]);
+    XCTAssertEqual(cassette.availableScenes.count, 12);
+}
+
+
+#pragma mark - Tests :: Chunked recording
+
+- (void)testRecording_ShouldCallBeforeRecordResponseOnceWithJoinedBody_WhenBodyReceivedInChunks {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/64"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"application/octet-stream" }];
+    NSMutableArray<NSData *> *filteredBodies = [NSMutableArray new];
+    NSData *expectedData = [self dataWithLength:64];
+    
+    [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordAll;
+        configuration.beforeRecordResponse = ^NSArray * (NSURLRequest *filteredRequest, NSHTTPURLResponse *filteredResponse, NSData *data) {
+            if (data) {
+                [filteredBodies addObject:data];
+            }
+            
+            return data ? @[filteredResponse, data] : @[filteredResponse];
+        };
+    }];
+    
+    [self recordData:expectedData inChunksOfLength:16 withResponse:response forRequest:request];
+    
+    XCTAssertEqual(filteredBodies.count, 0);
+    
+    [YHVVCR recordCompletionWithError:nil forRequest:request];
+    
+    XCTAssertEqual(filteredBodies.count, 1);
+    XCTAssertEqualObjects(filteredBodies.firstObject, expectedData);
+}
+
+- (void)testRecording_ShouldRedactJSONKey_WhenKeyValueSplitBetweenChunks {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/json"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"application/json" }];
+    NSData *data = [@"{\"token\":\"secret-value\",\"name\":\"bob\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordAll;
+        configuration.responseBodyFilter = @{ @"token": @"redacted" };
+    }];
+    
+    // First chunk ends in the middle of 'token' value.
+    [self recordData:data inChunksOfLength:14 withResponse:response forRequest:request];
+    [YHVVCR recordCompletionWithError:nil forRequest:request];
+    [YHVVCR ejectCassette];
+    
+    cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+    }];
+    NSString *body = [[NSString alloc] initWithData:cassette.responses.firstObject.lastObject encoding:NSUTF8StringEncoding];
+    
+    XCTAssertEqualObjects(body, @"{\"token\":\"redacted\",\"name\":\"bob\"}");
+}
+
+- (void)testRecording_ShouldStoreSingleDataSceneBeforeErrorScene_WhenBodyReceivedInChunks {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/64"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"application/octet-stream" }];
+    NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    [self recordData:[self dataWithLength:64] inChunksOfLength:16 withResponse:response forRequest:request];
+    [YHVVCR recordCompletionWithError:error forRequest:request];
+    
+    XCTAssertEqualObjects([cassette.availableScenes valueForKey:@"type"],
+                          (@[@(YHVRequestScene), @(YHVResponseScene), @(YHVDataScene), @(YHVErrorScene)]));
+}
+
+- (void)testRecording_ShouldNotKeepBodyBuffer_WhenFetchedDataClearedForCancelledRequest {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/64"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"application/octet-stream" }];
+    NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    [self recordData:[self dataWithLength:64] inChunksOfLength:16 withResponse:response forRequest:request];
+    
+    XCTAssertEqual([[cassette valueForKey:@"recordedDataBuffers"] count], 1);
+    
+    [cassette clearFetchedDataForRequest:request];
+    // Cleanup scheduled asynchronously on resources access queue, so wait for it with synchronous call.
+    NSArray<YHVScene *> *scenes = cassette.availableScenes;
+    
+    XCTAssertEqual([[cassette valueForKey:@"recordedDataBuffers"] count], 0);
+    XCTAssertEqual(scenes.count, 2);
+    
+    [YHVVCR recordCompletionWithError:error forRequest:request];
+    
+    XCTAssertEqualObjects([cassette.availableScenes valueForKey:@"type"], (@[@(YHVRequestScene), @(YHVResponseScene), @(YHVErrorScene)]));
+}
+
+
+#pragma mark - Tests :: Spill to disk
+
+- (void)testRecording_ShouldStoreBodyFromTemporaryFile_WhenBodyLargerThanSpillThreshold {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/4096"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"application/octet-stream" }];
+    NSString *savedCassettePath = [self.cassettesPath stringByAppendingPathComponent:[self.cassettePath stringByAppendingPathExtension:@"json"]];
+    NSData *expectedData = [self dataWithLength:4096];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordAll;
+        configuration.spillToDiskThreshold = 1024;
+    }];
+    
+    [self recordData:expectedData inChunksOfLength:512 withResponse:response forRequest:request];
+    NSDictionary<NSString *, NSString *> *dataPaths = [cassette valueForKey:@"recordedDataPaths"];
+    NSString *dataPath = dataPaths.allValues.firstObject;
+    
+    XCTAssertEqual(dataPaths.count, 1);
+    XCTAssertTrue([NSFileManager.defaultManager fileExistsAtPath:dataPath]);
+    
+    [YHVVCR recordCompletionWithError:nil forRequest:request];
+    YHVScene *dataScene = [cassette.availableScenes filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"type = %@", @(YHVDataScene)]].firstObject;
+    
+    XCTAssertEqualObjects(dataScene.dataPath, dataPath);
+    
+    [YHVVCR ejectCassette];
+    NSString *cassetteContent = [NSString stringWithContentsOfFile:savedCassettePath encoding:NSUTF8StringEncoding error:nil];
+    
+    XCTAssertNotNil(cassetteContent);
+    XCTAssertEqual([cassetteContent rangeOfString:@"YHV0[0-9A-F]{32}" options:NSRegularExpressionSearch].location, NSNotFound);
+    
+    cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+    }];
+    
+    XCTAssertEqual(cassette.responses.count, 1);
+    XCTAssertEqualObjects(cassette.responses.firstObject.lastObject, expectedData);
+}
+
+- (void)testRecording_ShouldRemoveTemporaryFileAndStoreFilteredBody_WhenBeforeRecordResponseChangedSpilledBody {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/4096"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"application/octet-stream" }];
+    NSData *filteredData = [@"filtered" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordAll;
+        configuration.spillToDiskThreshold = 1024;
+        configuration.beforeRecordResponse = ^NSArray * (NSURLRequest *filteredRequest, NSHTTPURLResponse *filteredResponse, NSData *data) {
+            return data ? @[filteredResponse, filteredData] : @[filteredResponse];
+        };
+    }];
+    
+    [self recordData:[self dataWithLength:4096] inChunksOfLength:512 withResponse:response forRequest:request];
+    NSString *dataPath = [[cassette valueForKey:@"recordedDataPaths"] allValues].firstObject;
+    
+    XCTAssertTrue([NSFileManager.defaultManager fileExistsAtPath:dataPath]);
+    
+    [YHVVCR recordCompletionWithError:nil forRequest:request];
+    YHVScene *dataScene = [cassette.availableScenes filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"type = %@", @(YHVDataScene)]].firstObject;
+    
+    XCTAssertFalse([NSFileManager.defaultManager fileExistsAtPath:dataPath]);
+    XCTAssertNil(dataScene.dataPath);
+    
+    [YHVVCR ejectCassette];
+    cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+    }];
+    
+    XCTAssertEqual(cassette.responses.count, 1);
+    XCTAssertEqualObjects(cassette.responses.firstObject.lastObject, filteredData);
+}
+
+
+#pragma mark - Tests :: Match index
+
+- (void)testLoad_ShouldRebuildMatchIndex_WhenIndexedChaptersNotMatchCassette {
+    
+    NSArray<NSURLRequest *> *requests = @[
+        [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/1"]],
+        [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/2"]]
+    ];
+    
+    [self recordChaptersForRequests:requests withData:[self dataWithLength:16]];
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+    }];
+    NSString *cassettePath = cassette.configuration.cassettePath;
+    NSPredicate *requestScenesPredicate = [NSPredicate predicateWithFormat:@"type = %@", @(YHVRequestScene)];
+    NSArray<YHVScene *> *requestScenes = [cassette.availableScenes filteredArrayUsingPredicate:requestScenesPredicate];
+    NSSet<NSString *> *chapterIdentifiers = [NSSet setWithArray:[requestScenes valueForKey:@"identifier"]];
+    [YHVVCR ejectCassette];
+    
+    XCTAssertTrue([[YHVMatchIndex indexWithRequestScenes:@[] reusingIndex:nil] writeForCassetteAtPath:cassettePath]);
+    XCTAssertEqual([YHVMatchIndex indexForCassetteAtPath:cassettePath].chapterIdentifiers.count, 0);
+    
+    [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+    }];
+    
+    XCTAssertEqual(chapterIdentifiers.count, requests.count);
+    XCTAssertEqualObjects([YHVMatchIndex indexForCassetteAtPath:cassettePath].chapterIdentifiers, chapterIdentifiers);
+}
+
+- (void)testPlayback_ShouldSkipChapterUsingMatchIndex_WhenIndexedRequestMismatch {
+    
+    NSURLRequest *skippedRequest = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/1"]];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/2"]];
+    
+    [self recordChaptersForRequests:@[skippedRequest, request] withData:[self dataWithLength:16]];
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.playbackMode = YHVMomentaryPlayback;
+        configuration.recordMode = YHVRecordNone;
+    }];
+    
+    XCTAssertTrue([YHVVCR canPlayResponseForRequest:[NSURLRequest requestWithURL:request.URL]]);
+    XCTAssertEqual(cassette.statistics.scannedCandidatesCount, 2);
+    XCTAssertEqual(cassette.statistics.indexResolvedCandidatesCount, 2);
+}
+
+- (void)testPlayback_ShouldConfirmMatchWithMatchers_WhenHeadersMatcherConfigured {
+    
+    NSURLRequest *skippedRequest = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/1"]];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/2"]];
+    
+    [self recordChaptersForRequests:@[skippedRequest, request] withData:[self dataWithLength:16]];
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.playbackMode = YHVMomentaryPlayback;
+        configuration.recordMode = YHVRecordNone;
+        configuration.matchers = @[YHVMatcher.method, YHVMatcher.uri, YHVMatcher.headers];
+    }];
+    
+    XCTAssertTrue([YHVVCR canPlayResponseForRequest:[NSURLRequest requestWithURL:request.URL]]);
+    XCTAssertEqual(cassette.statistics.scannedCandidatesCount, 2);
+    XCTAssertEqual(cassette.statistics.indexResolvedCandidatesCount, 1);
+}
+
+- (void)testPlayback_ShouldConfirmMatchWithMatchers_WhenCustomMatcherConfigured {
+    
+    NSURLRequest *skippedRequest = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/1"]];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/2"]];
+    NSString *matcherIdentifier = [NSUUID UUID].UUIDString;
+    NSMutableArray<NSURL *> *matchedURLs = [NSMutableArray new];
+    
+    [self recordChaptersForRequests:@[skippedRequest, request] withData:[self dataWithLength:16]];
+    [YHVVCR registerMatcher:matcherIdentifier withBlock:^BOOL(NSURLRequest *matchedRequest, NSURLRequest *stubRequest) {
+        [matchedURLs addObject:stubRequest.URL];
+        return YES;
+    }];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.playbackMode = YHVMomentaryPlayback;
+        configuration.recordMode = YHVRecordNone;
+        configuration.matchers = @[YHVMatcher.method, YHVMatcher.uri, matcherIdentifier];
+    }];
+    
+    XCTAssertTrue([YHVVCR canPlayResponseForRequest:[NSURLRequest requestWithURL:request.URL]]);
+    XCTAssertEqualObjects(matchedURLs, @[request.URL]);
+    XCTAssertEqual(cassette.statistics.indexResolvedCandidatesCount, 1);
+    
+    [YHVVCR unregisterMatcher:matcherIdentifier];
+}
+
+
+#pragma mark - Tests :: Memory budget
+
+- (void)testPlayback_ShouldReleasePlayedChaptersData_WhenMemoryBudgetExceeded {
+    
+    NSArray<NSURLRequest *> *requests = @[
+        [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/1"]],
+        [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/2"]],
+        [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/3"]]
+    ];
+    NSData *expectedData = [self dataWithLength:1024];
+    
+    [self recordChaptersForRequests:requests withData:expectedData];
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+        configuration.playedScenesMemoryBudget = 1;
+    }];
+    
+    for (NSURLRequest *request in requests) {
+        [self sendRequest:[NSURLRequest requestWithURL:request.URL]];
+    }
+    
+    NSString *chapterIdentifier = cassette.availableScenes.firstObject.identifier;
+    NSPredicate *chapterPredicate = [NSPredicate predicateWithFormat:@"identifier = %@ AND type = %@",
+                                     chapterIdentifier, @(YHVDataScene)];
+    XCTAssertTrue([cassette.availableScenes filteredArrayUsingPredicate:chapterPredicate].firstObject.isDataReleased);
+    
+    XCTAssertEqualObjects([cassette.requests valueForKey:@"URL"], [requests valueForKey:@"URL"]);
+    XCTAssertEqual(cassette.responses.count, requests.count);
+    
+    for (NSArray *response in cassette.responses) {
+        XCTAssertEqualObjects(response.lastObject, expectedData);
+    }
+}
+
+- (void)testPlayback_ShouldKeepComposedViews_WhenPlayedChaptersDataReleased {
+    
+    NSArray<NSURLRequest *> *requests = @[
+        [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/1"]],
+        [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/bytes/2"]]
+    ];
+    NSData *expectedData = [self dataWithLength:1024];
+    
+    [self recordChaptersForRequests:requests withData:expectedData];
+    YHVCassette *cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordNone;
+        configuration.playedScenesMemoryBudget = 1;
+    }];
+    NSArray<NSURLRequest *> *composedRequests = cassette.requests;
+    NSArray<NSArray *> *composedResponses = cassette.responses;
+    
+    for (NSURLRequest *request in requests) {
+        [self sendRequest:[NSURLRequest requestWithURL:request.URL]];
+    }
+    
+    XCTAssertTrue([cassette.availableScenes.firstObject isDataReleased]);
+    XCTAssertTrue(cassette.requests == composedRequests);
+    XCTAssertTrue(cassette.responses == composedResponses);
+    XCTAssertEqualObjects(cassette.responses.lastObject.lastObject, expectedData);
+}
+
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
+    
+    NSString *chapterIdentifier = dataTask.originalRequest.YHV_cassetteChapterIdentifier;
+    BOOL played = NO;
+    
+    for (YHVScene *scene in YHVVCR.cassette.availableScenes) {
+        if (scene.type == YHVDataScene && [scene.identifier isEqualToString:chapterIdentifier]) {
+            played = scene.played;
+            break;
+        }
+    }
+    
+    @synchronized (self.receivedChunks) {
+        [self.receivedChunks addObject:@{ @"data": data, @"date": @(CFAbsoluteTimeGetCurrent()), @"played": @(played) }];
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error {
+    
+    XCTAssertNil(error);
+    [self.completionExpectation fulfill];
+}
+
+
+#pragma mark - Misc
+
+- (void)recordChaptersForRequests:(NSArray<NSURLRequest *> *)requests withData:(NSData *)data {
+    
+    [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    for (NSURLRequest *chapterRequest in requests) {
+        NSURLRequest *request = [chapterRequest copy];
+        NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                                headerFields:@{ @"Content-Type": @"application/octet-stream" }];
+    
+        [YHVVCR canPlayResponseForRequest:request];
+        [YHVVCR beginRecordingRequest:request];
+        [YHVVCR recordResponse:response forRequest:request];
+        [YHVVCR recordData:data forRequest:request];
+        [YHVVCR recordCompletionWithError:nil forRequest:request];
+    }
+    
+    [YHVVCR ejectCassette];
+}
+
+- (void)recordData:(NSData *)data
+   inChunksOfLength:(NSUInteger)chunkLength
+       withResponse:(NSHTTPURLResponse *)response
+         forRequest:(NSURLRequest *)request {
+    
+    [YHVVCR canPlayResponseForRequest:request];
+    [YHVVCR beginRecordingRequest:request];
+    [YHVVCR recordResponse:response forRequest:request];
+    
+    for (NSUInteger location = 0; location < data.length; location += chunkLength) {
+        NSRange chunkRange = NSMakeRange(location, MIN(chunkLength, data.length - location));
+        
+        [YHVVCR recordData:[data subdataWithRange:chunkRange] forRequest:request];
+    }
+}
+
+- (CFAbsoluteTime)sendRequest:(NSURLRequest *)request {
+    
+    NSURLSession *session = [NSURLSession sessionWithConfiguration:[NSURLSessionConfiguration defaultSessionConfiguration]
+                                                          delegate:self
+                                                     delegateQueue:nil];
+    self.completionExpectation = [self expectationWithDescription:@"Request completion"];
+    CFAbsoluteTime startDate = CFAbsoluteTimeGetCurrent();
+    
+    [[session dataTaskWithRequest:request] resume];
+    [self waitForExpectationsWithTimeout:10.f handler:nil];
+    [session finishTasksAndInvalidate];
+    
+    return startDate;
+}
+
+- (NSData *)dataWithLength:(NSUInteger)length {
+    
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    uint8_t *bytes = data.mutableBytes;
+    
+    for (NSUInteger byteIdx = 0; byteIdx < length; byteIdx++) {
+        bytes[byteIdx] = (uint8_t)(byteIdx % 251);
+    }
+    
+    return data;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,456 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import <XCTest/XCTest.h>
+#import <YAHTTPVCR/YAHTTPVCR.h>
+#import <YAHTTPVCR/YHVScene.h>
+#import <OCMock/OCMock.h>
+
+
+@interface YHVLoadReplayerTest : XCTestCase
+
+
+#pragma mark - Information
+
+@property (nonatomic, copy) NSString *cassettePath;
+@property (nonatomic, strong) NSURL *targetURL;
+
+/**
+ * @brief      Stores reference on dictionary which maps request path to stubbed response.
+ * @discussion Each value is \a NSError or list with status code and response body.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *stubbedResponses;
+
+/**
+ * @brief  Stores reference on list of requests which has been sent by replayer.
+ */
+@property (nonatomic, strong) NSMutableArray<NSURLRequest *> *sentRequests;
+
+/**
+ * @brief  Stores reference on configuration which has been used by replayer to create URL session.
+ */
+@property (nonatomic, strong) NSURLSessionConfiguration *sessionConfiguration;
+
+/**
+ * @brief      Stores for how long stubbed responses should be delayed.
+ * @discussion Responses delivered right from \c -dataTaskWithRequest:completionHandler: if delay is \c 0.
+ */
+@property (nonatomic, assign) NSTimeInterval responseDelay;
+
+/**
+ * @brief  Stores how many requests has been sent and still wait for response.
+ */
+@property (nonatomic, assign) NSUInteger inFlightRequestsCount;
+
+/**
+ * @brief  Stores maximum number of requests which has been waiting for response at the same time.
+ */
+@property (nonatomic, assign) NSUInteger maximumInFlightRequestsCount;
+@property (nonatomic, strong) id sessionMock;
+
+
+#pragma mark - Misc
+
+/**
+ * @brief  Create scenes for successfully completed chapter.
+ *
+ * @param identifier Unique identifier of chapter for which scenes should be created.
+ * @param path       Reference on path which should be used by chapter's request.
+ * @param statusCode Status code which should be used by chapter's response.
+ * @param data       Reference on chapter's response body.
+ *
+ * @return List of chapter's scenes serialized to dictionaries.
+ */
+- (NSArray<NSDictionary *> *)chapterWithIdentifier:(NSString *)identifier
+                                               path:(NSString *)path
+                                         statusCode:(NSInteger)statusCode
+                                               data:(NSData *)data;
+
+/**
+ * @brief  Create serialized scene.
+ *
+ * @param identifier Unique identifier of chapter to which scene belongs.
+ * @param type       One of \b YHVSceneType enum fields.
+ * @param data       Reference on scene's data.
+ *
+ * @return Scene serialized to dictionary.
+ */
+- (NSDictionary *)sceneWithIdentifier:(NSString *)identifier type:(YHVSceneType)type data:(id)data;
+
+/**
+ * @brief  Write cassette with passed serialized scenes.
+ *
+ * @param scenes Reference on list of serialized scenes.
+ */
+- (void)writeCassetteWithScenes:(NSArray<NSDictionary *> *)scenes;
+
+/**
+ * @brief  Replay cassette and wait for report.
+ *
+ * @param replayer Reference on replayer which should be used.
+ *
+ * @return Replay report.
+ */
+- (YHVLoadReplayReport *)reportFromReplayer:(YHVLoadReplayer *)replayer;
+
+#pragma mark -
+
+
+@end
+
+
+@implementation YHVLoadReplayerTest
+
+
+#pragma mark - Setup / Tear down
+
+- (void)setUp {
+    
+    [super setUp];
+    
+    self.cassettePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID].UUIDString stringByAppendingPathExtension:@"json"]];
+    self.targetURL = [NSURL URLWithString:@"http://127.0.0.1:8080"];
+    self.stubbedResponses = [NSMutableDictionary new];
+    self.sentRequests = [NSMutableArray new];
+    
+    id taskMock = OCMClassMock([NSURLSessionDataTask class]);
+    self.sessionMock = OCMClassMock([NSURLSession class]);
+    id configurationArgument = [OCMArg checkWithBlock:^BOOL(NSURLSessionConfiguration *configuration) {
+        self.sessionConfiguration = configuration;
+        return YES;
+    }];
+    OCMStub(ClassMethod([self.sessionMock sessionWithConfiguration:configurationArgument])).andReturn(self.sessionMock);
+    OCMStub([self.sessionMock dataTaskWithRequest:[OCMArg any] completionHandler:[OCMArg any]]).andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained void(^handler)(NSData *, NSURLResponse *, NSError *) = nil;
+        __unsafe_unretained NSURLRequest *unretainedRequest = nil;
+        __unsafe_unretained id task = taskMock;
+        [invocation getArgument:&unretainedRequest atIndex:2];
+        [invocation getArgument:&handler atIndex:3];
+        [invocation setReturnValue:&task];
+        
+        void(^completion)(NSData *, NSURLResponse *, NSError *) = [handler copy];
+        NSURLRequest *request = unretainedRequest;
+        id stub = self.stubbedResponses[request.URL.path];
+        
+        @synchronized (self.sentRequests) {
+            [self.sentRequests addObject:request];
+            self.inFlightRequestsCount++;
+            self.maximumInFlightRequestsCount = MAX(self.maximumInFlightRequestsCount, self.inFlightRequestsCount);
+        }
+        
+        dispatch_block_t respondBlock = ^{
+            @synchronized (self.sentRequests) {
+                self.inFlightRequestsCount--;
+            }
+            
+            if ([stub isKindOfClass:[NSError class]]) {
+                completion(nil, nil, stub);
+            } else {
+                NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL
+                                                                          statusCode:((NSNumber *)stub[0]).integerValue
+                                                                         HTTPVersion:@"HTTP/1.1" headerFields:nil];
+                completion(((NSArray *)stub).count > 1 ? stub[1] : [NSData new], response, nil);
+            }
+        };
+        
+        if (self.responseDelay > 0.f) {
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.responseDelay * NSEC_PER_SEC)),
+                           dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), respondBlock);
+        } else {
+            respondBlock();
+        }
+    });
+}
+
+- (void)tearDown {
+    
+    [self.sessionMock stopMocking];
+    [NSFileManager.defaultManager removeItemAtPath:self.cassettePath error:nil];
+    
+    [super tearDown];
+}
+
+
+#pragma mark - Tests :: Chapters
+
+- (void)testReplayer_ShouldGroupScenesByChapters_WhenChaptersInterleaved {
+    
+    NSData *firstPart = [@"Hello " dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *secondPart = [@"world" dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *data = [@"Bye" dataUsingEncoding:NSUTF8StringEncoding];
+    NSArray<NSDictionary *> *chapter1 = [self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:firstPart];
+    NSArray<NSDictionary *> *chapter2 = [self chapterWithIdentifier:@"chapter-2" path:@"/bye" statusCode:200 data:data];
+    self.stubbedResponses[@"/hello"] = @[@200, [@"Hello world" dataUsingEncoding:NSUTF8StringEncoding]];
+    self.stubbedResponses[@"/bye"] = @[@200, data];
+    
+    [self writeCassetteWithScenes:@[
+        chapter1[0], chapter2[0], chapter1[1], chapter2[1], chapter1[2], chapter2[2],
+        [self sceneWithIdentifier:@"chapter-1" type:YHVDataScene data:secondPart], chapter2[3], chapter1[3]
+    ]];
+    
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    YHVLoadReplayReport *report = [self reportFromReplayer:replayer];
+    
+    XCTAssertEqual(replayer.requestsCount, 2);
+    XCTAssertEqual(replayer.skippedChaptersCount, 0);
+    XCTAssertEqual(report.mismatchedResponsesCount, 0);
+    XCTAssertEqualObjects([self.sentRequests valueForKeyPath:@"URL.absoluteString"],
+                          (@[@"http://127.0.0.1:8080/hello", @"http://127.0.0.1:8080/bye"]));
+}
+
+- (void)testReplayer_ShouldSkipChapter_WhenScenesStoredBeforeRequestScene {
+    
+    NSArray<NSDictionary *> *chapter1 = [self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:nil];
+    NSArray<NSDictionary *> *chapter2 = [self chapterWithIdentifier:@"chapter-2" path:@"/bye" statusCode:200 data:nil];
+    
+    [self writeCassetteWithScenes:[@[chapter2[1], chapter2[0], chapter2[2]] arrayByAddingObjectsFromArray:chapter1]];
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    
+    XCTAssertEqual(replayer.requestsCount, 1);
+    XCTAssertEqual(replayer.skippedChaptersCount, 1);
+}
+
+- (void)testReplayer_ShouldSkipChapter_WhenRequestSceneDataMissing {
+    
+    NSArray<NSDictionary *> *chapter1 = [self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:nil];
+    NSArray<NSDictionary *> *chapter2 = [self chapterWithIdentifier:@"chapter-2" path:@"/bye" statusCode:200 data:nil];
+    NSDictionary *requestScene = @{ @"id": @"chapter-2", @"type": @(YHVRequestScene) };
+    
+    [self writeCassetteWithScenes:[@[requestScene, chapter2[1], chapter2[2]] arrayByAddingObjectsFromArray:chapter1]];
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    
+    XCTAssertEqual(replayer.requestsCount, 1);
+    XCTAssertEqual(replayer.skippedChaptersCount, 1);
+}
+
+- (void)testReplayer_ShouldSkipChapter_WhenResponseAndErrorScenesMissing {
+    
+    NSArray<NSDictionary *> *chapter1 = [self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:nil];
+    NSArray<NSDictionary *> *chapter2 = [self chapterWithIdentifier:@"chapter-2" path:@"/bye" statusCode:200 data:nil];
+    
+    [self writeCassetteWithScenes:[chapter1 arrayByAddingObject:chapter2[0]]];
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    
+    XCTAssertEqual(replayer.requestsCount, 1);
+    XCTAssertEqual(replayer.skippedChaptersCount, 1);
+}
+
+- (void)testReplayer_ShouldReturnNil_WhenCassetteCanNotBeRead {
+    
+    XCTAssertNil([YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL]);
+}
+
+
+#pragma mark - Tests :: Mismatches
+
+- (void)testReplay_ShouldReportMismatch_WhenStatusCodeDifferent {
+    
+    self.stubbedResponses[@"/hello"] = @[@500];
+    [self writeCassetteWithScenes:[self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:nil]];
+    
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    YHVLoadReplayReport *report = [self reportFromReplayer:replayer];
+    
+    XCTAssertEqual(report.mismatchedResponsesCount, 1);
+    XCTAssertEqual(report.failedRequestsCount, 0);
+    XCTAssertTrue([report.mismatches.firstObject containsString:@"expected status 200, received 500"]);
+}
+
+- (void)testReplay_ShouldReportMismatch_WhenBodyDifferent {
+    
+    NSData *data = [@"Hello world" dataUsingEncoding:NSUTF8StringEncoding];
+    self.stubbedResponses[@"/hello"] = @[@200, [@"Hello" dataUsingEncoding:NSUTF8StringEncoding]];
+    [self writeCassetteWithScenes:[self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:data]];
+    
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    YHVLoadReplayReport *report = [self reportFromReplayer:replayer];
+    
+    XCTAssertEqual(report.mismatchedResponsesCount, 1);
+    XCTAssertTrue([report.mismatches.firstObject containsString:@"expected 11 bytes body, received different 5 bytes body"]);
+}
+
+- (void)testReplay_ShouldNotReportMismatch_WhenBodyComparisonDisabled {
+    
+    NSData *data = [@"Hello world" dataUsingEncoding:NSUTF8StringEncoding];
+    self.stubbedResponses[@"/hello"] = @[@200, [@"Hello" dataUsingEncoding:NSUTF8StringEncoding]];
+    [self writeCassetteWithScenes:[self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:data]];
+    
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    replayer.compareResponseBodies = NO;
+    
+    XCTAssertEqual([self reportFromReplayer:replayer].mismatchedResponsesCount, 0);
+}
+
+- (void)testReplay_ShouldNotReportMismatch_WhenExpectedErrorReceived {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/hello"]];
+    NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil];
+    self.stubbedResponses[@"/hello"] = error;
+    
+    [self writeCassetteWithScenes:@[
+        [self sceneWithIdentifier:@"chapter-1" type:YHVRequestScene data:request],
+        [self sceneWithIdentifier:@"chapter-1" type:YHVErrorScene data:error]
+    ]];
+    
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    YHVLoadReplayReport *report = [self reportFromReplayer:replayer];
+    
+    XCTAssertEqual(report.mismatchedResponsesCount, 0);
+    XCTAssertEqual(report.failedRequestsCount, 0);
+}
+
+- (void)testReplay_ShouldReportMismatch_WhenExpectedErrorNotReceived {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/hello"]];
+    NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil];
+    self.stubbedResponses[@"/hello"] = @[@200];
+    
+    [self writeCassetteWithScenes:@[
+        [self sceneWithIdentifier:@"chapter-1" type:YHVRequestScene data:request],
+        [self sceneWithIdentifier:@"chapter-1" type:YHVErrorScene data:error]
+    ]];
+    
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    YHVLoadReplayReport *report = [self reportFromReplayer:replayer];
+    
+    XCTAssertEqual(report.mismatchedResponsesCount, 1);
+    XCTAssertTrue([report.mismatches.firstObject containsString:@"expected error"]);
+}
+
+- (void)testReplay_ShouldReportFailedRequest_WhenUnexpectedErrorReceived {
+    
+    self.stubbedResponses[@"/hello"] = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCannotConnectToHost userInfo:nil];
+    [self writeCassetteWithScenes:[self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:nil]];
+    
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    YHVLoadReplayReport *report = [self reportFromReplayer:replayer];
+    
+    XCTAssertEqual(report.failedRequestsCount, 1);
+    XCTAssertEqual(report.mismatchedResponsesCount, 1);
+    XCTAssertEqual(report.maximumLatency, 0.f);
+}
+
+- (void)testReplay_ShouldSendAllRequests_WhenRepeatCountSet {
+    
+    NSArray<NSDictionary *> *chapter1 = [self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:nil];
+    NSArray<NSDictionary *> *chapter2 = [self chapterWithIdentifier:@"chapter-2" path:@"/bye" statusCode:200 data:nil];
+    self.stubbedResponses[@"/hello"] = @[@200];
+    self.stubbedResponses[@"/bye"] = @[@200];
+    
+    [self writeCassetteWithScenes:[chapter1 arrayByAddingObjectsFromArray:chapter2]];
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    replayer.repeatCount = 3;
+    replayer.concurrency = 2;
+    
+    YHVLoadReplayReport *report = [self reportFromReplayer:replayer];
+    
+    XCTAssertEqual(report.requestsCount, 6);
+    XCTAssertEqual(self.sentRequests.count, 6);
+    XCTAssertEqual(report.mismatchedResponsesCount, 0);
+    XCTAssertGreaterThan(report.throughput, 0.f);
+}
+
+
+#pragma mark - Tests :: Concurrency
+
+- (void)testReplay_ShouldLimitRequestsInFlight_WhenConcurrencySet {
+    
+    self.stubbedResponses[@"/hello"] = @[@200];
+    self.responseDelay = 0.05f;
+    [self writeCassetteWithScenes:[self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:nil]];
+    
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    replayer.repeatCount = 12;
+    replayer.concurrency = 3;
+    
+    YHVLoadReplayReport *report = [self reportFromReplayer:replayer];
+    
+    XCTAssertEqual(report.requestsCount, 12);
+    XCTAssertEqual(self.sentRequests.count, 12);
+    XCTAssertEqual(self.sessionConfiguration.HTTPMaximumConnectionsPerHost, 3);
+    XCTAssertGreaterThan(self.maximumInFlightRequestsCount, 1);
+    XCTAssertLessThanOrEqual(self.maximumInFlightRequestsCount, 3);
+}
+
+- (void)testReplay_ShouldSendRequestsOneByOne_WhenConcurrencyIsZero {
+    
+    self.stubbedResponses[@"/hello"] = @[@200];
+    self.responseDelay = 0.01f;
+    [self writeCassetteWithScenes:[self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:nil]];
+    
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    replayer.repeatCount = 5;
+    replayer.concurrency = 0;
+    
+    XCTAssertEqual([self reportFromReplayer:replayer].requestsCount, 5);
+    XCTAssertEqual(self.sessionConfiguration.HTTPMaximumConnectionsPerHost, 1);
+    XCTAssertEqual(self.maximumInFlightRequestsCount, 1);
+}
+
+- (void)testReplay_ShouldLimitMismatchDescriptions_WhenManyResponsesMismatched {
+    
+    self.stubbedResponses[@"/hello"] = @[@500];
+    [self writeCassetteWithScenes:[self chapterWithIdentifier:@"chapter-1" path:@"/hello" statusCode:200 data:nil]];
+    
+    YHVLoadReplayer *replayer = [YHVLoadReplayer replayerWithCassetteAtPath:self.cassettePath targetURL:self.targetURL];
+    replayer.repeatCount = 150;
+    replayer.concurrency = 4;
+    
+    YHVLoadReplayReport *report = [self reportFromReplayer:replayer];
+    
+    XCTAssertEqual(report.requestsCount, 150);
+    XCTAssertEqual(report.mismatchedResponsesCount, 150);
+    XCTAssertEqual(report.mismatches.count, 100);
+}
+
+#pragma mark - Misc
+
+- (NSArray<NSDictionary *> *)chapterWithIdentifier:(NSString *)identifier
+                                               path:(NSString *)path
+                                         statusCode:(NSInteger)statusCode
+                                               data:(NSData *)data {
+    
+    NSURL *url = [NSURL URLWithString:[@"https://httpbin.org" stringByAppendingString:path]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:url statusCode:statusCode HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"text/plain" }];
+    
+    return @[
+        [self sceneWithIdentifier:identifier type:YHVRequestScene data:[NSURLRequest requestWithURL:url]],
+        [self sceneWithIdentifier:identifier type:YHVResponseScene data:response],
+        [self sceneWithIdentifier:identifier type:YHVDataScene data:data],
+        [self sceneWithIdentifier:identifier type:YHVClosingScene data:nil]
+    ];
+}
+
+- (NSDictionary *)sceneWithIdentifier:(NSString *)identifier type:(YHVSceneType)type data:(id)data {
+    
+    return [YHVScene sceneWithIdentifier:identifier type:type data:data].YHV_dictionaryRepresentation;
+}
+
+- (void)writeCassetteWithScenes:(NSArray<NSDictionary *> *)scenes {
+    
+    NSData *cassetteData = [NSJSONSerialization dataWithJSONObject:scenes options:(NSJSONWritingOptions)0 error:nil];
+    
+    XCTAssertTrue([cassetteData writeToFile:self.cassettePath atomically:YES]);
+}
+
+- (YHVLoadReplayReport *)reportFromReplayer:(YHVLoadReplayer *)replayer {
+    
+    XCTestExpectation *replayExpectation = [self expectationWithDescription:@"Replay completion"];
+    __block YHVLoadReplayReport *report = nil;
+    
+    [replayer replayWithCompletion:^(YHVLoadReplayReport *replayReport) {
+        report = replayReport;
+        [replayExpectation fulfill];
+    }];
+    
+    [self waitForExpectationsWithTimeout:10.f handler:nil];
+    
+    return report;
+}
+
+#pragma mark -
+
+
+@end
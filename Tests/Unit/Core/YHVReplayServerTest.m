@@ -0,0 +1,320 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import <XCTest/XCTest.h>
+#import <YAHTTPVCR/YHVVCR+Recorder.h>
+#import <YAHTTPVCR/YHVVCR+Player.h>
+#import <YAHTTPVCR/YAHTTPVCR.h>
+#import <netinet/in.h>
+#import <sys/socket.h>
+#import <arpa/inet.h>
+#import <unistd.h>
+
+
+@interface YHVReplayServerTest : XCTestCase
+
+
+#pragma mark - Information
+
+@property (nonatomic, copy) NSString *cassettesPath;
+@property (nonatomic, copy) NSString *cassettePath;
+@property (nonatomic, strong) YHVReplayServer *server;
+
+/**
+ * @brief  Stores client socket which is used to send requests to server.
+ */
+@property (nonatomic, assign) int socket;
+
+
+#pragma mark - Misc
+
+/**
+ * @brief  Record chapter with specified response body or error.
+ *
+ * @param request    Reference on request for which chapter should be recorded.
+ * @param statusCode Status code which should be used by recorded response.
+ * @param data       Reference on response body which should be recorded.
+ * @param error      Reference on error which should be recorded instead of response.
+ */
+- (void)recordChapterForRequest:(NSURLRequest *)request
+                     statusCode:(NSInteger)statusCode
+                           data:(NSData *)data
+                          error:(NSError *)error;
+
+/**
+ * @brief  Connect to replay server.
+ *
+ * @return Connected client socket descriptor.
+ */
+- (int)connectToServer;
+
+/**
+ * @brief  Send raw request(s) to replay server.
+ *
+ * @param string Reference on string with raw HTTP requests.
+ */
+- (void)sendString:(NSString *)string;
+
+/**
+ * @brief      Read data sent by replay server.
+ * @discussion Reading stops when \c string found specified number of times, server close connection or read timeout expire.
+ *
+ * @param count  How many times \c string should be received.
+ * @param string Reference on string which should be found in received data. Pass \c nil to read till connection close.
+ *
+ * @return Received data as string.
+ */
+- (NSString *)readUntilOccurrences:(NSUInteger)count ofString:(NSString *)string;
+
+#pragma mark -
+
+
+@end
+
+
+@implementation YHVReplayServerTest
+
+
+#pragma mark - Setup / Tear down
+
+- (void)setUp {
+    
+    [super setUp];
+    
+    self.cassettesPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    self.cassettePath = [NSUUID UUID].UUIDString;
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+    }];
+    
+    [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    NSMutableURLRequest *postRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/post"]];
+    NSMutableURLRequest *headRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/head"]];
+    NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil];
+    postRequest.HTTPBody = [@"hello world" dataUsingEncoding:NSUTF8StringEncoding];
+    postRequest.HTTPMethod = @"POST";
+    headRequest.HTTPMethod = @"HEAD";
+    
+    [self recordChapterForRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/first"]] statusCode:200
+                             data:[@"first body" dataUsingEncoding:NSUTF8StringEncoding] error:nil];
+    [self recordChapterForRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/second"]] statusCode:200
+                             data:[@"second body" dataUsingEncoding:NSUTF8StringEncoding] error:nil];
+    [self recordChapterForRequest:postRequest statusCode:200 data:[@"post body" dataUsingEncoding:NSUTF8StringEncoding] error:nil];
+    [self recordChapterForRequest:headRequest statusCode:200 data:[@"head body" dataUsingEncoding:NSUTF8StringEncoding] error:nil];
+    [self recordChapterForRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/no-content"]]
+                       statusCode:204 data:nil error:nil];
+    [self recordChapterForRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/not-modified"]]
+                       statusCode:304 data:nil error:nil];
+    [self recordChapterForRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/error"]] statusCode:0
+                             data:nil error:error];
+    [YHVVCR ejectCassette];
+    
+    [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = self.cassettePath;
+        configuration.playbackMode = YHVMomentaryPlayback;
+        configuration.recordMode = YHVRecordNone;
+        configuration.matchers = @[YHVMatcher.method, YHVMatcher.uri, YHVMatcher.body];
+    }];
+    
+    self.server = [YHVReplayServer serverWithBaseURL:[NSURL URLWithString:@"https://httpbin.org"]];
+    XCTAssertTrue([self.server startOnPort:0]);
+    self.socket = [self connectToServer];
+}
+
+- (void)tearDown {
+    
+    if (self.socket >= 0) {
+        close(self.socket);
+    }
+    
+    [self.server stop];
+    [YHVVCR ejectCassette];
+    [NSFileManager.defaultManager removeItemAtPath:self.cassettesPath error:nil];
+    
+    [super tearDown];
+}
+
+
+#pragma mark - Tests :: Start
+
+- (void)testStartOnPort_ShouldPickFreePort_WhenZeroPassed {
+    
+    XCTAssertTrue(self.server.isRunning);
+    XCTAssertGreaterThan(self.server.port, 0);
+    XCTAssertEqualObjects(self.server.URL.absoluteString, ([NSString stringWithFormat:@"http://127.0.0.1:%@", @(self.server.port)]));
+}
+
+
+#pragma mark - Tests :: Playback
+
+- (void)testPlayback_ShouldKeepConnectionAlive_WhenRequestsSentOneByOne {
+    
+    [self sendString:@"GET /first HTTP/1.1\r\nHost: localhost\r\n\r\n"];
+    NSString *response = [self readUntilOccurrences:1 ofString:@"0\r\n\r\n"];
+    
+    XCTAssertTrue([response hasPrefix:@"HTTP/1.1 200"]);
+    XCTAssertTrue([response containsString:@"Transfer-Encoding: chunked\r\n"]);
+    XCTAssertTrue([response containsString:@"Connection: keep-alive\r\n"]);
+    XCTAssertTrue([response containsString:@"first body"]);
+    
+    [self sendString:@"GET /second HTTP/1.1\r\nHost: localhost\r\n\r\n"];
+    response = [self readUntilOccurrences:1 ofString:@"0\r\n\r\n"];
+    
+    XCTAssertTrue([response hasPrefix:@"HTTP/1.1 200"]);
+    XCTAssertTrue([response containsString:@"second body"]);
+}
+
+- (void)testPlayback_ShouldRespondInOrder_WhenRequestsPipelined {
+    
+    [self sendString:@"GET /second HTTP/1.1\r\nHost: localhost\r\n\r\nGET /first HTTP/1.1\r\nHost: localhost\r\n\r\n"];
+    NSString *response = [self readUntilOccurrences:2 ofString:@"0\r\n\r\n"];
+    NSRange secondBodyRange = [response rangeOfString:@"second body"];
+    NSRange firstBodyRange = [response rangeOfString:@"first body"];
+    
+    XCTAssertNotEqual(secondBodyRange.location, NSNotFound);
+    XCTAssertNotEqual(firstBodyRange.location, NSNotFound);
+    XCTAssertLessThan(secondBodyRange.location, firstBodyRange.location);
+}
+
+- (void)testPlayback_ShouldDecodeRequestBody_WhenBodySentWithChunkedEncoding {
+    
+    [self sendString:@"POST /post HTTP/1.1\r\nHost: localhost\r\nTransfer-Encoding: chunked\r\n\r\n"
+                      "5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n"];
+    NSString *response = [self readUntilOccurrences:1 ofString:@"0\r\n\r\n"];
+    
+    XCTAssertTrue([response hasPrefix:@"HTTP/1.1 200"]);
+    XCTAssertTrue([response containsString:@"post body"]);
+}
+
+- (void)testPlayback_ShouldNotSendBody_WhenHEADRequestReceived {
+    
+    [self sendString:@"HEAD /head HTTP/1.1\r\nHost: localhost\r\n\r\nGET /first HTTP/1.1\r\nHost: localhost\r\n\r\n"];
+    NSString *response = [self readUntilOccurrences:1 ofString:@"first body\r\n0\r\n\r\n"];
+    NSString *headResponse = [response substringToIndex:[response rangeOfString:@"HTTP/1.1" options:NSBackwardsSearch].location];
+    
+    XCTAssertTrue([headResponse hasPrefix:@"HTTP/1.1 200"]);
+    XCTAssertFalse([headResponse containsString:@"Transfer-Encoding"]);
+    XCTAssertFalse([response containsString:@"head body"]);
+    XCTAssertTrue([response containsString:@"first body"]);
+}
+
+- (void)testPlayback_ShouldNotSendBody_WhenNoContentStatusCodeRecorded {
+    
+    [self sendString:@"GET /no-content HTTP/1.1\r\nHost: localhost\r\n\r\nGET /first HTTP/1.1\r\nHost: localhost\r\n\r\n"];
+    NSString *response = [self readUntilOccurrences:1 ofString:@"first body\r\n0\r\n\r\n"];
+    NSString *noContentResponse = [response substringToIndex:[response rangeOfString:@"HTTP/1.1" options:NSBackwardsSearch].location];
+    
+    XCTAssertTrue([noContentResponse hasPrefix:@"HTTP/1.1 204"]);
+    XCTAssertTrue([noContentResponse hasSuffix:@"Connection: keep-alive\r\n\r\n"]);
+    XCTAssertFalse([noContentResponse containsString:@"Transfer-Encoding"]);
+    XCTAssertTrue([response containsString:@"first body"]);
+}
+
+- (void)testPlayback_ShouldNotSendBody_WhenNotModifiedStatusCodeRecorded {
+    
+    [self sendString:@"GET /not-modified HTTP/1.1\r\nHost: localhost\r\n\r\nGET /first HTTP/1.1\r\nHost: localhost\r\n\r\n"];
+    NSString *response = [self readUntilOccurrences:1 ofString:@"first body\r\n0\r\n\r\n"];
+    NSString *notModifiedResponse = [response substringToIndex:[response rangeOfString:@"HTTP/1.1" options:NSBackwardsSearch].location];
+    
+    XCTAssertTrue([notModifiedResponse hasPrefix:@"HTTP/1.1 304"]);
+    XCTAssertTrue([notModifiedResponse hasSuffix:@"Connection: keep-alive\r\n\r\n"]);
+    XCTAssertFalse([notModifiedResponse containsString:@"Transfer-Encoding"]);
+    XCTAssertTrue([response containsString:@"first body"]);
+}
+
+- (void)testPlayback_ShouldRespondWithNotFound_WhenRequestNotRecorded {
+    
+    [self sendString:@"GET /unknown HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n"];
+    NSString *response = [self readUntilOccurrences:1 ofString:nil];
+    
+    XCTAssertTrue([response hasPrefix:@"HTTP/1.1 404"]);
+    XCTAssertTrue([response containsString:@"Connection: close\r\n"]);
+    XCTAssertTrue([response containsString:@"There is no recorded response for GET https://httpbin.org/unknown."]);
+}
+
+- (void)testPlayback_ShouldRespondWithBadGateway_WhenErrorRecorded {
+    
+    [self sendString:@"GET /error HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n"];
+    NSString *response = [self readUntilOccurrences:1 ofString:nil];
+    
+    XCTAssertTrue([response hasPrefix:@"HTTP/1.1 502"]);
+    XCTAssertTrue([response containsString:@"Connection: close\r\n"]);
+}
+
+
+#pragma mark - Misc
+
+- (void)recordChapterForRequest:(NSURLRequest *)chapterRequest
+                     statusCode:(NSInteger)statusCode
+                           data:(NSData *)data
+                          error:(NSError *)error {
+    
+    NSURLRequest *request = [chapterRequest copy];
+    
+    [YHVVCR canPlayResponseForRequest:request];
+    [YHVVCR beginRecordingRequest:request];
+    
+    if (!error) {
+        NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:statusCode HTTPVersion:@"HTTP/1.1"
+                                                                headerFields:@{ @"Content-Type": @"text/plain" }];
+        [YHVVCR recordResponse:response forRequest:request];
+        
+        if (data) {
+            [YHVVCR recordData:data forRequest:request];
+        }
+    }
+    
+    [YHVVCR recordCompletionWithError:error forRequest:request];
+}
+
+- (int)connectToServer {
+    
+    int clientSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    struct timeval timeout = { .tv_sec = 5, .tv_usec = 0 };
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(self.server.port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    
+    setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    XCTAssertEqual(connect(clientSocket, (struct sockaddr *)&address, sizeof(address)), 0);
+    
+    return clientSocket;
+}
+
+- (void)sendString:(NSString *)string {
+    
+    NSData *data = [string dataUsingEncoding:NSUTF8StringEncoding];
+    
+    XCTAssertEqual(send(self.socket, data.bytes, data.length, 0), (ssize_t)data.length);
+}
+
+- (NSString *)readUntilOccurrences:(NSUInteger)count ofString:(NSString *)string {
+    
+    NSMutableString *received = [NSMutableString new];
+    uint8_t buffer[4096];
+    
+    while (!string || [received componentsSeparatedByString:string].count <= count) {
+        ssize_t length = recv(self.socket, buffer, sizeof(buffer), 0);
+        
+        if (length <= 0) {
+            break;
+        }
+        
+        [received appendString:[[NSString alloc] initWithBytes:buffer length:(NSUInteger)length encoding:NSISOLatin1StringEncoding]];
+    }
+    
+    return received;
+}
+
+#pragma mark -
+
+
+@end
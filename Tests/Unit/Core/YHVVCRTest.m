@@ -2,6 +2,7 @@
  * @author Serhii Mamontov
  */
 #import <XCTest/XCTest.h>
+#import <YAHTTPVCR/NSURLConnection+YHVRecorder.h>
 #import <YAHTTPVCR/NSURLRequest+YHVPlayer.h>
 #import <YAHTTPVCR/NSDictionary+YHVNSURL.h>
 #import <YAHTTPVCR/YHVCassette+Private.h>
@@ -10,6 +11,17 @@
 #import <YAHTTPVCR/YHVVCR+Player.h>
 #import <YAHTTPVCR/YAHTTPVCR.h>
 #import <OCMock/OCMock.h>
+#import <objc/runtime.h>
+
+
+#pragma mark Static
+
+/**
+ * @brief      Stores whether URL loading system hooks has been installed before any test case has been called.
+ * @discussion State captured when tests bundle loaded, because test cases can be called in any order and VCR configured by most of
+ *             them.
+ */
+static BOOL YHVHooksInstalledOnBundleLoad = NO;
 
 
 @interface YHVVCRTest : XCTestCase
@@ -19,6 +31,17 @@
 
 @property (nonatomic, copy) NSString *cassettesPath;
 
+
+#pragma mark - Misc
+
+/**
+ * @brief  Check whether URL loading system hooks has been installed.
+ *
+ * @return \c YES in case if  NSURLSessionConfiguration adds VCR's protocol to new configurations and  NSURLConnection class
+ *         methods replaced with recorder's methods.
+ */
++ (BOOL)hooksInstalled;
+
 #pragma mark -
 
 
@@ -30,6 +53,11 @@
 
 #pragma mark - Setup / Tear down
 
++ (void)load {
+    
+    YHVHooksInstalledOnBundleLoad = [self hooksInstalled];
+}
+
 - (void)setUp {
     
     [super setUp];
@@ -42,6 +70,7 @@
     
     [super tearDown];
     
+    [YHVVCR ejectCassetteForContext:self.name];
     [YHVVCR ejectCassette];
 }
 
@@ -84,6 +113,37 @@
 }
 
 
+#pragma mark - Tests :: Hooks
+
+- (void)testHooks_ShouldNotBeInstalled_WhenVCRNotConfigured {
+    
+    XCTAssertFalse(YHVHooksInstalledOnBundleLoad);
+}
+
+- (void)testHooks_ShouldBeInstalledOnce_WhenVCRConfiguredAndCassetteInsertedRepeatedly {
+    
+    for (NSUInteger attemptIdx = 0; attemptIdx < 2; attemptIdx++) {
+        [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+            configuration.cassettesPath = self.cassettesPath;
+        }];
+        
+        XCTAssertTrue([[self class] hooksInstalled]);
+        
+        [YHVVCR insertCassetteWithPath:[NSUUID UUID].UUIDString];
+        [YHVVCR ejectCassette];
+        
+        XCTAssertTrue([[self class] hooksInstalled]);
+    }
+    
+    NSArray *protocolClasses = [NSURLSessionConfiguration defaultSessionConfiguration].protocolClasses;
+    NSIndexSet *indices = [protocolClasses indexesOfObjectsPassingTest:^BOOL(Class protocolClass, NSUInteger idx, BOOL *stop) {
+        return protocolClass == [YHVNSURLProtocol class];
+    }];
+    
+    XCTAssertEqual(indices.count, 1);
+}
+
+
 #pragma mark - Tests :: Cassette
 
 - (void)testInsertCassetteWithPath_ShouldInsertCassette_WhenPathPassed {
@@ -101,6 +161,216 @@
     XCTAssertEqual(YHVVCR.cassette.responses.count, 0);
 }
 
+- (void)testInsertCassetteWithPath_ShouldProvideRecordedRequestsAndResponses_WhenChapterRecorded {
+    
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/get"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"text/plain" }];
+    NSData *expectedData = [@"Yet Another HTTP VCR" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteWithPath:[NSUUID UUID].UUIDString];
+    // Cassette tag request with it's identifier before recording.
+    XCTAssertFalse([cassette canPlayResponseForRequest:request]);
+    
+    [cassette beginRecordingRequest:request];
+    [cassette recordResponse:response forRequest:request];
+    [cassette recordData:[expectedData subdataWithRange:NSMakeRange(0, 8)] forRequest:request];
+    [cassette recordData:[expectedData subdataWithRange:NSMakeRange(8, expectedData.length - 8)] forRequest:request];
+    [cassette recordCompletionWithError:nil forRequest:request];
+    
+    XCTAssertEqual(cassette.requests.count, 1);
+    XCTAssertEqual(cassette.responses.count, 1);
+    XCTAssertEqual(((NSHTTPURLResponse *)cassette.responses.firstObject.firstObject).statusCode, 200);
+    XCTAssertEqualObjects(cassette.responses.firstObject.lastObject, expectedData);
+    XCTAssertEqual(cassette.playCount, 1);
+    XCTAssertFalse(cassette.allPlayed);
+}
+
+- (void)testInsertCassetteWithPath_ShouldReuseRequestsAndResponses_WhenCassetteNotChanged {
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteWithPath:[NSUUID UUID].UUIDString];
+    
+    XCTAssertEqual(cassette.requests, cassette.requests);
+    XCTAssertEqual(cassette.responses, cassette.responses);
+}
+
+- (void)testStatistics_ShouldCountRecordedAndSavedData_WhenChapterRecorded {
+    
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/get"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"text/plain" }];
+    NSData *expectedData = [@"Yet Another HTTP VCR" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteWithPath:[NSUUID UUID].UUIDString];
+    [cassette canPlayResponseForRequest:request];
+    [cassette beginRecordingRequest:request];
+    [cassette recordResponse:response forRequest:request];
+    [cassette recordData:expectedData forRequest:request];
+    [cassette recordCompletionWithError:nil forRequest:request];
+    [YHVVCR ejectCassette];
+    
+    YHVCassetteStatistics *statistics = cassette.statistics;
+    XCTAssertEqual(statistics.recordedBytesCount, expectedData.length);
+    XCTAssertEqual(statistics.chaptersCount, 1);
+    XCTAssertGreaterThan(statistics.scenesCount, 1);
+    XCTAssertGreaterThan(statistics.savedBytesCount, 0);
+    XCTAssertEqual(statistics.lookupsCount, 0);
+    XCTAssertEqual(statistics.replayLatencyHistogram.count, YHVCassetteStatistics.replayLatencyBucketsBounds.count + 1);
+}
+
+- (void)testStatistics_ShouldCountLookups_WhenRecordedRequestMatched {
+    
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/get"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"text/plain" }];
+    NSString *cassettePath = [NSUUID UUID].UUIDString;
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteWithPath:cassettePath];
+    [cassette canPlayResponseForRequest:request];
+    [cassette beginRecordingRequest:request];
+    [cassette recordResponse:response forRequest:request];
+    [cassette recordCompletionWithError:nil forRequest:request];
+    [YHVVCR ejectCassette];
+    
+    cassette = [YHVVCR insertCassetteWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = cassettePath;
+        configuration.recordMode = YHVRecordNone;
+    }];
+    NSMutableURLRequest *playedRequest = [NSMutableURLRequest requestWithURL:request.URL];
+    
+    XCTAssertTrue([cassette canPlayResponseForRequest:playedRequest]);
+    
+    YHVCassetteStatistics *statistics = cassette.statistics;
+    XCTAssertGreaterThan(statistics.loadedBytesCount, 0);
+    XCTAssertEqual(statistics.lookupsCount, 1);
+    XCTAssertEqual(statistics.scannedCandidatesCount, 1);
+    XCTAssertEqual(statistics.maximumScannedCandidatesCount, 1);
+    XCTAssertEqual(statistics.indexResolvedCandidatesCount + statistics.matcherEvaluations[YHVMatcher.method].unsignedIntegerValue, 1);
+}
+
+- (void)testInsertCassetteForContext_ShouldInsertCassette_WhenDefaultCassetteInserted {
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    YHVCassette *defaultCassette = [YHVVCR insertCassetteWithPath:[NSUUID UUID].UUIDString];
+    YHVCassette *cassette = [YHVVCR insertCassetteForContext:self.name withConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = [NSUUID UUID].UUIDString;
+    }];
+    
+    XCTAssertNotNil(cassette);
+    XCTAssertNotEqual(cassette, defaultCassette);
+    XCTAssertEqual([YHVVCR cassetteForContext:self.name], cassette);
+    XCTAssertEqual(YHVVCR.cassette, defaultCassette);
+    
+    [YHVVCR ejectCassetteForContext:self.name];
+    
+    XCTAssertNil([YHVVCR cassetteForContext:self.name]);
+    XCTAssertEqual(YHVVCR.cassette, defaultCassette);
+}
+
+- (void)testInsertCassetteForContext_ShouldThrow_WhenCassetteForContextInserted {
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+    }];
+    
+    [YHVVCR insertCassetteForContext:self.name withConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = [NSUUID UUID].UUIDString;
+    }];
+    
+    XCTAssertThrowsSpecificNamed([YHVVCR insertCassetteForContext:self.name withConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = [NSUUID UUID].UUIDString;
+    }], NSException, NSInternalInconsistencyException);
+}
+
+- (void)testInsertCassetteForContext_ShouldRecordRequestOnContextCassette_WhenContextStampedOnRequest {
+    
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/get"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"text/plain" }];
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    YHVCassette *defaultCassette = [YHVVCR insertCassetteWithPath:[NSUUID UUID].UUIDString];
+    YHVCassette *cassette = [YHVVCR insertCassetteForContext:self.name withConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = [NSUUID UUID].UUIDString;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    [YHVVCR setContext:self.name forRequest:request];
+    
+    XCTAssertFalse([YHVVCR canPlayResponseForRequest:request]);
+    [YHVVCR beginRecordingRequest:request];
+    [YHVVCR recordResponse:response forRequest:request];
+    [YHVVCR recordCompletionWithError:nil forRequest:request];
+    
+    XCTAssertEqual(cassette.requests.count, 1);
+    XCTAssertEqual(defaultCassette.requests.count, 0);
+}
+
+- (void)testInsertCassetteForContext_ShouldRecordEachTask_WhenTasksCreatedFromSameTemplateRequest {
+    
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/get"]];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{ @"Content-Type": @"text/plain" }];
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    
+    YHVCassette *cassette = [YHVVCR insertCassetteForContext:self.name withConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettePath = [NSUUID UUID].UUIDString;
+        configuration.recordMode = YHVRecordAll;
+    }];
+    [YHVVCR setContext:self.name forRequest:request];
+    
+    // Each task work with own copy of template request.
+    NSURLRequest *taskRequest1 = [request copy];
+    NSURLRequest *taskRequest2 = [request copy];
+    
+    XCTAssertFalse([YHVVCR canPlayResponseForRequest:taskRequest1]);
+    XCTAssertFalse([YHVVCR canPlayResponseForRequest:taskRequest2]);
+    [YHVVCR beginRecordingRequest:taskRequest1];
+    [YHVVCR beginRecordingRequest:taskRequest2];
+    [YHVVCR recordResponse:response forRequest:taskRequest1];
+    [YHVVCR recordResponse:response forRequest:taskRequest2];
+    [YHVVCR recordCompletionWithError:nil forRequest:taskRequest1];
+    [YHVVCR recordCompletionWithError:nil forRequest:taskRequest2];
+    
+    XCTAssertEqual(cassette.requests.count, 2);
+    XCTAssertNotEqualObjects(taskRequest1.YHV_identifier, taskRequest2.YHV_identifier);
+    XCTAssertEqualObjects(request.YHV_context, self.name);
+    XCTAssertNil(request.YHV_cassetteChapterIdentifier);
+    XCTAssertNil(request.YHV_cassetteIdentifier);
+    XCTAssertNil(request.YHV_identifier);
+}
+
 - (void)testInsertCassetteWithPath_ShouldSetCassettePath {
     
     NSString *path = [NSUUID UUID].UUIDString;
@@ -804,6 +1074,44 @@
     XCTAssertNil(YHVVCR.cassette.configuration.beforeRecordRequest(request));
 }
 
+- (void)testBeforeRecordRequestFilter_ShouldFilterStreamedBody_WhenBodyReplacementPassed {
+    
+    NSData *body = [@"{\"field1\":\"value1\",\"field2\":\"value2\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"http://localhost/something"]];
+    [request setAllHTTPHeaderFields:@{ @"Content-Type": @"application/json" }];
+    request.HTTPMethod = @"POST";
+    NSMutableURLRequest *bodyRequest = [request mutableCopy];
+    bodyRequest.HTTPBody = body;
+    uint8_t buffer[128];
+    
+    [YHVVCR setupWithConfiguration:^(YHVConfiguration *configuration) {
+        configuration.cassettesPath = self.cassettesPath;
+        configuration.postBodyFilter = @{ @"field2": @"secret-body-value" };
+    }];
+    [YHVVCR insertCassetteWithPath:[NSUUID UUID].UUIDString];
+    
+    [YHVNSURLRequest enableHTTPBodyCaptureWithHostsFilter:nil];
+    request.HTTPBodyStream = [NSInputStream inputStreamWithData:body];
+    [YHVNSURLRequest disableHTTPBodyCapture];
+    
+    NSURLRequest *filteredStreamRequest = YHVVCR.cassette.configuration.beforeRecordRequest(request);
+    NSURLRequest *filteredRequest = YHVVCR.cassette.configuration.beforeRecordRequest(bodyRequest);
+    NSDictionary *jsonData = [NSJSONSerialization JSONObjectWithData:filteredStreamRequest.YHV_HTTPBody
+                                                             options:NSJSONReadingAllowFragments
+                                                               error:nil];
+    
+    XCTAssertEqualObjects(jsonData[@"field2"], @"secret-body-value");
+    XCTAssertEqualObjects(filteredStreamRequest.YHV_HTTPBody, filteredRequest.YHV_HTTPBody);
+    XCTAssertEqualObjects(filteredStreamRequest.YHV_HTTPBodyDigest, filteredRequest.YHV_HTTPBodyDigest);
+    
+    // Drained stream should still provide original body to URL loading system.
+    [request.HTTPBodyStream open];
+    NSInteger length = [request.HTTPBodyStream read:buffer maxLength:sizeof(buffer)];
+    [request.HTTPBodyStream close];
+    
+    XCTAssertEqualObjects([NSData dataWithBytes:buffer length:(NSUInteger)length], body);
+}
+
 - (void)testBeforeRecordRequestFilter_ShouldReturnSameRequest_WhenNoFiltersSpecified {
     
     NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"http://localhost2/?field1=value1&field2=value2"]];
@@ -1299,6 +1607,20 @@
     cassettePartialMock = nil;
 }
 
+#pragma mark - Misc
+
++ (BOOL)hooksInstalled {
+    
+    SEL swizzledSelector = NSSelectorFromString(@"YHV_sendSynchronousRequest:returningResponse:error:");
+    SEL selector = NSSelectorFromString(@"sendSynchronousRequest:returningResponse:error:");
+    Method swizzledMethod = class_getClassMethod([YHVNSURLConnection class], swizzledSelector);
+    Method method = class_getClassMethod([NSURLConnection class], selector);
+    NSArray *protocolClasses = [NSURLSessionConfiguration defaultSessionConfiguration].protocolClasses;
+    
+    return method_getImplementation(method) == method_getImplementation(swizzledMethod) &&
+           [protocolClasses containsObject:[YHVNSURLProtocol class]];
+}
+
 #pragma mark -
 
 
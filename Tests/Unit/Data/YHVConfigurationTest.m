@@ -87,6 +87,12 @@
     };
     self.configuration.recordMode = YHVRecordNew;
     self.configuration.matchers = @[YHVMatcher.query];
+    self.configuration.playbackBytesPerSecond = 1024;
+    self.configuration.playbackChunkSize = 256;
+    self.configuration.playbackInitialLatency = 0.5f;
+    self.configuration.throttledHosts = @[@"httpbin.org"];
+    self.configuration.spillToDiskThreshold = 1024 * 1024;
+    self.configuration.playedScenesMemoryBudget = 512 * 1024;
     
     YHVConfiguration *configurationCopy = [self.configuration copy];
     
@@ -104,6 +110,47 @@
     XCTAssertEqual(configurationCopy.recordMode, self.configuration.recordMode);
     XCTAssertEqualObjects(configurationCopy.matchers, self.configuration.matchers);
     XCTAssertEqualObjects(configurationCopy.urlFilter, self.configuration.urlFilter);
+    XCTAssertEqual(configurationCopy.playbackBytesPerSecond, self.configuration.playbackBytesPerSecond);
+    XCTAssertEqual(configurationCopy.playbackChunkSize, self.configuration.playbackChunkSize);
+    XCTAssertEqual(configurationCopy.playbackInitialLatency, self.configuration.playbackInitialLatency);
+    XCTAssertEqualObjects(configurationCopy.throttledHosts, self.configuration.throttledHosts);
+    XCTAssertEqual(configurationCopy.spillToDiskThreshold, self.configuration.spillToDiskThreshold);
+    XCTAssertEqual(configurationCopy.playedScenesMemoryBudget, self.configuration.playedScenesMemoryBudget);
+}
+
+- (void)testCopyWithDefaults_ShouldUseThrottlingFromDefaults_WhenNotSet {
+    
+    YHVConfiguration *defaultConfiguration = [YHVConfiguration defaultConfiguration];
+    defaultConfiguration.playbackBytesPerSecond = 1024;
+    defaultConfiguration.playbackChunkSize = 256;
+    defaultConfiguration.playbackInitialLatency = 0.5f;
+    defaultConfiguration.throttledHosts = @[@"httpbin.org"];
+    
+    YHVConfiguration *configuration = [self.configuration copyWithDefaultsFromConfiguration:defaultConfiguration];
+    
+    XCTAssertEqual(configuration.playbackBytesPerSecond, defaultConfiguration.playbackBytesPerSecond);
+    XCTAssertEqual(configuration.playbackChunkSize, defaultConfiguration.playbackChunkSize);
+    XCTAssertEqual(configuration.playbackInitialLatency, defaultConfiguration.playbackInitialLatency);
+    XCTAssertEqualObjects(configuration.throttledHosts, defaultConfiguration.throttledHosts);
+}
+
+
+#pragma mark - Tests :: Throttling
+
+- (void)testThrottledHosts_ShouldStoreLowercasedHosts_WhenHostsSet {
+    
+    self.configuration.throttledHosts = @[@"HTTPBin.org", @"api.Example.com"];
+    
+    XCTAssertEqualObjects(self.configuration.lowercaseThrottledHosts, ([NSSet setWithArray:@[@"httpbin.org", @"api.example.com"]]));
+    XCTAssertEqualObjects([self.configuration copy].lowercaseThrottledHosts, self.configuration.lowercaseThrottledHosts);
+}
+
+- (void)testThrottledHosts_ShouldResetLowercasedHosts_WhenHostsRemoved {
+    
+    self.configuration.throttledHosts = @[@"httpbin.org"];
+    self.configuration.throttledHosts = nil;
+    
+    XCTAssertNil(self.configuration.lowercaseThrottledHosts);
 }
 
 #pragma mark -
@@ -0,0 +1,121 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import <XCTest/XCTest.h>
+#import <YAHTTPVCR/YHVLoadReplayReport+Private.h>
+
+
+@interface YHVLoadReplayReportTest : XCTestCase
+
+
+#pragma mark - Information
+
+@property (nonatomic, strong) YHVLoadReplayReport *report;
+
+#pragma mark -
+
+
+@end
+
+
+@implementation YHVLoadReplayReportTest
+
+
+#pragma mark - Setup / Tear down
+
+- (void)setUp {
+    
+    [super setUp];
+    
+    self.report = [YHVLoadReplayReport reportWithLatencies:@[@0.5, @0.1, @0.4, @0.2, @0.3]
+                                             requestsCount:6
+                                       failedRequestsCount:1
+                                  mismatchedResponsesCount:2
+                                                mismatches:@[@"mismatch"]
+                                                  duration:2.f];
+}
+
+
+#pragma mark - Tests :: Latency
+
+- (void)testLatency_ShouldUseNearestRank_WhenPercentileRequested {
+    
+    XCTAssertEqualWithAccuracy(self.report.medianLatency, 0.3, DBL_EPSILON);
+    XCTAssertEqualWithAccuracy(self.report.p90Latency, 0.5, DBL_EPSILON);
+    XCTAssertEqualWithAccuracy(self.report.p99Latency, 0.5, DBL_EPSILON);
+    XCTAssertEqualWithAccuracy([self.report latencyAtPercentile:20.f], 0.1, DBL_EPSILON);
+    XCTAssertEqualWithAccuracy([self.report latencyAtPercentile:21.f], 0.2, DBL_EPSILON);
+}
+
+- (void)testLatency_ShouldReturnMinimumAndMaximum_WhenPercentileOutOfRange {
+    
+    XCTAssertEqualWithAccuracy([self.report latencyAtPercentile:-10.f], 0.1, DBL_EPSILON);
+    XCTAssertEqualWithAccuracy([self.report latencyAtPercentile:0.f], 0.1, DBL_EPSILON);
+    XCTAssertEqualWithAccuracy([self.report latencyAtPercentile:150.f], 0.5, DBL_EPSILON);
+    XCTAssertEqualWithAccuracy(self.report.maximumLatency, 0.5, DBL_EPSILON);
+}
+
+- (void)testLatency_ShouldUseNearestRank_WhenLatenciesCountIsRound {
+    
+    NSMutableArray<NSNumber *> *latencies = [NSMutableArray new];
+    
+    for (NSUInteger latencyIdx = 100; latencyIdx > 0; latencyIdx--) {
+        [latencies addObject:@(latencyIdx / 1000.f)];
+    }
+    
+    YHVLoadReplayReport *report = [YHVLoadReplayReport reportWithLatencies:latencies requestsCount:100 failedRequestsCount:0
+                                                  mismatchedResponsesCount:0 mismatches:@[] duration:1.f];
+    
+    XCTAssertEqualWithAccuracy(report.medianLatency, 0.05, 0.0001);
+    XCTAssertEqualWithAccuracy(report.p90Latency, 0.09, 0.0001);
+    XCTAssertEqualWithAccuracy(report.p99Latency, 0.099, 0.0001);
+    XCTAssertEqualWithAccuracy(report.maximumLatency, 0.1, 0.0001);
+}
+
+- (void)testLatency_ShouldReturnZero_WhenThereIsNoLatencies {
+    
+    YHVLoadReplayReport *report = [YHVLoadReplayReport reportWithLatencies:@[] requestsCount:1 failedRequestsCount:1
+                                                  mismatchedResponsesCount:0 mismatches:@[] duration:1.f];
+    
+    XCTAssertEqual(report.medianLatency, 0.f);
+    XCTAssertEqual(report.p99Latency, 0.f);
+    XCTAssertEqual(report.maximumLatency, 0.f);
+}
+
+
+#pragma mark - Tests :: Throughput
+
+- (void)testThroughput_ShouldUseCompletedRequests_WhenDurationKnown {
+    
+    XCTAssertEqualWithAccuracy(self.report.throughput, 2.5, DBL_EPSILON);
+}
+
+- (void)testThroughput_ShouldReturnZero_WhenDurationIsZero {
+    
+    YHVLoadReplayReport *report = [YHVLoadReplayReport reportWithLatencies:@[@0.1] requestsCount:1 failedRequestsCount:0
+                                                  mismatchedResponsesCount:0 mismatches:@[] duration:0.f];
+    
+    XCTAssertEqual(report.throughput, 0.f);
+}
+
+
+#pragma mark - Tests :: Serialization
+
+- (void)testDictionaryRepresentation_ShouldContainCountersAndLatencies {
+    
+    NSDictionary *dictionary = [self.report dictionaryRepresentation];
+    
+    XCTAssertEqualObjects(dictionary[@"requests"], @6);
+    XCTAssertEqualObjects(dictionary[@"failed"], @1);
+    XCTAssertEqualObjects(dictionary[@"mismatched"], @2);
+    XCTAssertEqualObjects(dictionary[@"mismatches"], @[@"mismatch"]);
+    XCTAssertEqualObjects(dictionary[@"latency"][@"p50"], @0.3);
+    XCTAssertEqualObjects(dictionary[@"latency"][@"max"], @0.5);
+    XCTAssertTrue([NSJSONSerialization isValidJSONObject:dictionary]);
+}
+
+#pragma mark -
+
+
+@end
@@ -217,6 +217,24 @@
     XCTAssertEqualObjects(scene.data, expectedScene.data);
 }
 
+- (void)testObjectFromDictionary_ShouldKeepSerializedData_WhenDataNotAccessed {
+    
+    NSDictionary *dictionary = [self sceneDictionaryRepresentationForObject:self.expectedRequest withType:YHVRequestScene];
+    YHVScene *scene = [YHVScene YHV_objectFromDictionary:dictionary];
+    
+    XCTAssertTrue(scene.isSerialized);
+    XCTAssertEqual([scene YHV_dictionaryRepresentation][@"data"], dictionary[@"data"]);
+}
+
+- (void)testObjectFromDictionary_ShouldReuseSerializedData_WhenDataDecoded {
+    
+    NSDictionary *dictionary = [self sceneDictionaryRepresentationForObject:self.expectedData withType:YHVDataScene];
+    YHVScene *scene = [YHVScene YHV_objectFromDictionary:dictionary];
+    
+    XCTAssertEqualObjects(scene.data, self.expectedData);
+    XCTAssertEqual([scene YHV_dictionaryRepresentation][@"data"], dictionary[@"data"]);
+}
+
 - (void)testObjectFromDictionary_ShouldThrow_WhenDictionaryIsNil {
     
     NSMutableDictionary *sceneInfo = nil;
@@ -262,6 +280,43 @@
 }
 
 
+#pragma mark - Tests :: Memory management
+
+- (void)testReleaseData_ShouldReleaseData_WhenSceneIsSerialized {
+    
+    NSDictionary *dictionary = [self sceneDictionaryRepresentationForObject:self.expectedData withType:YHVDataScene];
+    YHVScene *scene = [YHVScene YHV_objectFromDictionary:dictionary];
+    
+    XCTAssertGreaterThan(scene.estimatedDataSize, 0);
+    [scene releaseData];
+    
+    XCTAssertTrue(scene.isDataReleased);
+    XCTAssertNil(scene.data);
+}
+
+- (void)testReleaseData_ShouldNotReleaseData_WhenSceneIsNotSerialized {
+    
+    YHVScene *scene = [YHVScene sceneWithIdentifier:@"test" type:YHVDataScene data:self.expectedData];
+    
+    [scene releaseData];
+    
+    XCTAssertFalse(scene.isDataReleased);
+    XCTAssertEqualObjects(scene.data, self.expectedData);
+}
+
+- (void)testRestoreSerializedData_ShouldDecodeRestoredData_WhenDataReleased {
+    
+    NSDictionary *dictionary = [self sceneDictionaryRepresentationForObject:self.expectedData withType:YHVDataScene];
+    YHVScene *scene = [YHVScene YHV_objectFromDictionary:dictionary];
+    
+    [scene releaseData];
+    [scene restoreSerializedData:dictionary[@"data"]];
+    
+    XCTAssertFalse(scene.isDataReleased);
+    XCTAssertEqualObjects(scene.data, self.expectedData);
+}
+
+
 #pragma mark - Tests :: Description
 
 - (void)testDescription_ShouldProvideCustomizedDescription {
@@ -3,6 +3,10 @@
  */
 #import <XCTest/XCTest.h>
 #import <YAHTTPVCR/NSData+YHVSerialization.h>
+#import <YAHTTPVCR/NSData+YHVGZIP.h>
+#import <YAHTTPVCR/YHVSerializationHelper.h>
+#import <YAHTTPVCR/YHVBase64.h>
+#import <YAHTTPVCR/YHVZlibCodec.h>
 
 
 @interface NSDataCategoryTest : XCTestCase
@@ -16,6 +20,18 @@
 @property (nonatomic, copy) NSString *testString;
 
 
+#pragma mark - Misc
+
+/**
+ * @brief  Create JSON body which is used by serialization performance tests.
+ */
+- (NSData *)JSONBodyForPerformanceTests;
+
+/**
+ * @brief  Create data filled with random bytes.
+ */
+- (NSData *)randomDataWithLength:(NSUInteger)length;
+
 #pragma mark -
 
 
@@ -55,6 +71,39 @@
     XCTAssertEqualObjects(self.dictionaryRepresentation[@"base64"], self.base64EncodedTestString);
 }
 
+- (void)testDictionaryRepresentation_ShouldStoreInlineText_WhenTextContentType {
+    
+    NSDictionary *dictionary = [self.testStringData YHV_dictionaryRepresentationWithContentType:@"application/json; charset=utf-8"];
+    
+    XCTAssertEqualObjects(dictionary[@"text"], self.testString);
+    XCTAssertNil(dictionary[@"base64"]);
+}
+
+- (void)testDictionaryRepresentation_ShouldStoreBase64_WhenBinaryContentType {
+    
+    NSDictionary *dictionary = [self.testStringData YHV_dictionaryRepresentationWithContentType:@"application/octet-stream"];
+    
+    XCTAssertEqualObjects(dictionary[@"base64"], self.base64EncodedTestString);
+    XCTAssertNil(dictionary[@"text"]);
+}
+
+- (void)testDictionaryRepresentation_ShouldStoreBase64_WhenDataIsNotValidUTF8 {
+    
+    uint8_t bytes[] = { 0x7B, 0xFF, 0xFE, 0x7D };
+    NSData *data = [NSData dataWithBytes:bytes length:sizeof(bytes)];
+    NSDictionary *dictionary = [data YHV_dictionaryRepresentationWithContentType:@"text/plain"];
+    
+    XCTAssertNotNil(dictionary[@"base64"]);
+    XCTAssertNil(dictionary[@"text"]);
+}
+
+- (void)testDictionaryRepresentation_ShouldStoreBase64_WhenNonUTF8Charset {
+    
+    NSDictionary *dictionary = [self.testStringData YHV_dictionaryRepresentationWithContentType:@"text/plain; charset=ISO-8859-1"];
+    
+    XCTAssertNotNil(dictionary[@"base64"]);
+}
+
 
 #pragma mark - Tests :: Object from dictionary
 
@@ -72,6 +121,221 @@
     XCTAssertEqualObjects(string, self.testString);
 }
 
+- (void)testObjectFromDictionary_ShouldRestoreInlineText {
+    
+    NSDictionary *dictionary = [self.testStringData YHV_dictionaryRepresentationWithContentType:@"text/plain"];
+    id data = [YHVSerializationHelper objectFromDictionary:dictionary];
+    
+    XCTAssertTrue([data isKindOfClass:[NSData class]]);
+    XCTAssertEqualObjects(data, self.testStringData);
+}
+
+
+#pragma mark - Tests :: Base64
+
+- (void)testBase64_ShouldMatchFoundationEncoding_WhenDataHasAnyLength {
+    
+    for (NSUInteger length = 0; length < 300; length++) {
+        NSData *data = [self randomDataWithLength:length];
+        NSString *expected = [data base64EncodedStringWithOptions:(NSDataBase64EncodingOptions)0];
+        
+        XCTAssertEqualObjects([YHVBase64 stringByEncodingData:data], expected);
+        XCTAssertEqualObjects([YHVBase64 dataByEncodingData:data], [expected dataUsingEncoding:NSASCIIStringEncoding]);
+        XCTAssertEqualObjects([YHVBase64 dataByDecodingString:expected], data);
+    }
+}
+
+- (void)testBase64_ShouldReturnNil_WhenStringContainsInvalidCharacters {
+    
+    NSString *encoded = [YHVBase64 stringByEncodingData:[self randomDataWithLength:120]];
+    NSString *invalid = [encoded stringByReplacingCharactersInRange:NSMakeRange(50, 1) withString:@"*"];
+    
+    XCTAssertNil([YHVBase64 dataByDecodingString:invalid]);
+}
+
+
+#pragma mark - Tests :: Performance
+
+- (void)testSerializationPerformance_ShouldLoadInlineTextBody {
+    
+    NSData *body = [self JSONBodyForPerformanceTests];
+    NSData *inlineData = [NSJSONSerialization dataWithJSONObject:@[[body YHV_dictionaryRepresentationWithContentType:@"application/json"]]
+                                                         options:(NSJSONWritingOptions)0
+                                                           error:nil];
+    NSData *base64Data = [NSJSONSerialization dataWithJSONObject:@[[body YHV_dictionaryRepresentation]]
+                                                         options:(NSJSONWritingOptions)0
+                                                           error:nil];
+    
+    XCTAssertLessThan(inlineData.length, base64Data.length);
+    
+    [self measureBlock:^{
+        NSArray *content = [NSJSONSerialization JSONObjectWithData:inlineData options:(NSJSONReadingOptions)0 error:nil];
+        NSData *restored = (NSData *)[YHVSerializationHelper objectFromDictionary:content.firstObject];
+        
+        XCTAssertEqual(restored.length, body.length);
+    }];
+}
+
+- (void)testSerializationPerformance_ShouldLoadBase64EncodedBody {
+    
+    NSData *body = [self JSONBodyForPerformanceTests];
+    NSData *base64Data = [NSJSONSerialization dataWithJSONObject:@[[body YHV_dictionaryRepresentation]]
+                                                         options:(NSJSONWritingOptions)0
+                                                           error:nil];
+    
+    [self measureBlock:^{
+        NSArray *content = [NSJSONSerialization JSONObjectWithData:base64Data options:(NSJSONReadingOptions)0 error:nil];
+        NSData *restored = (NSData *)[YHVSerializationHelper objectFromDictionary:content.firstObject];
+        
+        XCTAssertEqual(restored.length, body.length);
+    }];
+}
+
+- (void)testSerializationPerformance_ShouldSaveInlineTextBody {
+    
+    NSData *body = [self JSONBodyForPerformanceTests];
+    __block NSUInteger inlineDataLength = 0;
+    NSUInteger base64DataLength = [NSJSONSerialization dataWithJSONObject:@[[body YHV_dictionaryRepresentation]]
+                                                                  options:(NSJSONWritingOptions)0
+                                                                    error:nil].length;
+    
+    [self measureBlock:^{
+        NSDictionary *dictionary = [body YHV_dictionaryRepresentationWithContentType:@"application/json"];
+        NSData *data = [NSJSONSerialization dataWithJSONObject:@[dictionary] options:(NSJSONWritingOptions)0 error:nil];
+        
+        XCTAssertEqualObjects(dictionary[@"cls"], @"YHVText");
+        inlineDataLength = data.length;
+    }];
+    
+    XCTAssertLessThan(inlineDataLength, base64DataLength);
+}
+
+- (void)testSerializationPerformance_ShouldSaveBase64EncodedBody {
+    
+    NSData *body = [self JSONBodyForPerformanceTests];
+    __block NSUInteger base64DataLength = 0;
+    NSUInteger inlineDataLength = [NSJSONSerialization dataWithJSONObject:@[[body YHV_dictionaryRepresentationWithContentType:@"application/json"]]
+                                                                  options:(NSJSONWritingOptions)0
+                                                                    error:nil].length;
+    
+    [self measureBlock:^{
+        NSDictionary *dictionary = [body YHV_dictionaryRepresentation];
+        NSData *data = [NSJSONSerialization dataWithJSONObject:@[dictionary] options:(NSJSONWritingOptions)0 error:nil];
+        
+        XCTAssertNotNil(dictionary[@"base64"]);
+        base64DataLength = data.length;
+    }];
+    
+    XCTAssertGreaterThan(base64DataLength, inlineDataLength);
+}
+
+- (void)testBase64Performance_ShouldEncodeAndDecodeWithVectorizedCodec {
+    
+    NSData *data = [self randomDataWithLength:(4 * 1024 * 1024)];
+    
+    [self measureBlock:^{
+        NSString *encoded = [YHVBase64 stringByEncodingData:data];
+        
+        XCTAssertEqual([YHVBase64 dataByDecodingString:encoded].length, data.length);
+    }];
+}
+
+- (void)testBase64Performance_ShouldEncodeAndDecodeWithFoundation {
+    
+    NSData *data = [self randomDataWithLength:(4 * 1024 * 1024)];
+    
+    [self measureBlock:^{
+        NSString *encoded = [data base64EncodedStringWithOptions:(NSDataBase64EncodingOptions)0];
+        NSData *decoded = [[NSData alloc] initWithBase64EncodedString:encoded options:(NSDataBase64DecodingOptions)0];
+        
+        XCTAssertEqual(decoded.length, data.length);
+    }];
+}
+
+
+#pragma mark - Tests :: GZIP
+
+- (void)testZipped_ShouldRestoreOriginalData_WhenUnzipped {
+    
+    NSData *zipped = [self.testStringData YHV_zipped];
+    
+    XCTAssertNotNil(zipped);
+    XCTAssertNotEqualObjects(zipped, self.testStringData);
+    XCTAssertEqualObjects([zipped YHV_unzipped], self.testStringData);
+}
+
+- (void)testUnzipped_ShouldReturnNil_WhenDataNotCompressed {
+    
+    XCTAssertNil([self.testStringData YHV_unzipped]);
+}
+
+- (void)testUnzipped_ShouldRestoreLargeHighlyCompressibleData {
+    
+    NSMutableData *data = [NSMutableData dataWithLength:(8 * 1024 * 1024)];
+    NSData *zipped = [data YHV_zipped];
+    
+    XCTAssertLessThan(zipped.length, data.length / 100);
+    XCTAssertEqualObjects([zipped YHV_unzipped], data);
+}
+
+- (void)testCodec_ShouldInflateData_WhenPassedInChunks {
+    
+    NSMutableData *data = [NSMutableData new];
+    for (NSUInteger idx = 0; idx < 10000; idx++) {
+        [data appendData:self.testStringData];
+    }
+    
+    NSData *zipped = [data YHV_zipped];
+    YHVZlibCodec *codec = [YHVZlibCodec inflater];
+    
+    for (NSUInteger offset = 0; offset < zipped.length; offset += 100) {
+        NSRange range = NSMakeRange(offset, MIN(100, zipped.length - offset));
+        
+        XCTAssertTrue([codec appendData:[zipped subdataWithRange:range]]);
+    }
+    
+    XCTAssertTrue(codec.isFinished);
+    XCTAssertEqualObjects([codec finish], data);
+}
+
+- (void)testCodec_ShouldReturnNil_WhenTruncatedDataInflated {
+    
+    NSData *zipped = [[self randomDataWithLength:4096] YHV_zipped];
+    NSData *truncated = [zipped subdataWithRange:NSMakeRange(0, zipped.length / 2)];
+    YHVZlibCodec *codec = [YHVZlibCodec inflater];
+    
+    XCTAssertTrue([codec appendData:truncated]);
+    XCTAssertFalse(codec.isFinished);
+    XCTAssertNil([codec finish]);
+    XCTAssertNil([truncated YHV_unzipped]);
+}
+
+
+#pragma mark - Misc
+
+- (NSData *)randomDataWithLength:(NSUInteger)length {
+    
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    uint8_t *bytes = data.mutableBytes;
+    
+    for (NSUInteger byteIdx = 0; byteIdx < length; byteIdx++) {
+        bytes[byteIdx] = (uint8_t)arc4random_uniform(256);
+    }
+    
+    return data;
+}
+
+- (NSData *)JSONBodyForPerformanceTests {
+    
+    NSMutableArray *items = [NSMutableArray new];
+    
+    for (NSUInteger itemIdx = 0; itemIdx < 20000; itemIdx++) {
+        [items addObject:@{ @"id": @(itemIdx), @"name": self.testString, @"tags": @[@"vcr", @"http"] }];
+    }
+    
+    return [NSJSONSerialization dataWithJSONObject:items options:(NSJSONWritingOptions)0 error:nil];
+}
+
 #pragma mark -
 
 
@@ -6,6 +6,8 @@
 #import <YAHTTPVCR/NSURLRequest+YHVSerialization.h>
 #import <YAHTTPVCR/NSData+YHVSerialization.h>
 #import <YAHTTPVCR/YHVSerializationHelper.h>
+#import <YAHTTPVCR/YHVTeeInputStream.h>
+#import <YAHTTPVCR/YHVRequestTag.h>
 
 
 #pragma mark Protected interface declaration
@@ -102,16 +104,97 @@
 
 - (void)testHTTPBody_ShouldStoreCassetteIdentifier_WhenNonNilPassed {
     
-    [YHVNSURLRequest patch];
+    [YHVNSURLRequest enableHTTPBodyCaptureWithHostsFilter:nil];
     
     NSMutableURLRequest *request = [self.request mutableCopy];
-    NSData *expectedData = self.request.HTTPBody;
+    NSData *expectedData = [@"Yet Another HTTP VCR #2" dataUsingEncoding:NSUTF8StringEncoding];
+    request.HTTPBody = expectedData;
     request.HTTPBody = nil;
     
+    [YHVNSURLRequest disableHTTPBodyCapture];
+    
     XCTAssertNil(request.HTTPBody);
     XCTAssertEqualObjects(request.YHV_HTTPBody, expectedData);
 }
 
+- (void)testHTTPBody_ShouldNotCaptureBody_WhenCaptureDisabled {
+    
+    [YHVNSURLRequest enableHTTPBodyCaptureWithHostsFilter:nil];
+    [YHVNSURLRequest disableHTTPBodyCapture];
+    
+    NSMutableURLRequest *request = [self.request mutableCopy];
+    request.HTTPBody = [@"Yet Another HTTP VCR #2" dataUsingEncoding:NSUTF8StringEncoding];
+    request.HTTPBody = nil;
+    
+    XCTAssertNil(request.YHV_HTTPBody);
+}
+
+- (void)testHTTPBody_ShouldNotCaptureBody_WhenHostRejectedByFilter {
+    
+    [YHVNSURLRequest enableHTTPBodyCaptureWithHostsFilter:^BOOL(NSString *host) {
+        return NO;
+    }];
+    
+    NSMutableURLRequest *request = [self.request mutableCopy];
+    request.HTTPBody = [@"Yet Another HTTP VCR #2" dataUsingEncoding:NSUTF8StringEncoding];
+    request.HTTPBody = nil;
+    
+    [YHVNSURLRequest disableHTTPBodyCapture];
+    
+    XCTAssertNil(request.YHV_HTTPBody);
+}
+
+- (void)testHTTPBodyStream_ShouldCaptureStreamedBody_WhenCaptureEnabled {
+    
+    NSData *expectedData = [@"Yet Another HTTP VCR #2" dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableURLRequest *bodyRequest = [self.request mutableCopy];
+    NSMutableURLRequest *request = [self.request mutableCopy];
+    uint8_t buffer[64];
+    
+    [YHVNSURLRequest enableHTTPBodyCaptureWithHostsFilter:nil];
+    request.HTTPBodyStream = [NSInputStream inputStreamWithData:expectedData];
+    bodyRequest.HTTPBody = expectedData;
+    [YHVNSURLRequest disableHTTPBodyCapture];
+    
+    XCTAssertTrue([request.HTTPBodyStream isKindOfClass:[YHVTeeInputStream class]]);
+    XCTAssertEqualObjects(request.YHV_HTTPBodyDigest, bodyRequest.YHV_HTTPBodyDigest);
+    XCTAssertEqualObjects(request.YHV_HTTPBody, expectedData);
+    
+    [request.HTTPBodyStream open];
+    NSInteger length = [request.HTTPBodyStream read:buffer maxLength:sizeof(buffer)];
+    [request.HTTPBodyStream close];
+    
+    XCTAssertEqualObjects([NSData dataWithBytes:buffer length:(NSUInteger)length], expectedData);
+}
+
+- (void)testHTTPBodyStream_ShouldCaptureStreamedBody_WhenStreamRead {
+    
+    NSData *expectedData = [@"Yet Another HTTP VCR #2" dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableURLRequest *request = [self.request mutableCopy];
+    uint8_t buffer[64];
+    
+    [YHVNSURLRequest enableHTTPBodyCaptureWithHostsFilter:nil];
+    request.HTTPBodyStream = [NSInputStream inputStreamWithData:expectedData];
+    [YHVNSURLRequest disableHTTPBodyCapture];
+    
+    NSURLRequest *requestCopy = [request copy];
+    [request.HTTPBodyStream open];
+    while ([request.HTTPBodyStream read:buffer maxLength:sizeof(buffer)] > 0) {}
+    [request.HTTPBodyStream close];
+    
+    XCTAssertNotNil(requestCopy.YHV_tag.HTTPBodyDigest);
+    XCTAssertEqualObjects(requestCopy.YHV_HTTPBody, expectedData);
+}
+
+- (void)testHTTPBodyStream_ShouldNotWrapStream_WhenCaptureDisabled {
+    
+    NSMutableURLRequest *request = [self.request mutableCopy];
+    
+    request.HTTPBodyStream = [NSInputStream inputStreamWithData:self.request.HTTPBody];
+    
+    XCTAssertFalse([request.HTTPBodyStream isKindOfClass:[YHVTeeInputStream class]]);
+}
+
 - (void)testVCRIgnored_ShouldHaveAdditionalProperty {
     
     XCTAssertTrue([self.request respondsToSelector:@selector(YHV_VCRIgnored)]);
@@ -208,6 +291,205 @@
     XCTAssertEqualObjects(self.request.YHV_cassetteChapterIdentifier, expectedIdentifier);
 }
 
+- (void)testTag_ShouldNotBeCreated_WhenNoValuesStored {
+    
+    self.request.YHV_VCRIgnored = NO;
+    
+    XCTAssertNil(self.request.YHV_tag);
+}
+
+- (void)testTag_ShouldStoreAllValues {
+    
+    NSString *expectedChapterIdentifier = [NSUUID UUID].UUIDString;
+    NSString *expectedCassetteIdentifier = [NSUUID UUID].UUIDString;
+    NSString *expectedIdentifier = [NSUUID UUID].UUIDString;
+    
+    self.request.YHV_cassetteChapterIdentifier = expectedChapterIdentifier;
+    self.request.YHV_cassetteIdentifier = expectedCassetteIdentifier;
+    self.request.YHV_identifier = expectedIdentifier;
+    self.request.YHV_usingNSURLSession = YES;
+    self.request.YHV_VCRIgnored = YES;
+    
+    XCTAssertEqualObjects(self.request.YHV_tag.cassetteChapterIdentifier, expectedChapterIdentifier);
+    XCTAssertEqualObjects(self.request.YHV_tag.cassetteIdentifier, expectedCassetteIdentifier);
+    XCTAssertEqualObjects(self.request.YHV_tag.identifier, expectedIdentifier);
+    XCTAssertTrue(self.request.YHV_tag.usingNSURLSession);
+    XCTAssertTrue(self.request.YHV_tag.VCRIgnored);
+}
+
+- (void)testTag_ShouldBeAvailable_WhenRequestCopied {
+    
+    NSString *expectedIdentifier = [NSUUID UUID].UUIDString;
+    
+    self.request.YHV_cassetteIdentifier = expectedIdentifier;
+    self.request.YHV_usingNSURLSession = YES;
+    
+    NSURLRequest *request = [self.request copy];
+    NSMutableURLRequest *mutableRequest = [self.request mutableCopy];
+    
+    XCTAssertEqualObjects(request.YHV_cassetteIdentifier, expectedIdentifier);
+    XCTAssertEqualObjects(mutableRequest.YHV_cassetteIdentifier, expectedIdentifier);
+    XCTAssertTrue(request.YHV_usingNSURLSession);
+    XCTAssertTrue(mutableRequest.YHV_usingNSURLSession);
+}
+
+- (void)testTag_ShouldNotChangeOriginalRequest_WhenCopyTagged {
+    
+    NSString *expectedContext = [NSUUID UUID].UUIDString;
+    
+    self.request.YHV_context = expectedContext;
+    
+    NSMutableURLRequest *requestCopy1 = [self.request mutableCopy];
+    NSMutableURLRequest *requestCopy2 = [self.request mutableCopy];
+    requestCopy1.YHV_cassetteChapterIdentifier = [NSUUID UUID].UUIDString;
+    requestCopy1.YHV_cassetteIdentifier = [NSUUID UUID].UUIDString;
+    requestCopy1.YHV_identifier = [NSUUID UUID].UUIDString;
+    requestCopy1.YHV_VCRIgnored = YES;
+    
+    XCTAssertNil(self.request.YHV_cassetteChapterIdentifier);
+    XCTAssertNil(self.request.YHV_cassetteIdentifier);
+    XCTAssertNil(self.request.YHV_identifier);
+    XCTAssertFalse(self.request.YHV_VCRIgnored);
+    XCTAssertNil(requestCopy2.YHV_cassetteChapterIdentifier);
+    XCTAssertNil(requestCopy2.YHV_identifier);
+    XCTAssertEqualObjects(requestCopy1.YHV_context, expectedContext);
+    XCTAssertEqualObjects(requestCopy2.YHV_context, expectedContext);
+}
+
+- (void)testTag_ShouldRestoreValues_WhenArchived {
+    
+    self.request.YHV_cassetteChapterIdentifier = [NSUUID UUID].UUIDString;
+    self.request.YHV_cassetteIdentifier = [NSUUID UUID].UUIDString;
+    self.request.YHV_identifier = [NSUUID UUID].UUIDString;
+    self.request.YHV_VCRIgnored = YES;
+    
+    YHVRequestTag *tag = [NSKeyedUnarchiver unarchiveObjectWithData:[NSKeyedArchiver archivedDataWithRootObject:self.request.YHV_tag]];
+    
+    XCTAssertEqualObjects(tag.cassetteChapterIdentifier, self.request.YHV_cassetteChapterIdentifier);
+    XCTAssertEqualObjects(tag.cassetteIdentifier, self.request.YHV_cassetteIdentifier);
+    XCTAssertEqualObjects(tag.identifier, self.request.YHV_identifier);
+    XCTAssertFalse(tag.usingNSURLSession);
+    XCTAssertTrue(tag.VCRIgnored);
+}
+
+
+#pragma mark - Tests :: Performance
+
+- (void)testTagPerformance_ShouldReadValuesWithSinglePropertyLookup {
+    
+    NSURLRequest *request = [self.request copy];
+    request.YHV_cassetteChapterIdentifier = [NSUUID UUID].UUIDString;
+    request.YHV_cassetteIdentifier = [NSUUID UUID].UUIDString;
+    request.YHV_identifier = [NSUUID UUID].UUIDString;
+    request.YHV_usingNSURLSession = YES;
+    
+    // Imitate set of checks which is done by recording and playback hooks for each URL loading system callback.
+    [self measureBlock:^{
+        NSUInteger matchedRequests = 0;
+        
+        for (NSUInteger callbackIdx = 0; callbackIdx < 100000; callbackIdx++) {
+            YHVRequestTag *tag = request.YHV_tag;
+            
+            if (tag.cassetteIdentifier && tag.usingNSURLSession && !tag.VCRIgnored && tag.cassetteChapterIdentifier && tag.identifier) {
+                matchedRequests++;
+            }
+        }
+        
+        XCTAssertEqual(matchedRequests, 100000);
+    }];
+}
+
+- (void)testAccessorsPerformance_ShouldReadValuesWithPropertyLookupPerValue {
+    
+    NSURLRequest *request = [self.request copy];
+    request.YHV_cassetteChapterIdentifier = [NSUUID UUID].UUIDString;
+    request.YHV_cassetteIdentifier = [NSUUID UUID].UUIDString;
+    request.YHV_identifier = [NSUUID UUID].UUIDString;
+    request.YHV_usingNSURLSession = YES;
+    
+    [self measureBlock:^{
+        NSUInteger matchedRequests = 0;
+        
+        for (NSUInteger callbackIdx = 0; callbackIdx < 100000; callbackIdx++) {
+            if (request.YHV_cassetteIdentifier && request.YHV_usingNSURLSession && !request.YHV_VCRIgnored &&
+                request.YHV_cassetteChapterIdentifier && request.YHV_identifier) {
+                
+                matchedRequests++;
+            }
+        }
+        
+        XCTAssertEqual(matchedRequests, 100000);
+    }];
+}
+
+- (void)testPropertiesPerformance_ShouldReadValuesStoredAsSeparateProperties {
+    
+    NSMutableURLRequest *request = [self.request mutableCopy];
+    [NSURLProtocol setProperty:[NSUUID UUID].UUIDString forKey:@"YHVCassetteChapterIdentifier" inRequest:request];
+    [NSURLProtocol setProperty:[NSUUID UUID].UUIDString forKey:@"YHVCassetteIdentifier" inRequest:request];
+    [NSURLProtocol setProperty:[NSUUID UUID].UUIDString forKey:@"YHVIdentifier" inRequest:request];
+    [NSURLProtocol setProperty:@YES forKey:@"YHVUsingNSURLSession" inRequest:request];
+    [NSURLProtocol setProperty:@NO forKey:@"YHVVCRIgnored" inRequest:request];
+    
+    // Baseline for tag: same values stored as separate protocol properties, like it has been done before tag introduction.
+    [self measureBlock:^{
+        NSUInteger matchedRequests = 0;
+        
+        for (NSUInteger callbackIdx = 0; callbackIdx < 100000; callbackIdx++) {
+            if ([NSURLProtocol propertyForKey:@"YHVCassetteIdentifier" inRequest:request] &&
+                ((NSNumber *)[NSURLProtocol propertyForKey:@"YHVUsingNSURLSession" inRequest:request]).boolValue &&
+                !((NSNumber *)[NSURLProtocol propertyForKey:@"YHVVCRIgnored" inRequest:request]).boolValue &&
+                [NSURLProtocol propertyForKey:@"YHVCassetteChapterIdentifier" inRequest:request] &&
+                [NSURLProtocol propertyForKey:@"YHVIdentifier" inRequest:request]) {
+                
+                matchedRequests++;
+            }
+        }
+        
+        XCTAssertEqual(matchedRequests, 100000);
+    }];
+}
+
+- (void)testTagPerformance_ShouldSetValuesWithTagCopyPerValue {
+    
+    NSString *chapterIdentifier = [NSUUID UUID].UUIDString;
+    NSString *cassetteIdentifier = [NSUUID UUID].UUIDString;
+    NSString *identifier = [NSUUID UUID].UUIDString;
+    
+    [self measureBlock:^{
+        for (NSUInteger requestIdx = 0; requestIdx < 10000; requestIdx++) {
+            NSMutableURLRequest *request = [self.request mutableCopy];
+            request.YHV_cassetteChapterIdentifier = chapterIdentifier;
+            request.YHV_cassetteIdentifier = cassetteIdentifier;
+            request.YHV_identifier = identifier;
+            request.YHV_usingNSURLSession = YES;
+            request.YHV_VCRIgnored = YES;
+            
+            XCTAssertNotNil(request.YHV_tag);
+        }
+    }];
+}
+
+- (void)testPropertiesPerformance_ShouldSetValuesAsSeparateProperties {
+    
+    NSString *chapterIdentifier = [NSUUID UUID].UUIDString;
+    NSString *cassetteIdentifier = [NSUUID UUID].UUIDString;
+    NSString *identifier = [NSUUID UUID].UUIDString;
+    
+    [self measureBlock:^{
+        for (NSUInteger requestIdx = 0; requestIdx < 10000; requestIdx++) {
+            NSMutableURLRequest *request = [self.request mutableCopy];
+            [NSURLProtocol setProperty:chapterIdentifier forKey:@"YHVCassetteChapterIdentifier" inRequest:request];
+            [NSURLProtocol setProperty:cassetteIdentifier forKey:@"YHVCassetteIdentifier" inRequest:request];
+            [NSURLProtocol setProperty:identifier forKey:@"YHVIdentifier" inRequest:request];
+            [NSURLProtocol setProperty:@YES forKey:@"YHVUsingNSURLSession" inRequest:request];
+            [NSURLProtocol setProperty:@YES forKey:@"YHVVCRIgnored" inRequest:request];
+            
+            XCTAssertNotNil([NSURLProtocol propertyForKey:@"YHVIdentifier" inRequest:request]);
+        }
+    }];
+}
+
 
 #pragma mark - Tests :: Compare
 
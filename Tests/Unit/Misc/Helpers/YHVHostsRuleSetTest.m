@@ -0,0 +1,68 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import <XCTest/XCTest.h>
+#import <YAHTTPVCR/YHVHostsRuleSet.h>
+
+
+@interface YHVHostsRuleSetTest : XCTestCase
+
+
+#pragma mark - Information
+
+@property (nonatomic, strong) YHVHostsRuleSet *ruleSet;
+
+#pragma mark -
+
+
+@end
+
+
+@implementation YHVHostsRuleSetTest
+
+
+#pragma mark - Setup / Tear down
+
+- (void)setUp {
+    
+    [super setUp];
+    
+    self.ruleSet = [YHVHostsRuleSet ruleSetWithHosts:@[@"httpbin.org", @"*.Example.com"]];
+}
+
+
+#pragma mark - Tests :: Matching
+
+- (void)testContainsHost_ShouldReturnYES_WhenHostInList {
+    
+    XCTAssertTrue([self.ruleSet containsHost:@"httpbin.org"]);
+}
+
+- (void)testContainsHost_ShouldReturnYES_WhenHostHasDifferentCase {
+    
+    XCTAssertTrue([self.ruleSet containsHost:@"HTTPBin.org"]);
+}
+
+- (void)testContainsHost_ShouldReturnYES_WhenHostIsSubdomainOfWildcardDomain {
+    
+    XCTAssertTrue([self.ruleSet containsHost:@"api.example.com"]);
+    XCTAssertTrue([self.ruleSet containsHost:@"v1.api.example.com"]);
+}
+
+- (void)testContainsHost_ShouldReturnNO_WhenHostIsWildcardDomainItself {
+    
+    XCTAssertFalse([self.ruleSet containsHost:@"example.com"]);
+}
+
+- (void)testContainsHost_ShouldReturnNO_WhenHostNotInList {
+    
+    XCTAssertFalse([self.ruleSet containsHost:@"api.httpbin.org"]);
+    XCTAssertFalse([self.ruleSet containsHost:@"notexample.com"]);
+    XCTAssertFalse([self.ruleSet containsHost:nil]);
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,97 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import <XCTest/XCTest.h>
+#import <YAHTTPVCR/YHVJSONRedactor.h>
+
+
+@interface YHVJSONRedactorTest : XCTestCase
+
+
+#pragma mark - Misc
+
+/**
+ * @brief  Redact JSON document using specified rules.
+ *
+ * @param json         Reference on JSON document string.
+ * @param replacements Reference on redaction rules.
+ *
+ * @return Redacted JSON document string.
+ */
+- (NSString *)redactedJSON:(NSString *)json withReplacements:(NSDictionary *)replacements;
+
+#pragma mark -
+
+
+@end
+
+
+@implementation YHVJSONRedactorTest
+
+
+#pragma mark - Tests :: Redaction
+
+- (void)testRedactedData_ShouldReplaceAndRemoveTopLevelKeys_WhenKeysMatch {
+    
+    NSString *json = [self redactedJSON:@"{\"field1\":\"value1\",\"field2\":\"value2\",\"field3\":3}"
+                       withReplacements:@{ @"field1": [NSNull null], @"Field2": @"secret" }];
+    
+    XCTAssertEqualObjects(json, @"{\"field2\":\"secret\",\"field3\":3}");
+}
+
+- (void)testRedactedData_ShouldRedactKeysOnAnyDepth_WhenKeyRuleUsed {
+    
+    NSString *json = [self redactedJSON:@"[{\"user\": {\"token\": \"1\", \"name\": \"bob\"}}, {\"token\": \"2\"}]"
+                       withReplacements:@{ @"token": @"secret" }];
+    
+    XCTAssertEqualObjects(json, @"[{\"user\": {\"token\": \"secret\", \"name\": \"bob\"}}, {\"token\": \"secret\"}]");
+}
+
+- (void)testRedactedData_ShouldRedactOnlyNestedKey_WhenKeyPathRuleUsed {
+    
+    NSString *json = [self redactedJSON:@"{\"token\":\"1\",\"user\":{\"token\":\"2\",\"name\":\"bob\"}}"
+                       withReplacements:@{ @"user.token": [NSNull null] }];
+    
+    XCTAssertEqualObjects(json, @"{\"token\":\"1\",\"user\":{\"name\":\"bob\"}}");
+}
+
+- (void)testRedactedData_ShouldKeepFormatting_WhenMembersRemoved {
+    
+    NSString *json = [self redactedJSON:@"{\n  \"b\" : 2,\n  \"a\" : [1, 2],\n  \"c\" : 3\n}"
+                       withReplacements:@{ @"b": [NSNull null], @"c": [NSNull null] }];
+    
+    XCTAssertEqualObjects(json, @"{\n  \"a\" : [1, 2]\n}");
+}
+
+- (void)testRedactedData_ShouldReturnNil_WhenMalformedJSONPassed {
+    
+    YHVJSONRedactor *redactor = [YHVJSONRedactor redactorWithReplacements:@{ @"token": [NSNull null] }];
+    NSData *data = [@"{\"token\":\"1\"" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    XCTAssertNil([redactor redactedDataFromData:data]);
+}
+
+- (void)testRedactedData_ShouldReturnSameData_WhenKeysNotMatch {
+    
+    YHVJSONRedactor *redactor = [YHVJSONRedactor redactorWithReplacements:@{ @"token": [NSNull null] }];
+    NSData *data = [@"{\"name\":\"bob\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    
+    XCTAssertEqual([redactor redactedDataFromData:data], data);
+}
+
+
+#pragma mark - Misc
+
+- (NSString *)redactedJSON:(NSString *)json withReplacements:(NSDictionary *)replacements {
+    
+    YHVJSONRedactor *redactor = [YHVJSONRedactor redactorWithReplacements:replacements];
+    NSData *data = [redactor redactedDataFromData:[json dataUsingEncoding:NSUTF8StringEncoding]];
+    
+    return data ? [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding] : nil;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,208 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import <XCTest/XCTest.h>
+#import <YAHTTPVCR/YHVMatchIndex.h>
+#import <YAHTTPVCR/YAHTTPVCR.h>
+#import <YAHTTPVCR/YHVScene.h>
+
+
+@interface YHVMatchIndexTest : XCTestCase
+
+
+#pragma mark - Information
+
+@property (nonatomic, copy) NSString *cassettePath;
+@property (nonatomic, strong) NSArray<YHVScene *> *scenes;
+@property (nonatomic, strong) NSArray<NSString *> *matchers;
+
+
+#pragma mark - Misc
+
+/**
+ * @brief  Create request scene for chapter.
+ *
+ * @param identifier Unique identifier of chapter for which scene should be created.
+ * @param url        Reference on string with URL which should be used by scene's request.
+ *
+ * @return Request scene.
+ */
+- (YHVScene *)requestSceneForChapterWithIdentifier:(NSString *)identifier withURL:(NSString *)url;
+
+#pragma mark -
+
+
+@end
+
+
+@implementation YHVMatchIndexTest
+
+
+#pragma mark - Setup / Tear down
+
+- (void)setUp {
+    
+    [super setUp];
+    
+    self.cassettePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    self.matchers = @[YHVMatcher.method, YHVMatcher.scheme, YHVMatcher.host, YHVMatcher.port, YHVMatcher.path, YHVMatcher.query];
+    self.scenes = @[
+        [self requestSceneForChapterWithIdentifier:@"chapter-1" withURL:@"https://httpbin.org/get?page=1"],
+        [self requestSceneForChapterWithIdentifier:@"chapter-2" withURL:@"https://httpbin.org/status/200"]
+    ];
+    
+    [[@"[]" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:self.cassettePath atomically:YES];
+}
+
+- (void)tearDown {
+    
+    [NSFileManager.defaultManager removeItemAtPath:[YHVMatchIndex pathForCassetteAtPath:self.cassettePath] error:nil];
+    [NSFileManager.defaultManager removeItemAtPath:self.cassettePath error:nil];
+    
+    [super tearDown];
+}
+
+
+#pragma mark - Tests :: Storage
+
+- (void)testWriteForCassetteAtPath_ShouldStoreIndex_WhenCassetteExists {
+    
+    YHVMatchIndex *index = [YHVMatchIndex indexWithRequestScenes:self.scenes reusingIndex:nil];
+    
+    XCTAssertTrue([index writeForCassetteAtPath:self.cassettePath]);
+    XCTAssertTrue([NSFileManager.defaultManager fileExistsAtPath:[YHVMatchIndex pathForCassetteAtPath:self.cassettePath]]);
+    XCTAssertEqualObjects([YHVMatchIndex indexForCassetteAtPath:self.cassettePath].chapterIdentifiers, index.chapterIdentifiers);
+    XCTAssertEqualObjects(index.chapterIdentifiers, ([NSSet setWithObjects:@"chapter-1", @"chapter-2", nil]));
+}
+
+- (void)testWriteForCassetteAtPath_ShouldNotStoreIndex_WhenCassetteNotExists {
+    
+    YHVMatchIndex *index = [YHVMatchIndex indexWithRequestScenes:self.scenes reusingIndex:nil];
+    
+    [NSFileManager.defaultManager removeItemAtPath:self.cassettePath error:nil];
+    
+    XCTAssertFalse([index writeForCassetteAtPath:self.cassettePath]);
+    XCTAssertNil([YHVMatchIndex indexForCassetteAtPath:self.cassettePath]);
+}
+
+- (void)testIndexForCassetteAtPath_ShouldReturnNil_WhenCassetteSizeChanged {
+    
+    NSDate *modificationDate = [NSDate dateWithTimeIntervalSinceNow:-60.f];
+    NSDictionary *attributes = @{ NSFileModificationDate: modificationDate };
+    
+    [NSFileManager.defaultManager setAttributes:attributes ofItemAtPath:self.cassettePath error:nil];
+    [[YHVMatchIndex indexWithRequestScenes:self.scenes reusingIndex:nil] writeForCassetteAtPath:self.cassettePath];
+    XCTAssertNotNil([YHVMatchIndex indexForCassetteAtPath:self.cassettePath]);
+    
+    [[@"[{}]" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:self.cassettePath atomically:YES];
+    [NSFileManager.defaultManager setAttributes:attributes ofItemAtPath:self.cassettePath error:nil];
+    
+    XCTAssertNil([YHVMatchIndex indexForCassetteAtPath:self.cassettePath]);
+}
+
+- (void)testIndexForCassetteAtPath_ShouldReturnNil_WhenCassetteModificationDateChanged {
+    
+    [[YHVMatchIndex indexWithRequestScenes:self.scenes reusingIndex:nil] writeForCassetteAtPath:self.cassettePath];
+    XCTAssertNotNil([YHVMatchIndex indexForCassetteAtPath:self.cassettePath]);
+    
+    [NSFileManager.defaultManager setAttributes:@{ NSFileModificationDate: [NSDate dateWithTimeIntervalSinceNow:-60.f] }
+                                   ofItemAtPath:self.cassettePath
+                                          error:nil];
+    
+    XCTAssertNil([YHVMatchIndex indexForCassetteAtPath:self.cassettePath]);
+}
+
+- (void)testIndexWithRequestScenes_ShouldReuseFingerprints_WhenPreviousIndexPassed {
+    
+    YHVMatchIndex *previousIndex = [YHVMatchIndex indexWithRequestScenes:@[self.scenes.firstObject] reusingIndex:nil];
+    YHVScene *scene = [YHVScene sceneWithIdentifier:@"chapter-1" type:YHVRequestScene data:nil];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/get?page=1"]];
+    NSDictionary *fingerprint = [YHVMatchIndex fingerprintForRequest:request withMatchers:self.matchers];
+    
+    YHVMatchIndex *index = [YHVMatchIndex indexWithRequestScenes:@[scene, self.scenes.lastObject] reusingIndex:previousIndex];
+    
+    XCTAssertEqual(index.chapterIdentifiers.count, 2);
+    XCTAssertEqual([index matchFingerprint:fingerprint toChapterWithIdentifier:@"chapter-1" withMatchers:self.matchers],
+                   YHVMatchIndexMatch);
+}
+
+
+#pragma mark - Tests :: Matching
+
+- (void)testMatchFingerprint_ShouldReturnMatch_WhenAllBundledMatchersFieldsEqual {
+    
+    YHVMatchIndex *index = [YHVMatchIndex indexWithRequestScenes:self.scenes reusingIndex:nil];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"HTTPS://HTTPBin.org/get?page=1"]];
+    NSDictionary *fingerprint = [YHVMatchIndex fingerprintForRequest:request withMatchers:self.matchers];
+    
+    XCTAssertEqual([index matchFingerprint:fingerprint toChapterWithIdentifier:@"chapter-1" withMatchers:self.matchers],
+                   YHVMatchIndexMatch);
+}
+
+- (void)testMatchFingerprint_ShouldReturnMismatch_WhenPathDifferent {
+    
+    YHVMatchIndex *index = [YHVMatchIndex indexWithRequestScenes:self.scenes reusingIndex:nil];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/get?page=1"]];
+    NSDictionary *fingerprint = [YHVMatchIndex fingerprintForRequest:request withMatchers:self.matchers];
+    
+    XCTAssertEqual([index matchFingerprint:fingerprint toChapterWithIdentifier:@"chapter-2" withMatchers:self.matchers],
+                   YHVMatchIndexMismatch);
+}
+
+- (void)testMatchFingerprint_ShouldReturnMismatch_WhenQueryDifferent {
+    
+    YHVMatchIndex *index = [YHVMatchIndex indexWithRequestScenes:self.scenes reusingIndex:nil];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/get?page=2"]];
+    NSDictionary *fingerprint = [YHVMatchIndex fingerprintForRequest:request withMatchers:self.matchers];
+    
+    XCTAssertEqual([index matchFingerprint:fingerprint toChapterWithIdentifier:@"chapter-1" withMatchers:self.matchers],
+                   YHVMatchIndexMismatch);
+}
+
+- (void)testMatchFingerprint_ShouldIgnoreField_WhenMatcherNotUsed {
+    
+    YHVMatchIndex *index = [YHVMatchIndex indexWithRequestScenes:self.scenes reusingIndex:nil];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/get?page=2"]];
+    NSArray<NSString *> *matchers = @[YHVMatcher.method, YHVMatcher.host, YHVMatcher.path];
+    NSDictionary *fingerprint = [YHVMatchIndex fingerprintForRequest:request withMatchers:matchers];
+    
+    XCTAssertEqual([index matchFingerprint:fingerprint toChapterWithIdentifier:@"chapter-1" withMatchers:matchers],
+                   YHVMatchIndexMatch);
+}
+
+- (void)testMatchFingerprint_ShouldReturnUndecided_WhenHeadersMatcherUsed {
+    
+    YHVMatchIndex *index = [YHVMatchIndex indexWithRequestScenes:self.scenes reusingIndex:nil];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/get?page=1"]];
+    NSArray<NSString *> *matchers = [self.matchers arrayByAddingObject:YHVMatcher.headers];
+    NSDictionary *fingerprint = [YHVMatchIndex fingerprintForRequest:request withMatchers:matchers];
+    
+    XCTAssertEqual([index matchFingerprint:fingerprint toChapterWithIdentifier:@"chapter-1" withMatchers:matchers],
+                   YHVMatchIndexUndecided);
+}
+
+- (void)testMatchFingerprint_ShouldReturnUndecided_WhenChapterNotIndexed {
+    
+    YHVMatchIndex *index = [YHVMatchIndex indexWithRequestScenes:self.scenes reusingIndex:nil];
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/get?page=1"]];
+    NSDictionary *fingerprint = [YHVMatchIndex fingerprintForRequest:request withMatchers:self.matchers];
+    
+    XCTAssertEqual([index matchFingerprint:fingerprint toChapterWithIdentifier:@"chapter-3" withMatchers:self.matchers],
+                   YHVMatchIndexUndecided);
+}
+
+
+#pragma mark - Misc
+
+- (YHVScene *)requestSceneForChapterWithIdentifier:(NSString *)identifier withURL:(NSString *)url {
+    
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:url]];
+    
+    return [YHVScene sceneWithIdentifier:identifier type:YHVRequestScene data:request];
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,64 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import <XCTest/XCTest.h>
+#import <YAHTTPVCR/YHVReplacementRuleSet.h>
+
+
+@interface YHVReplacementRuleSetTest : XCTestCase
+
+
+#pragma mark - Information
+
+@property (nonatomic, strong) YHVReplacementRuleSet *ruleSet;
+@property (nonatomic, strong) NSMutableDictionary *dictionary;
+
+#pragma mark -
+
+
+@end
+
+
+@implementation YHVReplacementRuleSetTest
+
+
+#pragma mark - Setup / Tear down
+
+- (void)setUp {
+    
+    [super setUp];
+    
+    self.ruleSet = [YHVReplacementRuleSet ruleSetWithReplacements:@{ @"Authorization": @"secret", @"token": [NSNull null] }];
+    self.dictionary = [@{ @"authorization": @"Bearer 1234", @"TOKEN": @"5678", @"Accept": @"*/*" } mutableCopy];
+}
+
+
+#pragma mark - Tests :: Filtering
+
+- (void)testApplyToDictionary_ShouldReplaceValue_WhenKeyHasDifferentCase {
+    
+    [self.ruleSet applyToDictionary:self.dictionary];
+    
+    XCTAssertEqualObjects(self.dictionary[@"authorization"], @"secret");
+}
+
+- (void)testApplyToDictionary_ShouldRemoveKey_WhenNSNullReplacementUsed {
+    
+    [self.ruleSet applyToDictionary:self.dictionary];
+    
+    XCTAssertNil(self.dictionary[@"TOKEN"]);
+}
+
+- (void)testApplyToDictionary_ShouldNotChangeKey_WhenRuleNotSet {
+    
+    [self.ruleSet applyToDictionary:self.dictionary];
+    
+    XCTAssertEqualObjects(self.dictionary[@"Accept"], @"*/*");
+    XCTAssertEqual(self.dictionary.count, 2);
+}
+
+#pragma mark -
+
+
+@end
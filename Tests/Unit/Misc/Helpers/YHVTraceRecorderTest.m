@@ -0,0 +1,128 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import <XCTest/XCTest.h>
+#import <YAHTTPVCR/YHVTraceRecorder.h>
+
+
+@interface YHVTraceRecorderTest : XCTestCase
+
+
+#pragma mark - Information
+
+@property (nonatomic, copy) NSString *tracePath;
+
+
+#pragma mark - Misc
+
+/**
+ * @brief  Load events which has been written into trace file.
+ *
+ * @return List of trace events.
+ */
+- (NSArray<NSDictionary *> *)writtenEvents;
+
+#pragma mark -
+
+
+@end
+
+
+@implementation YHVTraceRecorderTest
+
+
+#pragma mark - Setup / Tear down
+
+- (void)setUp {
+    
+    [super setUp];
+    
+    self.tracePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID].UUIDString
+                                                                             stringByAppendingPathExtension:@"json"]];
+}
+
+- (void)tearDown {
+    
+    [NSFileManager.defaultManager removeItemAtPath:self.tracePath error:nil];
+    
+    [super tearDown];
+}
+
+
+#pragma mark - Tests :: Events
+
+- (void)testAppendToFile_ShouldWriteCompleteEvent_WhenSpanEnded {
+    
+    YHVTraceRecorder *recorder = [YHVTraceRecorder recorderWithName:@"cassette"];
+    [recorder setName:@"GET https://httpbin.org/get" forTrack:@"chapter"];
+    [recorder beginSpanWithName:@"response" category:@"playback" onTrack:@"chapter"];
+    [recorder endSpanWithName:@"response" onTrack:@"chapter" arguments:@{ @"status": @200 }];
+    
+    XCTAssertTrue([recorder appendToFileAtPath:self.tracePath]);
+    
+    NSArray<NSDictionary *> *events = [self writtenEvents];
+    NSDictionary *span = [events filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"ph == 'X'"]].firstObject;
+    NSDictionary *track = [events filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"name == 'thread_name'"]].firstObject;
+    XCTAssertEqual(events.count, 3);
+    XCTAssertEqualObjects(span[@"name"], @"response");
+    XCTAssertEqualObjects(span[@"cat"], @"playback");
+    XCTAssertEqualObjects(span[@"args"][@"status"], @200);
+    XCTAssertGreaterThanOrEqual([span[@"dur"] doubleValue], 0.f);
+    XCTAssertEqualObjects(span[@"tid"], track[@"tid"]);
+    XCTAssertEqualObjects(track[@"args"][@"name"], @"GET https://httpbin.org/get");
+}
+
+- (void)testAppendToFile_ShouldNotWriteSpan_WhenSpanNotStarted {
+    
+    YHVTraceRecorder *recorder = [YHVTraceRecorder recorderWithName:@"cassette"];
+    [recorder endSpanWithName:@"response" onTrack:@"chapter" arguments:nil];
+    [recorder markEventWithName:@"blocked" category:@"playback" onTrack:@"chapter" arguments:@{ @"reason": @"no client" }];
+    
+    XCTAssertTrue([recorder appendToFileAtPath:self.tracePath]);
+    
+    NSArray<NSDictionary *> *events = [self writtenEvents];
+    XCTAssertEqual([events filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"ph == 'X'"]].count, 0);
+    XCTAssertEqual([events filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"ph == 'i'"]].count, 1);
+}
+
+- (void)testAppendToFile_ShouldAppendEventsFromDifferentRecorders_WhenSamePathUsed {
+    
+    YHVTraceRecorder *recorder1 = [YHVTraceRecorder recorderWithName:@"cassette1"];
+    YHVTraceRecorder *recorder2 = [YHVTraceRecorder recorderWithName:@"cassette2"];
+    [recorder1 markEventWithName:@"closing" category:@"record" onTrack:@"chapter" arguments:nil];
+    [recorder2 markEventWithName:@"closing" category:@"record" onTrack:@"chapter" arguments:nil];
+    
+    XCTAssertTrue([recorder1 appendToFileAtPath:self.tracePath]);
+    XCTAssertTrue([recorder2 appendToFileAtPath:self.tracePath]);
+    // Already written events shouldn't be written twice.
+    XCTAssertTrue([recorder1 appendToFileAtPath:self.tracePath]);
+    
+    NSArray<NSDictionary *> *events = [self writtenEvents];
+    NSArray *instantEvents = [events filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"ph == 'i'"]];
+    XCTAssertEqual(events.count, 4);
+    XCTAssertEqual(instantEvents.count, 2);
+    XCTAssertNotEqualObjects(instantEvents.firstObject[@"pid"], instantEvents.lastObject[@"pid"]);
+}
+
+
+#pragma mark - Misc
+
+- (NSArray<NSDictionary *> *)writtenEvents {
+    
+    NSString *content = [NSString stringWithContentsOfFile:self.tracePath encoding:NSUTF8StringEncoding error:nil];
+    
+    // Trace file doesn't have closing bracket, so events can be appended to it.
+    if ([content hasSuffix:@",\n"]) {
+        content = [[content substringToIndex:content.length - 2] stringByAppendingString:@"]"];
+    }
+    
+    NSData *data = [content dataUsingEncoding:NSUTF8StringEncoding];
+    
+    return data ? [NSJSONSerialization JSONObjectWithData:data options:(NSJSONReadingOptions)0 error:nil] : nil;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,128 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import <XCTest/XCTest.h>
+#import <YAHTTPVCR/YHVURLRewriter.h>
+
+
+@interface YHVURLRewriterTest : XCTestCase
+
+
+#pragma mark - Information
+
+@property (nonatomic, strong) NSURLRequest *request;
+
+#pragma mark -
+
+
+@end
+
+
+@implementation YHVURLRewriterTest
+
+
+#pragma mark - Setup / Tear down
+
+- (void)setUp {
+    
+    [super setUp];
+    
+    self.request = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://httpbin.org/user/bob?token=1234&page=2#top"]];
+}
+
+
+#pragma mark - Tests :: Rewrite
+
+- (void)testRewrittenURL_ShouldReplaceQueryInPlace_WhenQueryParametersFiltered {
+    
+    YHVURLRewriter *rewriter = [YHVURLRewriter rewriterWithPathFilter:nil
+                                                queryParametersFilter:^(NSURLRequest *request, NSMutableDictionary *query) {
+        [query removeObjectForKey:@"token"];
+    } memoize:NO];
+    
+    NSURL *url = [rewriter rewrittenURL:self.request.URL forRequest:self.request];
+    
+    XCTAssertEqualObjects(url.absoluteString, @"https://httpbin.org/user/bob?page=2#top");
+}
+
+- (void)testRewrittenURL_ShouldRemoveQuery_WhenAllQueryParametersFiltered {
+    
+    YHVURLRewriter *rewriter = [YHVURLRewriter rewriterWithPathFilter:nil
+                                                queryParametersFilter:^(NSURLRequest *request, NSMutableDictionary *query) {
+        [query removeAllObjects];
+    } memoize:NO];
+    
+    NSURL *url = [rewriter rewrittenURL:self.request.URL forRequest:self.request];
+    
+    XCTAssertNil(url.query);
+    XCTAssertEqualObjects(url.path, @"/user/bob");
+}
+
+- (void)testRewrittenURL_ShouldUsePathFromFilter_WhenPathFilterSet {
+    
+    YHVURLRewriter *rewriter = [YHVURLRewriter rewriterWithPathFilter:^NSString *(NSURLRequest *request) {
+        return [request.URL.path stringByReplacingOccurrencesOfString:@"bob" withString:@"alice"];
+    } queryParametersFilter:nil memoize:NO];
+    
+    NSURL *url = [rewriter rewrittenURL:self.request.URL forRequest:self.request];
+    
+    XCTAssertEqualObjects(url.absoluteString, @"https://httpbin.org/user/alice?token=1234&page=2#top");
+}
+
+- (void)testRewrittenURL_ShouldPassSameRequestToFilters_WhenURLDifferentFromRequestURL {
+    
+    NSURL *redirectURL = [NSURL URLWithString:@"https://httpbin.org/user/alice?token=5678"];
+    __block NSURLRequest *pathFilterRequest = nil;
+    __block NSURLRequest *queryFilterRequest = nil;
+    YHVURLRewriter *rewriter = [YHVURLRewriter rewriterWithPathFilter:^NSString *(NSURLRequest *request) {
+        pathFilterRequest = request;
+        
+        return request.URL.path;
+    } queryParametersFilter:^(NSURLRequest *request, NSMutableDictionary *query) {
+        queryFilterRequest = request;
+        [query removeObjectForKey:@"token"];
+    } memoize:NO];
+    
+    NSURL *url = [rewriter rewrittenURL:redirectURL forRequest:self.request];
+    
+    XCTAssertEqualObjects(url.absoluteString, @"https://httpbin.org/user/alice");
+    XCTAssertEqualObjects(pathFilterRequest.URL, redirectURL);
+    XCTAssertEqual(queryFilterRequest, pathFilterRequest);
+}
+
+- (void)testRewrittenURL_ShouldCallFiltersOnce_WhenSameURLRewrittenWithMemoization {
+    
+    __block NSUInteger pathFilterCallsCount = 0;
+    YHVURLRewriter *rewriter = [YHVURLRewriter rewriterWithPathFilter:^NSString *(NSURLRequest *request) {
+        pathFilterCallsCount++;
+        
+        return request.URL.path;
+    } queryParametersFilter:nil memoize:YES];
+    
+    NSURL *url1 = [rewriter rewrittenURL:self.request.URL forRequest:self.request];
+    NSURL *url2 = [rewriter rewrittenURL:self.request.URL forRequest:self.request];
+    
+    XCTAssertEqual(pathFilterCallsCount, 1);
+    XCTAssertEqualObjects(url1, url2);
+}
+
+- (void)testRewrittenURL_ShouldCallFiltersEachTime_WhenMemoizationDisabled {
+    
+    __block NSUInteger pathFilterCallsCount = 0;
+    YHVURLRewriter *rewriter = [YHVURLRewriter rewriterWithPathFilter:^NSString *(NSURLRequest *request) {
+        pathFilterCallsCount++;
+        
+        return request.URL.path;
+    } queryParametersFilter:nil memoize:NO];
+    
+    [rewriter rewrittenURL:self.request.URL forRequest:self.request];
+    [rewriter rewrittenURL:self.request.URL forRequest:self.request];
+    
+    XCTAssertEqual(pathFilterCallsCount, 2);
+}
+
+#pragma mark -
+
+
+@end
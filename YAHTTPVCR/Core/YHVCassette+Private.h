@@ -49,6 +49,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)save;
 
+/**
+ * @brief      Append cassette's playback and recording timeline to configured trace file.
+ * @discussion Nothing will be written if \c traceFilePath not configured.
+ *
+ * @since 1.6.0
+ */
+- (void)saveTrace;
+
 
 #pragma mark - Playback
 
@@ -206,7 +214,8 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)recordResponse:(NSURLResponse *)response forRequest:(NSURLRequest *)request;
 
 /**
- * @brief  Record remote server \c response body for specified \c request.
+ * @brief      Record remote server \c response body for specified \c request.
+ * @discussion Received body chunks accumulated till \c request completion and filtered at once before they will be stored on cassette.
  *
  * @param data    Reference on response body which has been requested by original \a NSURLRequest.
  * @param request Reference on request which received this response body.
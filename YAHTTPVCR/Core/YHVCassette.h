@@ -3,7 +3,7 @@
 
 #pragma mark Class forward
 
-@class YHVConfiguration;
+@class YHVCassetteStatistics, YHVConfiguration;
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -57,9 +57,18 @@ NS_ASSUME_NONNULL_BEGIN
  * @brief      Stores list of all recorded so far responses.
  * @discussion List of responses is same order as they has been received. Each entry is list where first element is \a NSURLResponse and second
  *             is \a NSData (actual service response) or \a NSError (in case if request processing error has been recorded).
+ *             Response body composed from recorded chunks w/o copying, so \a NSData may be non-contiguous.
  */
 @property (nonatomic, readonly, strong) NSArray<NSArray *> *responses;
 
+/**
+ * @brief      Stores snapshot of cassette's operation statistics.
+ * @discussion Each call return new snapshot with values collected since cassette has been inserted.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, readonly, strong) YHVCassetteStatistics *statistics;
+
 #pragma mark -
 
 
@@ -4,16 +4,96 @@
  */
 #import "YHVCassette+Private.h"
 #import "YHVConfiguration+Private.h"
+#import "YHVCassetteStatistics+Private.h"
 #import "NSURLRequest+YHVPlayer.h"
 #import "NSDictionary+YHVNSURL.h"
 #import "YHVRequestMatchers.h"
+#import "YHVMatchIndex.h"
+#import "YHVTraceRecorder.h"
 #import "YHVNSURLProtocol.h"
+#import "YHVRequestTag.h"
+#import "YHVBase64.h"
 #import "YHVScene.h"
+#import <stdatomic.h>
 
 
-#pragma mark Protected interface declaration
+#pragma mark Functions
 
-@interface YHVCassette ()
+/**
+ * @brief  Compose scene's name for cassette's timeline.
+ *
+ * @param type One of \b YHVSceneType fields.
+ *
+ * @return Name which is used for scene's span in trace.
+ *
+ * @since 1.6.0
+ */
+static NSString * YHVSceneTypeName(YHVSceneType type) {
+    
+    static NSArray<NSString *> *names;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        names = @[@"request", @"response", @"data", @"error", @"closing"];
+    });
+    
+    return type < names.count ? names[type] : @"unknown";
+}
+
+/**
+ * @brief  Compose chapter's track name for cassette's timeline.
+ *
+ * @param request    Reference on chapter's request.
+ * @param identifier Unique chapter identifier.
+ *
+ * @return Name which is used for chapter's track in trace.
+ *
+ * @since 1.6.0
+ */
+static NSString * YHVTraceTrackName(NSURLRequest *request, NSString *identifier) {
+    
+    if (![request isKindOfClass:[NSURLRequest class]] || !request.URL) {
+        return identifier;
+    }
+    
+    return [NSString stringWithFormat:@"%@ %@ (%@)", request.HTTPMethod ?: @"GET", request.URL.absoluteString,
+            [identifier substringToIndex:MIN(identifier.length, (NSUInteger)8)]];
+}
+
+
+#pragma mark - Protected interface declaration
+
+@interface YHVCassette () {
+    
+    /**
+     * @brief  Stores number of chapters for which closing or error scene has been played or recorded.
+     *
+     * @since 1.6.0
+     */
+    atomic_ulong _playedChaptersCount;
+    
+    /**
+     * @brief  Stores number of request scenes on cassette's tape.
+     *
+     * @since 1.6.0
+     */
+    atomic_ulong _requestScenesCount;
+    
+    /**
+     * @brief      Stores cassette's operation counters.
+     * @discussion Counters modified only on \c resourceAccessQueue.
+     *
+     * @since 1.6.0
+     */
+    YHVCassetteCounters _counters;
+    
+    /**
+     * @brief      Stores number of evaluations for each of configured matchers.
+     * @discussion Values stored in same order as matchers in configuration and modified only on \c resourceAccessQueue.
+     *
+     * @since 1.6.0
+     */
+    NSUInteger *_matcherEvaluations;
+}
 
 
 #pragma mark - Information
@@ -28,6 +108,66 @@
  */
 @property (nonatomic, strong) NSMutableArray<NSString *> *completedChaptersIdentifier;
 
+/**
+ * @brief      Stores reference on dictionary which maps chapter identifier to number of bytes which already has been delivered from data
+ *             scene which currently played with throttling.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *throttledDataOffsets;
+
+/**
+ * @brief      Stores reference on dictionary which maps chapter identifier to response body which has been received so far.
+ * @discussion Response body filtered and stored on cassette only when request completes.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableData *> *recordedDataBuffers;
+
+/**
+ * @brief  Stores reference on dictionary which maps chapter identifier to handle of file into which received response body is written.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSFileHandle *> *recordedDataFiles;
+
+/**
+ * @brief  Stores reference on dictionary which maps chapter identifier to path of file into which received response body is written.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSString *> *recordedDataPaths;
+
+/**
+ * @brief      Stores reference on path to directory where cassette store large response bodies.
+ * @discussion Directory will be removed along with cassette.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, copy) NSString *temporaryDirectoryPath;
+
+/**
+ * @brief  Stores reference on list of chapter identifiers for which initial response body latency already has been applied.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableSet<NSString *> *latencyAppliedChapterIdentifiers;
+
+/**
+ * @brief  Stores reference on dictionary which maps chapter identifier to time when chapter playback has been started.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *chapterPlaybackStartDates;
+
+/**
+ * @brief      Stores reference on recorder which collect cassette's playback and recording timeline.
+ * @discussion Recorder created only if \c traceFilePath has been configured.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, nullable, strong) YHVTraceRecorder *traceRecorder;
+
 /**
  * @brief  Stores reference on list of chatpter identifiers for which request has been initiated by \a NSURLConnection.
  *
@@ -59,10 +199,147 @@
 @property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
 
 /**
- * @brief  Stores reference on set of recorded scenes (request and responses) which should be played on VCR.
+ * @brief      Stores reference on set of scenes (request and responses) which has been loaded from cassette and should be played on VCR.
+ * @discussion Scenes recorded during cassette usage stored in \c recordedScenes and placed on tape only when cassette's content composed.
  */
 @property (nonatomic, strong) NSMutableArray<YHVScene *> *scenes;
 
+/**
+ * @brief      Stores reference on list of scenes which has been recorded on cassette.
+ * @discussion Scenes only appended to the list. Scenes which has been removed from chapter replaced with \a NSNull, so indices
+ *             stored in \c recordedChapterSceneIndices stay valid.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableArray *recordedScenes;
+
+/**
+ * @brief      Stores reference on list of \c scenes indices before which corresponding \c recordedScenes should be placed on tape.
+ * @discussion Recorded scene placed before first scene which wasn't played at the moment of recording. Play head only moves forward,
+ *             so indices stored in ascending order.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *recordedScenesTapeIndices;
+
+/**
+ * @brief      Stores reference on dictionary which maps recorded chapter identifier to indices of it's scenes in \c recordedScenes.
+ * @discussion Indices stored in same order as chapter's scenes in \c chapterScenes.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<NSNumber *> *> *recordedChapterSceneIndices;
+
+/**
+ * @brief      Stores reference on dictionary which maps chapter identifier to list of it's scenes.
+ * @discussion Scenes stored in same order as they appear in \c scenes list. Index allow to find chapter's scenes w/o iteration over
+ *             whole cassette's tape.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<YHVScene *> *> *chapterScenes;
+
+/**
+ * @brief      Stores reference on list of request scenes.
+ * @discussion Scenes stored in same order as they has been loaded or recorded.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableArray<YHVScene *> *requestScenes;
+
+/**
+ * @brief      Stores reference on list of response scenes.
+ * @discussion Scenes stored in same order as they has been loaded or recorded.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableArray<YHVScene *> *responseScenes;
+
+/**
+ * @brief  Stores reference on dictionary which maps chapter identifier to it's entry in \c responses list.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSArray *> *responseEntries;
+
+/**
+ * @brief      Stores reference on list of requests which has been composed for \c requests.
+ * @discussion List reset each time when new request scene added to cassette.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, nullable, strong) NSArray<NSURLRequest *> *requestsSnapshot;
+
+/**
+ * @brief      Stores reference on list of responses which has been composed for \c responses.
+ * @discussion List reset each time when new response, data or error scene added to cassette.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, nullable, strong) NSArray<NSArray *> *responsesSnapshot;
+
+/**
+ * @brief      Stores reference on list of scenes in same order as they has been loaded from cassette file.
+ * @discussion List used to restore scenes which released their data.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSArray<YHVScene *> *loadedScenes;
+
+/**
+ * @brief      Stores maximum size (in bytes) of played scenes data which can be kept in memory.
+ * @discussion Value \c 0 means what played scenes data won't be released.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, assign) NSUInteger playedScenesMemoryBudget;
+
+/**
+ * @brief  Stores approximate size (in bytes) of played scenes data which is kept in memory.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, assign) NSUInteger playedScenesMemoryUsage;
+
+/**
+ * @brief      Stores reference on list of identifiers for played chapters which still keep their scenes data.
+ * @discussion Chapters stored in order in which they has been played.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableArray<NSString *> *retainedChapterIdentifiers;
+
+/**
+ * @brief  Stores reference on dictionary which maps played chapter identifier to size of it's scenes data.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *retainedChapterSizes;
+
+/**
+ * @brief      Stores reference on map of loaded scenes to their index in cassette file.
+ * @discussion Map used to restore data only for scenes which released it.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMapTable<YHVScene *, NSNumber *> *loadedSceneIndices;
+
+/**
+ * @brief      Stores reference on index which allow to match requests to chapters w/o request scenes decoding.
+ * @discussion Index loaded from file which is stored alongside with cassette and rebuilt each time when cassette is saved.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, nullable, strong) YHVMatchIndex *matchIndex;
+
+/**
+ * @brief      Stores index of first scene in \c scenes list which may not be played yet.
+ * @discussion Scenes before this index already has been played and new scenes placed on tape before this position.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, assign) NSUInteger playHeadIndex;
+
 /**
  * @brief  Stores reference on configuration which contain information about how cassette should operate and which data to use.
  */
@@ -107,8 +384,105 @@
 
 #pragma mark - Content management
 
+/**
+ * @brief      Write cassette's scenes as JSON array into file at specified \c path.
+ * @discussion Data of scenes which is stored in temporary files streamed into target file w/o loading it into memory.
+ *
+ * @param scenes Reference on list of scenes which should be written.
+ * @param path   Reference on path where cassette's content should be written.
+ *
+ * @return Whether content has been written or not.
+ *
+ * @since 1.6.0
+ */
+- (BOOL)writeScenes:(NSArray<YHVScene *> *)scenes asJSONToFileAtPath:(NSString *)path;
+
+/**
+ * @brief      Load match index for cassette's chapters.
+ * @discussion If stored index is missing or stale, it will be rebuilt from request scenes and stored alongside with cassette.
+ *
+ * @since 1.6.0
+ */
+- (void)loadMatchIndex;
+
+/**
+ * @brief  Read serialized scenes from cassette file.
+ *
+ * @return List of serialized scenes or \c nil in case if cassette file can't be read.
+ *
+ * @since 1.6.0
+ */
+- (nullable NSArray<NSDictionary *> *)contentOfCassetteFile;
+
+/**
+ * @brief  Update match index with recorded chapters and store it alongside with cassette.
+ *
+ * @since 1.6.0
+ */
+- (void)saveMatchIndex;
+
+/**
+ * @brief  Write Base64 encoded content of file at specified \c path into \c stream.
+ *
+ * @param path   Reference on path to file which should be encoded and written.
+ * @param stream Reference on opened stream into which encoded file content should be written.
+ *
+ * @return Whether content has been written or not.
+ *
+ * @since 1.6.0
+ */
+- (BOOL)writeBase64EncodedContentOfFileAtPath:(NSString *)path toStream:(NSOutputStream *)stream;
+
+/**
+ * @brief  Write whole \c data into \c stream.
+ *
+ * @param data   Reference on data which should be written.
+ * @param stream Reference on opened stream into which \c data should be written.
+ *
+ * @return Whether data has been written or not.
+ *
+ * @since 1.6.0
+ */
+- (BOOL)writeData:(NSData *)data toStream:(NSOutputStream *)stream;
+
+/**
+ * @brief  Compose list of chapter identifiers and chapter scenes index from loaded scenes.
+ */
 - (void)fetchListOfChapterIdentifiers;
 
+/**
+ * @brief      Compose cassette's tape from loaded and recorded scenes.
+ * @discussion Recorded scenes placed between loaded scenes in same order as they has been played and recorded.
+ *
+ * @return List of scenes in order in which they should be stored on cassette.
+ *
+ * @since 1.6.0
+ */
+- (NSArray<YHVScene *> *)tapeScenes;
+
+/**
+ * @brief  Add \c scene to chapter scenes index.
+ *
+ * @param scene Reference on scene which has been placed on cassette's tape.
+ *
+ * @return \c YES in case if \c scene is first one for it's chapter.
+ *
+ * @since 1.6.0
+ */
+- (BOOL)addSceneToChapterIndex:(YHVScene *)scene;
+
+/**
+ * @brief      Compose entry for \c responses list.
+ * @discussion Response body composed from chapter's data scenes w/o copying.
+ *
+ * @param identifier Unique identifier of chapter for which entry should be composed.
+ *
+ * @return List where first element is \a NSURLResponse and second is \a NSData or \a NSError.
+ *
+ * @since 1.6.0
+ */
+- (nullable NSArray *)responseEntryForChapterWithIdentifier:(NSString *)identifier;
+
 
 #pragma mark - Playback
 
@@ -128,6 +502,41 @@
  */
 - (void)markSceneAsPlayed:(YHVSceneType)sceneType forChapterWithIdentifier:(NSString *)identifier onQueue:(BOOL)useQueue;
 
+/**
+ * @brief  Check whether stubbed data for \c request should be delivered with throttling or not.
+ *
+ * @param request Reference on request for which stubbed data will be played.
+ *
+ * @return \c YES in case if cassette configured to throttle playback for request's host.
+ *
+ * @since 1.6.0
+ */
+- (BOOL)shouldThrottlePlaybackForRequest:(NSURLRequest *)request;
+
+/**
+ * @brief      Deliver next chunk of data from \c scene to protocol client.
+ * @discussion Chunk will be delivered with delay which is computed from configured bandwidth and chunk size. Timer is used for delivery
+ *             scheduling, so no threads will be blocked while waiting for it.
+ *
+ * @param scene      Reference on data scene which currently played with throttling.
+ * @param identifier Reference on unique identifier of chapter to which \c scene belongs.
+ *
+ * @since 1.6.0
+ */
+- (void)playNextChunkOfDataScene:(YHVScene *)scene forChapterWithIdentifier:(NSString *)identifier;
+
+/**
+ * @brief  Check whether there is data in throttled \c scene which not delivered to protocol client yet.
+ *
+ * @param scene      Reference on data scene which currently played.
+ * @param identifier Reference on unique identifier of chapter to which \c scene belongs.
+ *
+ * @return \c YES in case if only part of \c scene data has been delivered.
+ *
+ * @since 1.6.0
+ */
+- (BOOL)hasNotPlayedChunksInDataScene:(YHVScene *)scene forChapterWithIdentifier:(NSString *)identifier;
+
 /**
  * @brief  Confirm request scene playback completion.
  *
@@ -195,7 +604,8 @@
 - (nullable YHVScene *)nextSceneForChapterWithIdentifier:(NSString *)identifier;
 
 /**
- * @brief  Retrieve reference on chapter which contain scenes to re-play data for \c request.
+ * @brief      Retrieve reference on chapter which contain scenes to re-play data for \c request.
+ * @discussion Match index used to skip chapters which can't match and to confirm match w/o chapter's request scene decoding.
  *
  * @param request Reference on request against which matchers should be applied.
  *
@@ -213,9 +623,51 @@
  */
 - (nullable YHVScene *)sceneWithType:(YHVSceneType)type forChapter:(NSString *)identifier;
 
+/**
+ * @brief      Mark request scene of chapter with specified \c identifier as playing.
+ * @discussion Chapter's playback start time stored to calculate it's replay latency.
+ *
+ * @param identifier Unique identifier of chapter which will be played.
+ *
+ * @since 1.6.0
+ */
+- (void)beginPlaybackOfChapterWithIdentifier:(NSString *)identifier;
+
 
 #pragma mark - Recording
 
+/**
+ * @brief  Check whether progress of \c request processing can be recorded by cassette or not.
+ *
+ * @param request Reference on request which is processed by URL loading system.
+ *
+ * @return \c YES in case if request handled by this cassette, not ignored and not stubbed.
+ *
+ * @since 1.6.0
+ */
+- (BOOL)shouldRecordRequest:(NSURLRequest *)request;
+
+/**
+ * @brief  Retrieve reference on recorded scene of specified \c type for specific chapter.
+ *
+ * @param type       One of type fields from \b YHVSceneType enum which specify scene data type.
+ * @param identifier Reference on unique identifier of chapter inside of which scene search should be performed.
+ *
+ * @return Reference on scene if it has been found.
+ *
+ * @since 1.6.0
+ */
+- (nullable YHVScene *)recordedSceneWithType:(YHVSceneType)type forChapter:(NSString *)identifier;
+
+/**
+ * @brief  Move response body which has been received so far for chapter into temporary file.
+ *
+ * @param identifier Reference on unique identifier of chapter for which response body is recorded.
+ *
+ * @since 1.6.0
+ */
+- (void)moveRecordedDataToFileForChapterWithIdentifier:(NSString *)identifier;
+
 /**
  * @brief      Store specified \c scene on cassette's tape if possible.
  * @discussion Depending from \c recordMode code may throw exception in attempt to change cassette's content.
@@ -224,9 +676,62 @@
  */
 - (void)recordScene:(YHVScene *)scene;
 
+/**
+ * @brief  Replace previously recorded \c scene on cassette's tape with new one.
+ *
+ * @param scene    Reference on scene which has been recorded before.
+ * @param newScene Reference on scene which should take it's place on tape.
+ *
+ * @since 1.6.0
+ */
+- (void)replaceRecordedScene:(YHVScene *)scene withScene:(YHVScene *)newScene;
+
+
+#pragma mark - Memory management
+
+/**
+ * @brief      Track data of played chapter's scenes.
+ * @discussion If \c playedScenesMemoryBudget exceeded, data of oldest played chapters will be released.
+ *
+ * @param identifier Unique identifier of chapter which has been played.
+ *
+ * @since 1.6.0
+ */
+- (void)retainDataOfPlayedChapterWithIdentifier:(NSString *)identifier;
+
+/**
+ * @brief  Release data of chapter's scenes.
+ *
+ * @param identifier Unique identifier of played chapter for which scenes data should be released.
+ *
+ * @since 1.6.0
+ */
+- (void)releaseDataOfChapterWithIdentifier:(NSString *)identifier;
+
+/**
+ * @brief      Load data for passed scenes which released it from cassette file.
+ * @discussion Scenes which still have data will be ignored, so cassette file will be read only if it really required.
+ *
+ * @param scenes Reference on list of scenes which will be accessed and should have data.
+ *
+ * @return \c NO in case if data for some of released scenes can't be restored (cassette file has been changed).
+ *
+ * @since 1.6.0
+ */
+- (BOOL)restoreDataOfScenes:(NSArray<YHVScene *> *)scenes;
+
 
 #pragma mark - Misc
 
+/**
+ * @brief  Compose path to new temporary file inside of cassette's temporary directory.
+ *
+ * @return Full path to file which can be used to store data.
+ *
+ * @since 1.6.0
+ */
+- (NSString *)temporaryFilePath;
+
 /**
  * @brief      Filter out sensitive data packed into error.
  * @discussion Usually errors associated with called URI - this is what should be filtered.
@@ -260,7 +765,7 @@
     __block NSArray<YHVScene *> *availableScenes = nil;
     
     dispatch_sync(self.resourceAccessQueue, ^{
-        availableScenes = self->_scenes;
+        availableScenes = [self tapeScenes];
     });
     
     return availableScenes;
@@ -268,24 +773,12 @@
 
 - (NSUInteger)playCount {
     
-    __block NSUInteger playCount = 0;
-    
-    dispatch_sync(self.resourceAccessQueue, ^{
-        for (NSUInteger sceneIdx = 0; sceneIdx < self.scenes.count; sceneIdx++) {
-            if ((self.scenes[sceneIdx].type == YHVClosingScene || self.scenes[sceneIdx].type == YHVErrorScene) &&
-                self.scenes[sceneIdx].played) {
-                
-                playCount++;
-            }
-        }
-    });
-    
-    return playCount;
+    return (NSUInteger)atomic_load(&_playedChaptersCount);
 }
 
 - (BOOL)allPlayed {
     
-    NSUInteger requestsCount = self.requests.count;
+    NSUInteger requestsCount = (NSUInteger)atomic_load(&_requestScenesCount);
     BOOL allPlayed = NO;
     
     if (!self.isNewCassette) {
@@ -295,6 +788,31 @@
     return allPlayed;
 }
 
+- (YHVCassetteStatistics *)statistics {
+    
+    __block YHVCassetteStatistics *statistics = nil;
+    
+    dispatch_sync(self.resourceAccessQueue, ^{
+        NSArray<NSString *> *matcherNames = self->_configuration.matcherNames;
+        NSUInteger matchersCount = self->_configuration.matchers.count;
+        NSMutableDictionary *evaluations = [NSMutableDictionary dictionaryWithCapacity:matchersCount];
+        
+        for (NSUInteger matcherIdx = 0; matcherIdx < matchersCount; matcherIdx++) {
+            NSString *name = matcherIdx < matcherNames.count ? matcherNames[matcherIdx] : nil;
+            name = name ?: [NSString stringWithFormat:@"matcher%@", @(matcherIdx)];
+            
+            evaluations[name] = @(self->_matcherEvaluations ? self->_matcherEvaluations[matcherIdx] : 0);
+        }
+        
+        statistics = [YHVCassetteStatistics statisticsWithCounters:self->_counters
+                                                matcherEvaluations:evaluations
+                                                       scenesCount:[self tapeScenes].count
+                                                     chaptersCount:self.chapterScenes.count];
+    });
+    
+    return statistics;
+}
+
 - (BOOL)isWriteProtected {
     
     return (!self.isNewCassette && self.configuration.recordMode == YHVRecordOnce) || self.configuration.recordMode == YHVRecordNone;
@@ -302,16 +820,28 @@
 
 - (NSArray<NSURLRequest *> *)requests {
     
-    NSMutableArray<NSURLRequest *> *requests = [NSMutableArray new];
+    __block NSArray<NSURLRequest *> *requests = nil;
     
     dispatch_sync(self.resourceAccessQueue, ^{
-        for (YHVScene *scene in self.scenes) {
-            if (scene.type != YHVRequestScene) {
-                continue;
-            }
+        if (self.requestsSnapshot) {
+            requests = self.requestsSnapshot;
+            return;
+        }
+        
+        BOOL restored = [self restoreDataOfScenes:self.requestScenes];
+        NSMutableArray<NSURLRequest *> *snapshot = [NSMutableArray arrayWithCapacity:self.requestScenes.count];
+        
+        for (YHVScene *scene in self.requestScenes) {
+            NSURLRequest *request = (NSURLRequest *)scene.data;
             
-            [requests addObject:(id)scene.data];
+            if (request) {
+                [snapshot addObject:request];
+            }
         }
+        
+        // Incomplete snapshot shouldn't be cached, so restoration will be tried again on next access.
+        self.requestsSnapshot = restored ? snapshot : nil;
+        requests = snapshot;
     });
     
     return requests;
@@ -319,34 +849,39 @@
 
 - (NSArray<NSArray *> *)responses {
     
-    NSMutableArray<NSArray *> *requests = [NSMutableArray new];
+    __block NSArray<NSArray *> *responses = nil;
     
     dispatch_sync(self.resourceAccessQueue, ^{
-        for (YHVScene *responseScene in self.scenes) {
-            if (responseScene.type != YHVResponseScene) {
-                continue;
+        if (self.responsesSnapshot) {
+            responses = self.responsesSnapshot;
+            return;
+        }
+        
+        NSMutableArray<YHVScene *> *chaptersScenes = [NSMutableArray new];
+        
+        for (YHVScene *scene in self.responseScenes) {
+            if (!self.responseEntries[scene.identifier]) {
+                [chaptersScenes addObjectsFromArray:self.chapterScenes[scene.identifier]];
             }
+        }
+        
+        BOOL restored = [self restoreDataOfScenes:chaptersScenes];
+        NSMutableArray<NSArray *> *snapshot = [NSMutableArray arrayWithCapacity:self.responseScenes.count];
+        
+        for (YHVScene *scene in self.responseScenes) {
+            NSArray *entry = [self responseEntryForChapterWithIdentifier:scene.identifier];
             
-            id data = nil;
-            NSMutableData *accumulatedData = [NSMutableData new];
-
-            for (YHVScene *responseDataScene in self.scenes) {
-                if (![responseDataScene.identifier isEqualToString:responseScene.identifier] || responseDataScene.type != YHVDataScene) {
-                    if (responseDataScene.type == YHVErrorScene) {
-                        data = responseDataScene.data;
-                        break;
-                    }
-                    continue;
-                }
-                
-                [accumulatedData appendData:((id)responseDataScene.data ?: [NSData new])];
+            if (entry) {
+                [snapshot addObject:entry];
             }
-            
-            [requests addObject:@[responseScene.data, data ?: accumulatedData]];
         }
+        
+        // Incomplete snapshot shouldn't be cached, so restoration will be tried again on next access.
+        self.responsesSnapshot = restored ? snapshot : nil;
+        responses = snapshot;
     });
     
-    return requests;
+    return responses;
 }
 
 
@@ -363,17 +898,55 @@
         _resourceAccessQueue = dispatch_queue_create("com.yetanotherhttpvcr.cassette", DISPATCH_QUEUE_SERIAL);
         _connectionChapterIdentifiers = [NSMutableArray new];
         _completedChaptersIdentifier = [NSMutableArray new];
+        _latencyAppliedChapterIdentifiers = [NSMutableSet new];
+        _chapterPlaybackStartDates = [NSMutableDictionary new];
+        _throttledDataOffsets = [NSMutableDictionary new];
+        _recordedDataBuffers = [NSMutableDictionary new];
+        _recordedDataFiles = [NSMutableDictionary new];
+        _recordedDataPaths = [NSMutableDictionary new];
         _requestsIdentifiers = [NSMutableDictionary new];
+        _chapterScenes = [NSMutableDictionary new];
+        _responseEntries = [NSMutableDictionary new];
+        _retainedChapterSizes = [NSMutableDictionary new];
+        _retainedChapterIdentifiers = [NSMutableArray new];
+        _responseScenes = [NSMutableArray new];
+        _requestScenes = [NSMutableArray new];
         _activeClients = [NSMutableDictionary new];
         _identifier = [NSUUID UUID].UUIDString;
+        _temporaryDirectoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[@"com.yetanotherhttpvcr.cassette."
+                                                                                          stringByAppendingString:_identifier]];
         _configuration = [configuration copy];
         _scenes = [NSMutableArray new];
+        _recordedScenes = [NSMutableArray new];
+        _recordedScenesTapeIndices = [NSMutableArray new];
+        _recordedChapterSceneIndices = [NSMutableDictionary new];
+        
+        if (_configuration.matchers.count) {
+            _matcherEvaluations = calloc(_configuration.matchers.count, sizeof(NSUInteger));
+        }
+        
+        if (_configuration.traceFilePath.length) {
+            _traceRecorder = [YHVTraceRecorder recorderWithName:(_configuration.cassettePath.lastPathComponent ?: _identifier)];
+        }
         
     }
     
     return self;
 }
 
+- (void)dealloc {
+    
+    for (NSFileHandle *file in self->_recordedDataFiles.allValues) {
+        [file closeFile];
+    }
+    
+    [NSFileManager.defaultManager removeItemAtPath:self->_temporaryDirectoryPath error:nil];
+    
+    if (self->_matcherEvaluations) {
+        free(self->_matcherEvaluations);
+    }
+}
+
 
 #pragma mark - Content management
 
@@ -385,27 +958,51 @@
         return;
     }
     
+    NSUInteger playedScenesMemoryBudget = self.isWriteProtected ? self.configuration.playedScenesMemoryBudget : 0;
+    
     dispatch_sync(self.resourceAccessQueue, ^{
+        NSMapTable<YHVScene *, NSNumber *> *sceneIndices = [NSMapTable mapTableWithKeyOptions:NSMapTableObjectPointerPersonality
+                                                                                 valueOptions:NSMapTableStrongMemory];
         NSMutableArray<YHVScene *> *deserializedScenes = [NSMutableArray new];
-        NSArray<NSDictionary *> *content = nil;
-        
-        if ([[self.configuration.cassettePath pathExtension] isEqualToString:@"json"]) {
-            NSData *jsonData = [NSData dataWithContentsOfFile:self.configuration.cassettePath];
-            content = [NSJSONSerialization JSONObjectWithData:jsonData options:NSJSONReadingAllowFragments error:nil];
-        } else {
-            content = [NSArray arrayWithContentsOfFile:self.configuration.cassettePath];
-        }
+        CFAbsoluteTime loadStartDate = CFAbsoluteTimeGetCurrent();
+        NSArray<NSDictionary *> *content = [self contentOfCassetteFile];
         
         for (NSDictionary *sceneDictionary in content) {
-            [deserializedScenes addObject:[YHVScene YHV_objectFromDictionary:sceneDictionary]];
+            YHVScene *scene = [YHVScene YHV_objectFromDictionary:sceneDictionary];
+            
+            [sceneIndices setObject:@(deserializedScenes.count) forKey:scene];
+            [deserializedScenes addObject:scene];
         }
         
         [self.scenes addObjectsFromArray:deserializedScenes];
+        self.playedScenesMemoryBudget = playedScenesMemoryBudget;
+        self.loadedSceneIndices = sceneIndices;
+        self.loadedScenes = deserializedScenes;
         
         [self fetchListOfChapterIdentifiers];
+        [self loadMatchIndex];
+        
+        NSDictionary *attributes = [NSFileManager.defaultManager attributesOfItemAtPath:self->_configuration.cassettePath error:nil];
+        self->_counters.loadDuration = CFAbsoluteTimeGetCurrent() - loadStartDate;
+        self->_counters.loadedBytesCount = attributes.fileSize;
     });
 }
 
+- (NSArray<NSDictionary *> *)contentOfCassetteFile {
+    
+    NSString *cassettePath = self.configuration.cassettePath;
+    NSArray<NSDictionary *> *content = nil;
+    
+    if ([[cassettePath pathExtension] isEqualToString:@"json"]) {
+        NSData *jsonData = [NSData dataWithContentsOfFile:cassettePath];
+        content = jsonData ? [NSJSONSerialization JSONObjectWithData:jsonData options:NSJSONReadingAllowFragments error:nil] : nil;
+    } else {
+        content = [NSArray arrayWithContentsOfFile:cassettePath];
+    }
+    
+    return [content isKindOfClass:[NSArray class]] ? content : nil;
+}
+
 - (void)save {
     
     dispatch_sync(self.resourceAccessQueue, ^{
@@ -413,30 +1010,315 @@
             return;
         }
         
-        NSArray *serializedScenes = [self.scenes valueForKey:@"YHV_dictionaryRepresentation"];
-        id content = serializedScenes;
+        CFAbsoluteTime saveStartDate = CFAbsoluteTimeGetCurrent();
+        NSString *cassettePath = self.configuration.cassettePath;
+        BOOL isJSONCassette = [[cassettePath pathExtension] isEqualToString:@"json"];
+        BOOL saved = NO;
         
-        if ([[self.configuration.cassettePath pathExtension] isEqualToString:@"json"]) {
-            NSError *error;
-            NSData *jsonData = [NSJSONSerialization dataWithJSONObject:content options:NSJSONWritingPrettyPrinted error:&error];
-            content = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
+        // Scenes w/o data can't be written, so cassette file should stay untouched.
+        if (![self restoreDataOfScenes:self.loadedScenes]) {
+            return;
         }
         
-        [content writeToFile:self.configuration.cassettePath atomically:YES];
+        NSArray<YHVScene *> *scenes = [self tapeScenes];
+        
+        if (isJSONCassette && [scenes filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"dataPath != nil"]].count) {
+            saved = [self writeScenes:scenes asJSONToFileAtPath:cassettePath];
+        } else {
+            NSArray *serializedScenes = [scenes valueForKey:@"YHV_dictionaryRepresentation"];
+            id content = serializedScenes;
+            
+            if (isJSONCassette) {
+                NSError *error;
+                NSData *jsonData = [NSJSONSerialization dataWithJSONObject:content options:NSJSONWritingPrettyPrinted error:&error];
+                content = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
+            }
+            
+            saved = [content writeToFile:cassettePath atomically:YES];
+        }
+        
+        if (saved) {
+            [self saveMatchIndex];
+            
+            NSDictionary *attributes = [NSFileManager.defaultManager attributesOfItemAtPath:cassettePath error:nil];
+            self->_counters.saveDuration += CFAbsoluteTimeGetCurrent() - saveStartDate;
+            self->_counters.savedBytesCount = attributes.fileSize;
+        }
     });
 }
 
+- (void)saveTrace {
+    
+    if (self.traceRecorder) {
+        [self.traceRecorder appendToFileAtPath:self->_configuration.traceFilePath];
+    }
+}
+
+- (BOOL)writeScenes:(NSArray<YHVScene *> *)scenes asJSONToFileAtPath:(NSString *)path {
+    
+    NSString *temporaryPath = [path stringByAppendingFormat:@".%@", [NSUUID UUID].UUIDString];
+    NSOutputStream *stream = [NSOutputStream outputStreamToFileAtPath:temporaryPath append:NO];
+    NSData *separator = [@",\n" dataUsingEncoding:NSUTF8StringEncoding];
+    [stream open];
+    
+    BOOL written = [self writeData:[@"[\n" dataUsingEncoding:NSUTF8StringEncoding] toStream:stream];
+    
+    for (NSUInteger sceneIdx = 0; sceneIdx < scenes.count && written; sceneIdx++) {
+        YHVScene *scene = scenes[sceneIdx];
+        NSData *placeholder = nil;
+        
+        if (sceneIdx > 0) {
+            written = [self writeData:separator toStream:stream];
+        }
+        
+        if (scene.dataPath) {
+            /**
+             * Serialize scene with small unique data, which will be replaced with streamed file content. Placeholder composed only from
+             * alphanumeric characters, so it won't be escaped by JSON serializer.
+             */
+            NSString *uuid = [[NSUUID UUID].UUIDString stringByReplacingOccurrencesOfString:@"-" withString:@""];
+            NSString *placeholderString = [@"YHV0" stringByAppendingString:uuid];
+            NSData *placeholderData = [[NSData alloc] initWithBase64EncodedString:placeholderString options:(NSDataBase64DecodingOptions)0];
+            
+            placeholder = [placeholderString dataUsingEncoding:NSUTF8StringEncoding];
+            scene = [YHVScene sceneWithIdentifier:scene.identifier type:scene.type data:placeholderData];
+        }
+        
+        NSData *sceneData = [NSJSONSerialization dataWithJSONObject:[scene YHV_dictionaryRepresentation]
+                                                            options:NSJSONWritingPrettyPrinted
+                                                              error:nil];
+        NSRange placeholderRange = NSMakeRange(NSNotFound, 0);
+        
+        if (sceneData && placeholder) {
+            placeholderRange = [sceneData rangeOfData:placeholder options:(NSDataSearchOptions)0 range:NSMakeRange(0, sceneData.length)];
+        }
+        
+        if (!sceneData || (placeholder && placeholderRange.location == NSNotFound)) {
+            written = NO;
+        } else if (!placeholder) {
+            written = written && [self writeData:sceneData toStream:stream];
+        } else {
+            NSUInteger suffixLocation = NSMaxRange(placeholderRange);
+            
+            written = written && [self writeData:[sceneData subdataWithRange:NSMakeRange(0, placeholderRange.location)] toStream:stream];
+            written = written && [self writeBase64EncodedContentOfFileAtPath:scenes[sceneIdx].dataPath toStream:stream];
+            written = written && [self writeData:[sceneData subdataWithRange:NSMakeRange(suffixLocation, sceneData.length - suffixLocation)]
+                                        toStream:stream];
+        }
+    }
+    
+    written = written && [self writeData:[@"\n]" dataUsingEncoding:NSUTF8StringEncoding] toStream:stream];
+    [stream close];
+    
+    if (written) {
+        written = rename(temporaryPath.fileSystemRepresentation, path.fileSystemRepresentation) == 0;
+    }
+    
+    if (!written) {
+        [NSFileManager.defaultManager removeItemAtPath:temporaryPath error:nil];
+    }
+    
+    return written;
+}
+
+- (void)loadMatchIndex {
+    
+    NSArray<YHVScene *> *requestScenes = self.requestScenes;
+    NSSet<NSString *> *chapterIdentifiers = [NSSet setWithArray:[requestScenes valueForKey:@"identifier"]];
+    YHVMatchIndex *index = [YHVMatchIndex indexForCassetteAtPath:self.configuration.cassettePath];
+    
+    if (!index || ![index.chapterIdentifiers isEqualToSet:chapterIdentifiers]) {
+        index = [YHVMatchIndex indexWithRequestScenes:requestScenes reusingIndex:nil];
+        [index writeForCassetteAtPath:self.configuration.cassettePath];
+    }
+    
+    self.matchIndex = index;
+}
+
+- (void)saveMatchIndex {
+    
+    self.matchIndex = [YHVMatchIndex indexWithRequestScenes:self.requestScenes reusingIndex:self.matchIndex];
+    [self.matchIndex writeForCassetteAtPath:self.configuration.cassettePath];
+}
+
+- (BOOL)writeBase64EncodedContentOfFileAtPath:(NSString *)path toStream:(NSOutputStream *)stream {
+    
+    NSFileHandle *file = [NSFileHandle fileHandleForReadingAtPath:path];
+    // Chunk length should be multiple of 3, so encoded chunks can be concatenated w/o padding in between.
+    static NSUInteger const kYHVBase64ChunkLength = 3 * 64 * 1024;
+    BOOL written = file != nil;
+    BOOL endOfFile = NO;
+    
+    while (written && !endOfFile) {
+        @autoreleasepool {
+            NSData *chunk = [file readDataOfLength:kYHVBase64ChunkLength];
+            endOfFile = chunk.length < kYHVBase64ChunkLength;
+            
+            if (chunk.length) {
+                written = [self writeData:[YHVBase64 dataByEncodingData:chunk] toStream:stream];
+            }
+        }
+    }
+    
+    [file closeFile];
+    
+    return written;
+}
+
+- (BOOL)writeData:(NSData *)data toStream:(NSOutputStream *)stream {
+    
+    const uint8_t *bytes = data.bytes;
+    NSUInteger writtenLength = 0;
+    
+    while (writtenLength < data.length) {
+        NSInteger length = [stream write:(bytes + writtenLength) maxLength:(data.length - writtenLength)];
+        
+        if (length <= 0) {
+            return NO;
+        }
+        
+        writtenLength += (NSUInteger)length;
+    }
+    
+    return YES;
+}
+
 - (void)fetchListOfChapterIdentifiers {
     
-    NSMutableArray *identifiers = [NSMutableArray new];
+    NSMutableArray *identifiers = [NSMutableArray new];
+    [self.responseEntries removeAllObjects];
+    [self.responseScenes removeAllObjects];
+    [self.requestScenes removeAllObjects];
+    [self.chapterScenes removeAllObjects];
+    atomic_store(&_playedChaptersCount, 0);
+    atomic_store(&_requestScenesCount, 0);
+    self.responsesSnapshot = nil;
+    self.requestsSnapshot = nil;
+    
+    for (YHVScene *scene in self.scenes) {
+        if ([self addSceneToChapterIndex:scene]) {
+            [identifiers addObject:scene.identifier];
+        }
+    }
+    
+    self.chapterIdentifiers = identifiers;
+}
+
+- (NSArray<YHVScene *> *)tapeScenes {
+    
+    NSUInteger recordedScenesCount = self.recordedScenes.count;
+    NSUInteger scenesCount = self.scenes.count;
+    
+    if (!recordedScenesCount) {
+        return [self.scenes copy];
+    }
+    
+    NSMutableArray<YHVScene *> *scenes = [NSMutableArray arrayWithCapacity:(scenesCount + recordedScenesCount)];
+    NSUInteger recordedSceneIdx = 0;
+    
+    for (NSUInteger sceneIdx = 0; sceneIdx <= scenesCount; sceneIdx++) {
+        while (recordedSceneIdx < recordedScenesCount &&
+               self.recordedScenesTapeIndices[recordedSceneIdx].unsignedIntegerValue <= sceneIdx) {
+            id scene = self.recordedScenes[recordedSceneIdx++];
+            
+            if (scene != [NSNull null]) {
+                [scenes addObject:scene];
+            }
+        }
+        
+        if (sceneIdx < scenesCount) {
+            [scenes addObject:self.scenes[sceneIdx]];
+        }
+    }
+    
+    return scenes;
+}
+
+- (BOOL)addSceneToChapterIndex:(YHVScene *)scene {
+    
+    NSMutableArray<YHVScene *> *scenes = self.chapterScenes[scene.identifier];
+    BOOL isFirstScene = scenes == nil;
+    
+    if (isFirstScene) {
+        scenes = [NSMutableArray new];
+        self.chapterScenes[scene.identifier] = scenes;
+    }
+    
+    // Response body serialization depends from type of it's content. Restored scenes reuse their serialized data.
+    if (scene.type == YHVDataScene && !scene.contentType && !scene.isSerialized) {
+        for (YHVScene *responseScene in scenes) {
+            if (responseScene.type == YHVResponseScene) {
+                id response = responseScene.data;
+                NSDictionary *headers = [response isKindOfClass:[NSHTTPURLResponse class]] ? ((NSHTTPURLResponse *)response).allHeaderFields : nil;
+                
+                for (NSString *header in headers) {
+                    if ([header caseInsensitiveCompare:@"Content-Type"] == NSOrderedSame) {
+                        scene.contentType = headers[header];
+                        break;
+                    }
+                }
+                
+                break;
+            }
+        }
+    }
+    
+    [scenes addObject:scene];
+    
+    if (scene.type == YHVRequestScene) {
+        atomic_fetch_add(&_requestScenesCount, 1);
+        [self.requestScenes addObject:scene];
+        self.requestsSnapshot = nil;
+    } else {
+        if (scene.type == YHVResponseScene) {
+            [self.responseScenes addObject:scene];
+        }
+        
+        [self.responseEntries removeObjectForKey:scene.identifier];
+        self.responsesSnapshot = nil;
+    }
+    
+    return isFirstScene;
+}
+
+- (NSArray *)responseEntryForChapterWithIdentifier:(NSString *)identifier {
+    
+    NSArray *entry = self.responseEntries[identifier];
+    
+    if (entry) {
+        return entry;
+    }
     
-    for (YHVScene *scene in self.scenes) {
-        if (![identifiers containsObject:scene.identifier]) {
-            [identifiers addObject:scene.identifier];
+    dispatch_data_t body = dispatch_data_empty;
+    id response = nil;
+    id error = nil;
+    
+    for (YHVScene *scene in self.chapterScenes[identifier]) {
+        if (scene.type == YHVResponseScene && !response) {
+            response = scene.data;
+        } else if (scene.type == YHVErrorScene) {
+            error = scene.data;
+        } else if (scene.type == YHVDataScene) {
+            NSData *data = (NSData *)scene.data;
+            
+            if (!data.length) {
+                continue;
+            }
+            
+            // Region references scene's data, so body will be joined only if it will be accessed as contiguous buffer.
+            dispatch_data_t region = dispatch_data_create(data.bytes, data.length, NULL, ^{
+                (void)data;
+            });
+            body = dispatch_data_create_concat(body, region);
         }
     }
     
-    self.chapterIdentifiers = identifiers;
+    if (response) {
+        entry = @[response, error ?: (NSData *)body];
+        self.responseEntries[identifier] = entry;
+    }
+    
+    return entry;
 }
 
 
@@ -450,10 +1332,11 @@
         return match;
     }
     
-    NSURLRequest *filteredRequest = self.configuration.beforeRecordRequest(request);
-    
-    if (filteredRequest && scene.type == YHVRequestScene) {
-        match = [YHVRequestMatchers request:filteredRequest isMatchingTo:(id)scene.data withMatchers:self.configuration.matchers];
+    if (scene.type == YHVRequestScene) {
+        match = [YHVRequestMatchers request:request
+                               isMatchingTo:(id)scene.data
+                               withMatchers:self->_configuration.matchers
+                                evaluations:self->_matcherEvaluations];
     }
     
     return match;
@@ -482,7 +1365,7 @@
                 request.YHV_cassetteChapterIdentifier = chapterIdentifier;
                 request.YHV_cassetteIdentifier = self.identifier;
                 
-                [[self sceneWithType:YHVRequestScene forChapter:chapterIdentifier] setPlaying];
+                [self beginPlaybackOfChapterWithIdentifier:chapterIdentifier];
             }
         });
     }
@@ -504,7 +1387,7 @@
                 protocol.request.YHV_cassetteChapterIdentifier = [self chapterIdentifierForRequest:protocol.request];
                 protocol.request.YHV_cassetteIdentifier = self.identifier;
                 
-                [[self sceneWithType:YHVRequestScene forChapter:protocol.request.YHV_cassetteChapterIdentifier] setPlaying];
+                [self beginPlaybackOfChapterWithIdentifier:protocol.request.YHV_cassetteChapterIdentifier];
             }
         });
     }
@@ -538,6 +1421,13 @@
     
     dispatch_sync(self.resourceAccessQueue, ^{
         if (self.currentScene) {
+            if (![self.currentScene.identifier isEqualToString:chapterIdentifier]) {
+                [self.traceRecorder markEventWithName:@"blocked"
+                                             category:@"playback"
+                                              onTrack:chapterIdentifier
+                                            arguments:@{ @"reason": @"current scene", @"chapter": self.currentScene.identifier }];
+            }
+            
             return;
         }
         
@@ -554,6 +1444,15 @@
         canPlayScene = !chapterPlayed && readyToPlayScenesForChapter && !waitingForAnotherChapter && scene && !scene.played && !scene.playing;
         
         if (!canPlayScene) {
+            if (!chapterPlayed && scene && (waitingForAnotherChapter || !readyToPlayScenesForChapter)) {
+                NSString *reason = waitingForAnotherChapter ? @"previous chapter" : @"no client";
+                
+                [self.traceRecorder markEventWithName:@"blocked"
+                                             category:@"playback"
+                                              onTrack:chapterIdentifier
+                                            arguments:@{ @"reason": reason }];
+            }
+            
             if (!waitingForAnotherChapter && !scene) {
                 nextChapterIdentifier = [self nextIncompleteChapterIdentifier];
                 YHVScene *nextScene = nextChapterIdentifier ? [self nextSceneForChapterWithIdentifier:nextChapterIdentifier] : nil;
@@ -576,6 +1475,8 @@
         self.currentScene = scene;
         [scene setPlaying];
         
+        [self.traceRecorder beginSpanWithName:YHVSceneTypeName(scene.type) category:@"playback" onTrack:chapterIdentifier];
+        
         if (scene.type == YHVResponseScene) {
             [protocol.client URLProtocol:protocol didReceiveResponse:(id)scene.data cacheStoragePolicy:NSURLCacheStorageNotAllowed];
             
@@ -585,7 +1486,13 @@
         } else if (scene.type == YHVDataScene) {
             NSData *data = (id)scene.data;
             
+            if (data.length && [self shouldThrottlePlaybackForRequest:protocol.request]) {
+                [self playNextChunkOfDataScene:scene forChapterWithIdentifier:chapterIdentifier];
+                return;
+            }
+            
             if (data.length) {
+                self->_counters.replayedBytesCount += data.length;
                 [protocol.client URLProtocol:protocol didLoadData:data];
             }
             
@@ -621,11 +1528,31 @@
             NSString *nextChapterIdentifier = identifier;
             
             if (scene && !scene.played && (scene.playing || sceneType == YHVRequestScene) && scene.type == sceneType) {
+                if (isCurrentScene && [self hasNotPlayedChunksInDataScene:scene forChapterWithIdentifier:identifier]) {
+                    [self playNextChunkOfDataScene:scene forChapterWithIdentifier:identifier];
+                    return;
+                }
+                
+                [self.throttledDataOffsets removeObjectForKey:identifier];
+                
                 if (scene.type == YHVErrorScene || scene.type == YHVClosingScene) {
+                    NSNumber *playbackStartDate = self.chapterPlaybackStartDates[identifier];
+                    atomic_fetch_add(&self->_playedChaptersCount, 1);
                     [self.completedChaptersIdentifier addObject:identifier];
+                    
+                    if (playbackStartDate) {
+                        NSTimeInterval latency = CFAbsoluteTimeGetCurrent() - playbackStartDate.doubleValue;
+                        self->_counters.replayLatencyHistogram[YHVReplayLatencyBucketIndex(latency)]++;
+                        [self.chapterPlaybackStartDates removeObjectForKey:identifier];
+                    }
                 }
                 
                 [scene setPlayed];
+                [self.traceRecorder endSpanWithName:YHVSceneTypeName(scene.type) onTrack:identifier arguments:nil];
+                
+                if (scene.type == YHVErrorScene || scene.type == YHVClosingScene) {
+                    [self retainDataOfPlayedChapterWithIdentifier:identifier];
+                }
                 
                 if (!isCurrentScene) {
                     return;
@@ -653,6 +1580,73 @@
     }
 }
 
+- (BOOL)shouldThrottlePlaybackForRequest:(NSURLRequest *)request {
+    
+    YHVConfiguration *configuration = self->_configuration;
+    BOOL shouldThrottle = configuration.playbackBytesPerSecond > 0 || configuration.playbackChunkSize > 0 ||
+                          configuration.playbackInitialLatency > 0;
+    
+    if (shouldThrottle && configuration.lowercaseThrottledHosts) {
+        NSString *host = request.URL.host.lowercaseString;
+        shouldThrottle = host && [configuration.lowercaseThrottledHosts containsObject:host];
+    }
+    
+    return shouldThrottle;
+}
+
+- (void)playNextChunkOfDataScene:(YHVScene *)scene forChapterWithIdentifier:(NSString *)identifier {
+    
+    YHVConfiguration *configuration = self->_configuration;
+    NSUInteger offset = self.throttledDataOffsets[identifier].unsignedIntegerValue;
+    NSData *data = (id)scene.data;
+    NSUInteger chunkLength = data.length - offset;
+    NSTimeInterval delay = 0.f;
+    
+    if (configuration.playbackChunkSize > 0) {
+        chunkLength = MIN(chunkLength, configuration.playbackChunkSize);
+    }
+    
+    if (configuration.playbackBytesPerSecond > 0) {
+        delay = (NSTimeInterval)chunkLength / configuration.playbackBytesPerSecond;
+    }
+    
+    if (![self.latencyAppliedChapterIdentifiers containsObject:identifier]) {
+        [self.latencyAppliedChapterIdentifiers addObject:identifier];
+        delay += configuration.playbackInitialLatency;
+    }
+    
+    self.throttledDataOffsets[identifier] = @(offset + chunkLength);
+    
+    dispatch_block_t chunkDeliveryBlock = ^{
+        YHVNSURLProtocol *protocol = self.activeClients[identifier];
+        
+        // Chunk delivery could be scheduled for protocol which doesn't wait for stubbed data anymore.
+        if (!protocol || ![scene isEqual:self.currentScene]) {
+            return;
+        }
+        
+        self->_counters.replayedBytesCount += chunkLength;
+        [protocol.client URLProtocol:protocol didLoadData:[data subdataWithRange:NSMakeRange(offset, chunkLength)]];
+        
+        if ([self.connectionChapterIdentifiers containsObject:identifier]) {
+            [self handleDataPlayedForRequest:protocol.request onQueue:NO];
+        }
+    };
+    
+    if (delay > 0.f) {
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.resourceAccessQueue, chunkDeliveryBlock);
+    } else {
+        dispatch_async(self.resourceAccessQueue, chunkDeliveryBlock);
+    }
+}
+
+- (BOOL)hasNotPlayedChunksInDataScene:(YHVScene *)scene forChapterWithIdentifier:(NSString *)identifier {
+    
+    NSNumber *offset = self.throttledDataOffsets[identifier];
+    
+    return scene.type == YHVDataScene && offset && offset.unsignedIntegerValue < ((NSData *)scene.data).length;
+}
+
 - (void)handleRequestPlayedForTask:(NSURLSessionTask *)task {
 
     [self handleRequestPlayedForRequest:task.originalRequest];
@@ -716,18 +1710,14 @@
 
 - (NSUInteger)nextNotPlayedSceneIndex {
     
-    NSUInteger index = NSNotFound;
+    NSUInteger scenesCount = self.scenes.count;
     
-    for (NSUInteger sceneIdx = 0; sceneIdx < self.scenes.count; sceneIdx++) {
-        if (self.scenes[sceneIdx].played) {
-            continue;
-        }
-        
-        index = sceneIdx;
-        break;
+    // Scenes can't become 'not played', so play head only moves forward.
+    while (self.playHeadIndex < scenesCount && self.scenes[self.playHeadIndex].played) {
+        self.playHeadIndex++;
     }
     
-    return index;
+    return self.playHeadIndex < scenesCount ? self.playHeadIndex : NSNotFound;
 }
 
 - (NSString *)nextIncompleteChapterIdentifier {
@@ -771,28 +1761,78 @@
 
 - (NSString *)chapterIdentifierForRequest:(NSURLRequest *)request {
     
+    YHVConfiguration *configuration = self.configuration;
+    NSURLRequest *filteredRequest = request ? configuration.beforeRecordRequest(request) : nil;
+    NSArray<NSString *> *matchers = configuration.matcherIdentifiers ?: @[];
+    // Index can confirm match only when all configured matchers is bundled matchers.
+    BOOL canConfirmMatch = matchers.count == configuration.matchers.count;
+    NSDictionary *fingerprint = nil;
     NSString *identifier = nil;
+    NSUInteger scannedCandidatesCount = 0;
+    
+    if (!filteredRequest) {
+        return identifier;
+    }
+    
+    if (self.matchIndex) {
+        fingerprint = [YHVMatchIndex fingerprintForRequest:filteredRequest withMatchers:matchers];
+    }
     
     for (YHVScene *scene in self.scenes) {
-        if (scene.played || scene.playing || scene.type != YHVRequestScene) {
+        if (scene.type != YHVRequestScene || scene.played || scene.playing) {
+            continue;
+        }
+        
+        YHVMatchIndexResult result = YHVMatchIndexUndecided;
+        BOOL resolvedByIndex = NO;
+        scannedCandidatesCount++;
+        
+        if (fingerprint) {
+            result = [self.matchIndex matchFingerprint:fingerprint toChapterWithIdentifier:scene.identifier withMatchers:matchers];
+        }
+        
+        resolvedByIndex = result == YHVMatchIndexMismatch || (result == YHVMatchIndexMatch && canConfirmMatch);
+        self->_counters.indexResolvedCandidatesCount += resolvedByIndex ? 1 : 0;
+        
+        if (result == YHVMatchIndexMismatch) {
             continue;
         }
         
-        if ([self sceneRequest:scene matchToRequest:request]) {
+        if (resolvedByIndex || [self sceneRequest:scene matchToRequest:filteredRequest]) {
             identifier = scene.identifier;
             break;
         }
     }
     
+    self->_counters.maximumScannedCandidatesCount = MAX(self->_counters.maximumScannedCandidatesCount, scannedCandidatesCount);
+    self->_counters.scannedCandidatesCount += scannedCandidatesCount;
+    self->_counters.lookupsCount++;
+    
     return identifier;
 }
 
+- (void)beginPlaybackOfChapterWithIdentifier:(NSString *)identifier {
+    
+    if (!identifier) {
+        return;
+    }
+    
+    YHVScene *scene = [self sceneWithType:YHVRequestScene forChapter:identifier];
+    self.chapterPlaybackStartDates[identifier] = @(CFAbsoluteTimeGetCurrent());
+    [scene setPlaying];
+    
+    if (self.traceRecorder) {
+        [self.traceRecorder setName:YHVTraceTrackName((id)scene.data, identifier) forTrack:identifier];
+        [self.traceRecorder beginSpanWithName:YHVSceneTypeName(YHVRequestScene) category:@"playback" onTrack:identifier];
+    }
+}
+
 - (YHVScene *)sceneWithType:(YHVSceneType)type forChapter:(NSString *)identifier {
     
     YHVScene *sceneByType = nil;
     
-    for (YHVScene *scene in self.scenes) {
-        if (scene.played || scene.type != type || ![scene.identifier isEqualToString:identifier]) {
+    for (YHVScene *scene in self.chapterScenes[identifier]) {
+        if (scene.played || scene.type != type) {
             continue;
         }
         
@@ -836,7 +1876,7 @@
 
 - (void)beginRecordingRequest:(NSURLRequest *)request {
 
-    if (![request.YHV_cassetteIdentifier isEqualToString:self.identifier] || request.YHV_VCRIgnored || request.YHV_cassetteChapterIdentifier) {
+    if (![self shouldRecordRequest:request]) {
         return;
     }
 
@@ -854,13 +1894,16 @@
     
     if (filteredRequest) {
         [self recordScene:[YHVScene sceneWithIdentifier:identifier type:YHVRequestScene data:filteredRequest]];
+        
+        [self.traceRecorder setName:YHVTraceTrackName(filteredRequest, identifier) forTrack:identifier];
+        [self.traceRecorder beginSpanWithName:YHVSceneTypeName(YHVRequestScene) category:@"record" onTrack:identifier];
     }
 }
 
 
 - (void)recordResponse:(NSURLResponse *)response forRequest:(NSURLRequest *)request {
     
-    if (![request.YHV_cassetteIdentifier isEqualToString:self.identifier] || request.YHV_VCRIgnored || request.YHV_cassetteChapterIdentifier) {
+    if (![self shouldRecordRequest:request]) {
         return;
     }
 
@@ -869,16 +1912,7 @@
     
     dispatch_sync(self.resourceAccessQueue, ^{
         identifier = self.requestsIdentifiers[request.YHV_identifier];
-        
-        for (YHVScene *scene in self.scenes) {
-            if ([scene.identifier isEqualToString:identifier] && scene.type == YHVRequestScene) {
-                requestScene = scene;
-            }
-            
-            if (requestScene) {
-                break;
-            }
-        }
+        requestScene = identifier ? [self recordedSceneWithType:YHVRequestScene forChapter:identifier] : nil;
     });
     
     if (!identifier) {
@@ -888,65 +1922,129 @@
     NSURLResponse *filteredResponse = self.configuration.beforeRecordResponse((id)requestScene.data, (id)response, nil).firstObject;
     
     [self recordScene:[YHVScene sceneWithIdentifier:identifier type:YHVResponseScene data:filteredResponse]];
+    
+    if (self.traceRecorder) {
+        NSDictionary *arguments = nil;
+        
+        if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+            arguments = @{ @"status": @(((NSHTTPURLResponse *)response).statusCode) };
+        }
+        
+        [self.traceRecorder endSpanWithName:YHVSceneTypeName(YHVRequestScene) onTrack:identifier arguments:arguments];
+        [self.traceRecorder beginSpanWithName:YHVSceneTypeName(YHVDataScene) category:@"record" onTrack:identifier];
+    }
 }
 
 - (void)recordData:(NSData *)data forRequest:(NSURLRequest *)request {
     
-    if (![request.YHV_cassetteIdentifier isEqualToString:self.identifier] || request.YHV_VCRIgnored || request.YHV_cassetteChapterIdentifier) {
+    if (![self shouldRecordRequest:request]) {
         return;
     }
 
-    __block YHVScene *responseScene = nil;
-    __block YHVScene *requestScene = nil;
-    __block NSString *identifier = nil;
+    NSUInteger spillThreshold = self.configuration.spillToDiskThreshold;
     
     dispatch_sync(self.resourceAccessQueue, ^{
-        identifier = self.requestsIdentifiers[request.YHV_identifier];
+        NSString *identifier = self.requestsIdentifiers[request.YHV_identifier];
         
-        for (YHVScene *scene in self.scenes) {
-            if ([scene.identifier isEqualToString:identifier]) {
-                if (scene.type == YHVRequestScene) {
-                    requestScene = scene;
-                } else if (scene.type == YHVResponseScene) {
-                    responseScene = scene;
-                }
-            }
-            
-            if (requestScene && responseScene) {
-                break;
-            }
+        if (!identifier) {
+            return;
         }
-    });
-    
-    if (!identifier) {
-        return;
-    }
-    
-    NSArray *filteredResponse = self.configuration.beforeRecordResponse((id)requestScene.data, (id)responseScene.data, data);
-    
-    if (filteredResponse.count == 2) {
-        data = filteredResponse.lastObject;
         
-        [self recordScene:[YHVScene sceneWithIdentifier:identifier type:YHVDataScene data:data]];
-    }
+        NSMutableData *buffer = self.recordedDataBuffers[identifier];
+        NSFileHandle *file = self.recordedDataFiles[identifier];
+        self->_counters.recordedBytesCount += data.length;
+        
+        if (file) {
+            [file writeData:data];
+            return;
+        }
+        
+        if (!buffer) {
+            buffer = [NSMutableData new];
+            self.recordedDataBuffers[identifier] = buffer;
+        }
+        
+        if (data.length) {
+            [buffer appendData:data];
+        }
+        
+        if (spillThreshold > 0 && buffer.length > spillThreshold) {
+            [self moveRecordedDataToFileForChapterWithIdentifier:identifier];
+        }
+    });
 }
 
 - (void)recordCompletionWithError:(NSError *)error forRequest:(NSURLRequest *)request {
     
-    if (![request.YHV_cassetteIdentifier isEqualToString:self.identifier] || request.YHV_VCRIgnored || request.YHV_cassetteChapterIdentifier) {
+    if (![self shouldRecordRequest:request]) {
         return;
     }
 
+    __block YHVScene *responseScene = nil;
+    __block YHVScene *requestScene = nil;
     __block NSString *identifier = nil;
+    __block NSString *dataPath = nil;
+    __block NSData *data = nil;
+    
     dispatch_sync(self.resourceAccessQueue, ^{
         identifier = self.requestsIdentifiers[request.YHV_identifier];
         [self.requestsIdentifiers removeObjectForKey:request.YHV_identifier];
+        
+        if (identifier) {
+            data = self.recordedDataBuffers[identifier];
+            dataPath = self.recordedDataPaths[identifier];
+            [self.recordedDataFiles[identifier] closeFile];
+            
+            [self.recordedDataBuffers removeObjectForKey:identifier];
+            [self.recordedDataFiles removeObjectForKey:identifier];
+            [self.recordedDataPaths removeObjectForKey:identifier];
+            
+            requestScene = [self recordedSceneWithType:YHVRequestScene forChapter:identifier];
+        }
+        
+        if (data || dataPath) {
+            responseScene = [self recordedSceneWithType:YHVResponseScene forChapter:identifier];
+        }
     });
     
     if (!identifier) {
         return;
     }
     
+    // Streamed request body has been captured during transfer, so filters can be applied to it now.
+    if (requestScene && request.YHV_tag.HTTPBodyPath) {
+        NSURLRequest *filteredRequest = self.configuration.beforeRecordRequest(request);
+        
+        if (filteredRequest) {
+            YHVScene *scene = [YHVScene sceneWithIdentifier:identifier type:YHVRequestScene data:filteredRequest];
+            
+            [self replaceRecordedScene:requestScene withScene:scene];
+            requestScene = scene;
+        }
+    }
+    
+    if (dataPath) {
+        data = [NSData dataWithContentsOfFile:dataPath options:NSDataReadingMappedAlways error:nil] ?: [NSData new];
+    }
+    
+    if (data) {
+        NSArray *filteredResponse = self.configuration.beforeRecordResponse((id)requestScene.data, (id)responseScene.data, data);
+        
+        if (filteredResponse.count == 2) {
+            NSData *filteredData = filteredResponse.lastObject;
+            YHVScene *dataScene = nil;
+            
+            // Keep using temporary file if filters didn't change received response body.
+            if (dataPath && filteredData == data) {
+                dataScene = [YHVScene sceneWithIdentifier:identifier type:YHVDataScene dataAtPath:dataPath];
+            } else if (dataPath) {
+                [NSFileManager.defaultManager removeItemAtPath:dataPath error:nil];
+            }
+            
+            [self recordScene:(dataScene ?: [YHVScene sceneWithIdentifier:identifier type:YHVDataScene data:filteredData])];
+        }
+    }
+    
     if (error) {
         error = [self errorForRequest:request withFilteredUserInfo:error];
     }
@@ -954,11 +2052,22 @@
     YHVSceneType sceneType = (error ? YHVErrorScene : YHVClosingScene);
     
     [self recordScene:[YHVScene sceneWithIdentifier:identifier type:sceneType data:error]];
+    
+    if (self.traceRecorder) {
+        [self.traceRecorder endSpanWithName:YHVSceneTypeName(YHVRequestScene) onTrack:identifier arguments:nil];
+        [self.traceRecorder endSpanWithName:YHVSceneTypeName(YHVDataScene) onTrack:identifier arguments:@{ @"bytes": @(data.length) }];
+        [self.traceRecorder markEventWithName:YHVSceneTypeName(sceneType)
+                                     category:@"record"
+                                      onTrack:identifier
+                                    arguments:(error ? @{ @"error": @(error.code) } : nil)];
+    }
 }
 
 - (void)clearFetchedDataForRequest:(NSURLRequest *)request {
     
-    if (![request.YHV_cassetteIdentifier isEqualToString:self.identifier] || request.YHV_VCRIgnored) {
+    YHVRequestTag *tag = request.YHV_tag;
+    
+    if (![tag.cassetteIdentifier isEqualToString:self.identifier] || tag.VCRIgnored) {
         return;
     }
 
@@ -972,39 +2081,242 @@
     }
     
     dispatch_async(self.resourceAccessQueue, ^{
-        NSMutableArray *dataScenes = [NSMutableArray new];
+        NSMutableArray<NSNumber *> *chapterSceneIndices = self.recordedChapterSceneIndices[identifier];
+        NSMutableArray<YHVScene *> *chapterScenes = self.chapterScenes[identifier];
+        NSIndexSet *dataScenesIndices = [chapterScenes indexesOfObjectsPassingTest:^BOOL(YHVScene *scene, NSUInteger __unused idx,
+                                                                                         BOOL * __unused stop) {
+            return scene.type == YHVDataScene;
+        }];
         
-        for (YHVScene *responseDataScene in self.scenes) {
-            if (responseDataScene.type == YHVDataScene && [responseDataScene.identifier isEqualToString:identifier]) {
-                [dataScenes addObject:responseDataScene];
-            }
+        [self.recordedDataFiles[identifier] closeFile];
+        
+        if (self.recordedDataPaths[identifier]) {
+            [NSFileManager.defaultManager removeItemAtPath:self.recordedDataPaths[identifier] error:nil];
         }
         
-        [self.scenes removeObjectsInArray:dataScenes];
+        [self.recordedDataBuffers removeObjectForKey:identifier];
+        [self.recordedDataFiles removeObjectForKey:identifier];
+        [self.recordedDataPaths removeObjectForKey:identifier];
+        
+        if (dataScenesIndices.count) {
+            for (NSNumber *sceneIndex in [chapterSceneIndices objectsAtIndexes:dataScenesIndices]) {
+                self.recordedScenes[sceneIndex.unsignedIntegerValue] = [NSNull null];
+            }
+            
+            [chapterSceneIndices removeObjectsAtIndexes:dataScenesIndices];
+            [chapterScenes removeObjectsAtIndexes:dataScenesIndices];
+            [self.responseEntries removeObjectForKey:identifier];
+            self.responsesSnapshot = nil;
+        }
     });
 }
 
+- (BOOL)shouldRecordRequest:(NSURLRequest *)request {
+    
+    YHVRequestTag *tag = request.YHV_tag;
+    
+    return [tag.cassetteIdentifier isEqualToString:self.identifier] && !tag.VCRIgnored && !tag.cassetteChapterIdentifier;
+}
+
+- (YHVScene *)recordedSceneWithType:(YHVSceneType)type forChapter:(NSString *)identifier {
+    
+    YHVScene *sceneByType = nil;
+    
+    for (YHVScene *scene in self.chapterScenes[identifier]) {
+        if (scene.type == type) {
+            sceneByType = scene;
+            break;
+        }
+    }
+    
+    return sceneByType;
+}
+
+- (void)moveRecordedDataToFileForChapterWithIdentifier:(NSString *)identifier {
+    
+    NSString *path = [self temporaryFilePath];
+    
+    if (![NSFileManager.defaultManager createFileAtPath:path contents:self.recordedDataBuffers[identifier] attributes:nil]) {
+        return;
+    }
+    
+    NSFileHandle *file = [NSFileHandle fileHandleForWritingAtPath:path];
+    [file seekToEndOfFile];
+    
+    if (file) {
+        self.recordedDataFiles[identifier] = file;
+        self.recordedDataPaths[identifier] = path;
+        [self.recordedDataBuffers removeObjectForKey:identifier];
+    }
+}
+
 - (void)recordScene:(YHVScene *)scene {
     
     NSAssert(!self.isWriteProtected, @"Cassette is write protected. Unable to write new data: %@ (%@)", scene.data,
              ((NSURLRequest *)scene.data).HTTPMethod.uppercaseString);
     
+    NSUInteger spillThreshold = self.configuration.spillToDiskThreshold;
+    
+    if (scene.type == YHVDataScene && !scene.dataPath && spillThreshold > 0 && ((NSData *)scene.data).length > spillThreshold) {
+        NSString *path = [self temporaryFilePath];
+        
+        if ([(NSData *)scene.data writeToFile:path atomically:NO]) {
+            scene = [YHVScene sceneWithIdentifier:scene.identifier type:scene.type dataAtPath:path] ?: scene;
+        }
+    }
+    
     dispatch_async(self.resourceAccessQueue, ^{
+        NSMutableArray<NSNumber *> *chapterSceneIndices = self.recordedChapterSceneIndices[scene.identifier];
         NSUInteger nextSceneIndex = [self nextNotPlayedSceneIndex];
+        NSUInteger scenesCount = self.scenes.count;
         [scene setPlayed];
         self.dirty = YES;
         
-        if (nextSceneIndex == NSNotFound || nextSceneIndex + 1 == self.scenes.count) {
-            [self.scenes addObject:scene];
+        if (scene.type == YHVErrorScene || scene.type == YHVClosingScene) {
+            atomic_fetch_add(&self->_playedChaptersCount, 1);
+        }
+        
+        if (!chapterSceneIndices) {
+            chapterSceneIndices = [NSMutableArray new];
+            self.recordedChapterSceneIndices[scene.identifier] = chapterSceneIndices;
+        }
+        
+        // Recorded scene will be placed on tape before first not played scene.
+        if (nextSceneIndex == NSNotFound || nextSceneIndex + 1 == scenesCount) {
+            nextSceneIndex = scenesCount;
+        }
+        
+        [chapterSceneIndices addObject:@(self.recordedScenes.count)];
+        [self.recordedScenesTapeIndices addObject:@(nextSceneIndex)];
+        [self.recordedScenes addObject:scene];
+        [self addSceneToChapterIndex:scene];
+    });
+}
+
+- (void)replaceRecordedScene:(YHVScene *)scene withScene:(YHVScene *)newScene {
+    
+    [newScene setPlayed];
+    
+    dispatch_async(self.resourceAccessQueue, ^{
+        NSMutableArray<NSNumber *> *chapterSceneIndices = self.recordedChapterSceneIndices[scene.identifier];
+        NSMutableArray<YHVScene *> *chapterScenes = self.chapterScenes[scene.identifier];
+        NSUInteger chapterSceneIndex = [chapterScenes indexOfObjectIdenticalTo:scene];
+        
+        if (chapterSceneIndex == NSNotFound || chapterSceneIndex >= chapterSceneIndices.count) {
+            return;
+        }
+        
+        self.recordedScenes[chapterSceneIndices[chapterSceneIndex].unsignedIntegerValue] = newScene;
+        [chapterScenes replaceObjectAtIndex:chapterSceneIndex withObject:newScene];
+        self.dirty = YES;
+        
+        if (scene.type == YHVRequestScene) {
+            NSUInteger requestSceneIndex = [self.requestScenes indexOfObjectIdenticalTo:scene];
+            
+            if (requestSceneIndex != NSNotFound) {
+                [self.requestScenes replaceObjectAtIndex:requestSceneIndex withObject:newScene];
+            }
+            
+            self.requestsSnapshot = nil;
         } else {
-            [self.scenes insertObject:scene atIndex:nextSceneIndex];
+            NSUInteger responseSceneIndex = [self.responseScenes indexOfObjectIdenticalTo:scene];
+            
+            if (responseSceneIndex != NSNotFound) {
+                [self.responseScenes replaceObjectAtIndex:responseSceneIndex withObject:newScene];
+            }
+            
+            [self.responseEntries removeObjectForKey:scene.identifier];
+            self.responsesSnapshot = nil;
         }
     });
 }
 
 
+#pragma mark - Memory management
+
+- (void)retainDataOfPlayedChapterWithIdentifier:(NSString *)identifier {
+    
+    if (!self.playedScenesMemoryBudget || self.retainedChapterSizes[identifier]) {
+        return;
+    }
+    
+    NSUInteger size = 0;
+    
+    for (YHVScene *scene in self.chapterScenes[identifier]) {
+        size += scene.estimatedDataSize;
+    }
+    
+    [self.retainedChapterIdentifiers addObject:identifier];
+    self.retainedChapterSizes[identifier] = @(size);
+    self.playedScenesMemoryUsage += size;
+    
+    while (self.playedScenesMemoryUsage > self.playedScenesMemoryBudget && self.retainedChapterIdentifiers.count) {
+        NSString *releasedChapterIdentifier = self.retainedChapterIdentifiers.firstObject;
+        
+        self.playedScenesMemoryUsage -= self.retainedChapterSizes[releasedChapterIdentifier].unsignedIntegerValue;
+        [self.retainedChapterSizes removeObjectForKey:releasedChapterIdentifier];
+        [self.retainedChapterIdentifiers removeObjectAtIndex:0];
+        
+        [self releaseDataOfChapterWithIdentifier:releasedChapterIdentifier];
+    }
+}
+
+- (void)releaseDataOfChapterWithIdentifier:(NSString *)identifier {
+    
+    for (YHVScene *scene in self.chapterScenes[identifier]) {
+        if (scene.isSerialized && !scene.isDataReleased) {
+            [scene releaseData];
+        }
+    }
+}
+
+- (BOOL)restoreDataOfScenes:(NSArray<YHVScene *> *)scenes {
+    
+    NSMutableArray<YHVScene *> *releasedScenes = [NSMutableArray new];
+    
+    for (YHVScene *scene in scenes) {
+        if (scene.isDataReleased) {
+            [releasedScenes addObject:scene];
+        }
+    }
+    
+    if (!releasedScenes.count) {
+        return YES;
+    }
+    
+    NSArray<NSDictionary *> *content = [self contentOfCassetteFile];
+    BOOL restored = YES;
+    
+    if (content.count != self.loadedScenes.count) {
+        return NO;
+    }
+    
+    for (YHVScene *scene in releasedScenes) {
+        NSNumber *sceneIdx = [self.loadedSceneIndices objectForKey:scene];
+        NSDictionary *sceneDictionary = sceneIdx ? content[sceneIdx.unsignedIntegerValue] : nil;
+        id serializedData = [sceneDictionary isKindOfClass:[NSDictionary class]] ? sceneDictionary[@"data"] : nil;
+        
+        if (!serializedData || ![sceneDictionary[@"id"] isEqual:scene.identifier]) {
+            restored = NO;
+            continue;
+        }
+        
+        [scene restoreSerializedData:serializedData];
+    }
+    
+    return restored;
+}
+
+
 #pragma mark - Misc
 
+- (NSString *)temporaryFilePath {
+    
+    [NSFileManager.defaultManager createDirectoryAtPath:self.temporaryDirectoryPath withIntermediateDirectories:YES attributes:nil error:nil];
+    
+    return [self.temporaryDirectoryPath stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+}
+
 - (NSError *)errorForRequest:(NSURLRequest *)request withFilteredUserInfo:(NSError *)error {
     
     NSMutableDictionary *errorUserInfo = [error.userInfo mutableCopy];
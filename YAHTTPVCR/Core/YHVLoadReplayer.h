@@ -0,0 +1,91 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class YHVLoadReplayReport;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      Cassette-driven load replayer.
+ * @discussion Replayer use recorded cassette as load profile: chapter's requests sent to target service (for example to local stand-in
+ *             service) and received responses compared with recorded response scenes.
+ *             Requests sent through Foundation URL loading system, so cassette should be ejected from VCR before replay.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVLoadReplayer : NSObject
+
+
+#pragma mark Information
+
+/**
+ * @brief      Stores number of requests which can be sent to target service at the same time.
+ * @discussion By default set to: \c 1.
+ */
+@property (nonatomic, assign) NSUInteger concurrency;
+
+/**
+ * @brief      Stores how many times cassette's requests should be replayed.
+ * @discussion By default set to: \c 1.
+ */
+@property (nonatomic, assign) NSUInteger repeatCount;
+
+/**
+ * @brief      Stores maximum number of requests which can be started per second.
+ * @discussion If set to \c 0 (default), requests started as soon as there is free slot (limited by \c concurrency).
+ */
+@property (nonatomic, assign) NSUInteger requestsPerSecond;
+
+/**
+ * @brief      Stores whether response body should be compared with recorded data scenes or not.
+ * @discussion Status code always compared. Body comparison should be disabled if \c responseBodyFilter has been used during record.
+ *             By default set to: \c YES.
+ */
+@property (nonatomic, assign) BOOL compareResponseBodies;
+
+/**
+ * @brief  Stores number of cassette's requests which will be sent during single replay pass.
+ */
+@property (nonatomic, readonly, assign) NSUInteger requestsCount;
+
+/**
+ * @brief      Stores number of cassette's chapters which won't be replayed because they are malformed.
+ * @discussion Chapter skipped if it's request scene is missing or can't be decoded, if any of it's scenes has been stored before
+ *             request scene or if chapter doesn't have response or error scene.
+ */
+@property (nonatomic, readonly, assign) NSUInteger skippedChaptersCount;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief      Create and configure load replayer.
+ * @discussion Recorded request's path and query appended to \c url, so scheme, host and port of recorded requests replaced.
+ *
+ * @param path Full path to cassette's file (\c .json or \c .plist).
+ * @param url  Reference on URL of service which should receive requests.
+ *
+ * @return Configured and ready to use replayer or \c nil in case if cassette can't be read.
+ */
++ (nullable instancetype)replayerWithCassetteAtPath:(NSString *)path targetURL:(NSURL *)url;
+
+
+#pragma mark - Replay
+
+/**
+ * @brief  Replay cassette's requests against target service.
+ *
+ * @param block Reference on block which will be called on background queue with replay results.
+ */
+- (void)replayWithCompletion:(void(^)(YHVLoadReplayReport *report))block;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,411 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVLoadReplayer.h"
+#import "YHVLoadReplayReport+Private.h"
+#import "YHVScene.h"
+
+
+#pragma mark Constants
+
+/**
+ * @brief  Stores maximum number of mismatches for which description will be stored in report.
+ */
+static NSUInteger const kYHVLoadReplayerMaximumMismatchDescriptions = 100;
+
+
+#pragma mark - Private interface declaration
+
+@interface YHVLoadReplayer ()
+
+
+#pragma mark - Information
+
+/**
+ * @brief      Stores reference on list of cassette's chapters.
+ * @discussion Each entry contain \c request (\a NSURLRequest) and recorded \c response (\a NSHTTPURLResponse), \c data (\a NSData) or
+ *             \c error (\a NSError).
+ */
+@property (nonatomic, copy) NSArray<NSDictionary *> *chapters;
+
+@property (nonatomic, assign) NSUInteger skippedChaptersCount;
+
+/**
+ * @brief  Stores reference on URL of service which should receive requests.
+ */
+@property (nonatomic, copy) NSURL *targetURL;
+
+/**
+ * @brief  Stores reference on queue which is used to serialize access to replay results.
+ */
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize load replayer.
+ *
+ * @param chapters Reference on list of cassette's chapters.
+ * @param url      Reference on URL of service which should receive requests.
+ *
+ * @return Initialized and ready to use replayer.
+ */
+- (instancetype)initWithChapters:(NSArray<NSDictionary *> *)chapters targetURL:(NSURL *)url;
+
+
+#pragma mark - Cassette
+
+/**
+ * @brief      Read cassette's scenes and group them by chapters.
+ * @discussion Malformed chapters not included into list and only counted.
+ *
+ * @param path         Full path to cassette's file.
+ * @param skippedCount Reference on variable which will store number of malformed chapters.
+ *
+ * @return List of cassette's chapters or \c nil in case if cassette can't be read.
+ */
++ (nullable NSArray<NSDictionary *> *)chaptersFromCassetteAtPath:(NSString *)path skippedChaptersCount:(NSUInteger *)skippedCount;
+
+/**
+ * @brief  Check whether scene can be created from passed dictionary.
+ *
+ * @param dictionary Reference on scene's dictionary representation from cassette's file.
+ *
+ * @return Whether dictionary contain all required scene fields or not.
+ */
++ (BOOL)isValidSceneDictionary:(id)dictionary;
+
+
+#pragma mark - Replay
+
+/**
+ * @brief  Compose request which should be sent to target service.
+ *
+ * @param request Reference on recorded request.
+ *
+ * @return Request with target service's URL.
+ */
+- (NSURLRequest *)targetRequestForRequest:(NSURLRequest *)request;
+
+/**
+ * @brief  Compare received response with recorded chapter's response.
+ *
+ * @param chapter  Reference on chapter with which response should be compared.
+ * @param response Reference on received response.
+ * @param data     Reference on received response body.
+ * @param error    Reference on request processing error.
+ *
+ * @return Mismatch description or \c nil in case if response match to recorded.
+ */
+- (nullable NSString *)mismatchForChapter:(NSDictionary *)chapter
+                             withResponse:(nullable NSURLResponse *)response
+                                     data:(nullable NSData *)data
+                                    error:(nullable NSError *)error;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVLoadReplayer
+
+
+#pragma mark - Information
+
+- (NSUInteger)requestsCount {
+
+    return self.chapters.count;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)replayerWithCassetteAtPath:(NSString *)path targetURL:(NSURL *)url {
+
+    NSUInteger skippedChaptersCount = 0;
+    NSArray<NSDictionary *> *chapters = [self chaptersFromCassetteAtPath:path skippedChaptersCount:&skippedChaptersCount];
+
+    if (!chapters || !url) {
+        return nil;
+    }
+
+    YHVLoadReplayer *replayer = [[self alloc] initWithChapters:chapters targetURL:url];
+    replayer.skippedChaptersCount = skippedChaptersCount;
+
+    return replayer;
+}
+
+- (instancetype)initWithChapters:(NSArray<NSDictionary *> *)chapters targetURL:(NSURL *)url {
+
+    if ((self = [super init])) {
+        _resourceAccessQueue = dispatch_queue_create("com.yetanotherhttpvcr.load-replayer", DISPATCH_QUEUE_SERIAL);
+        _compareResponseBodies = YES;
+        _chapters = [chapters copy];
+        _targetURL = [url copy];
+        _repeatCount = 1;
+        _concurrency = 1;
+    }
+
+    return self;
+}
+
+
+#pragma mark - Cassette
+
++ (NSArray<NSDictionary *> *)chaptersFromCassetteAtPath:(NSString *)path skippedChaptersCount:(NSUInteger *)skippedCount {
+
+    NSArray<NSDictionary *> *content = nil;
+
+    if ([[path pathExtension] isEqualToString:@"json"]) {
+        NSData *jsonData = [NSData dataWithContentsOfFile:path];
+        content = jsonData ? [NSJSONSerialization JSONObjectWithData:jsonData options:NSJSONReadingAllowFragments error:nil] : nil;
+    } else {
+        content = [NSArray arrayWithContentsOfFile:path];
+    }
+
+    if (![content isKindOfClass:[NSArray class]]) {
+        return nil;
+    }
+
+    NSMutableDictionary<NSString *, NSMutableDictionary *> *chaptersByIdentifier = [NSMutableDictionary new];
+    NSMutableOrderedSet<NSString *> *identifiers = [NSMutableOrderedSet new];
+    NSMutableSet<NSString *> *malformedIdentifiers = [NSMutableSet new];
+    NSMutableArray<NSDictionary *> *chapters = [NSMutableArray new];
+
+    for (NSDictionary *sceneDictionary in content) {
+        if (![self isValidSceneDictionary:sceneDictionary]) {
+            if ([sceneDictionary isKindOfClass:[NSDictionary class]] && [sceneDictionary[@"id"] isKindOfClass:[NSString class]]) {
+                [malformedIdentifiers addObject:sceneDictionary[@"id"]];
+                [identifiers addObject:sceneDictionary[@"id"]];
+            }
+
+            continue;
+        }
+
+        YHVScene *scene = [YHVScene YHV_objectFromDictionary:sceneDictionary];
+        NSMutableDictionary *chapter = chaptersByIdentifier[scene.identifier];
+        id data = scene.data;
+        BOOL malformed = NO;
+
+        [identifiers addObject:scene.identifier];
+
+        if ([malformedIdentifiers containsObject:scene.identifier]) {
+            continue;
+        }
+
+        if (scene.type == YHVRequestScene) {
+            malformed = chapter || ![data isKindOfClass:[NSURLRequest class]];
+
+            if (!malformed) {
+                chaptersByIdentifier[scene.identifier] = [NSMutableDictionary dictionaryWithObject:data forKey:@"request"];
+            }
+        } else if (!chapter) {
+            // Scenes which has been stored before chapter's request can't be compared with received response.
+            malformed = YES;
+        } else if (scene.type == YHVResponseScene) {
+            malformed = ![data isKindOfClass:[NSHTTPURLResponse class]];
+            chapter[@"response"] = malformed ? nil : data;
+        } else if (scene.type == YHVDataScene && data) {
+            malformed = ![data isKindOfClass:[NSData class]];
+
+            if (!malformed && ((NSData *)data).length) {
+                NSMutableData *body = chapter[@"data"] ?: [NSMutableData new];
+                [body appendData:(NSData *)data];
+                chapter[@"data"] = body;
+            }
+        } else if (scene.type == YHVErrorScene) {
+            malformed = ![data isKindOfClass:[NSError class]];
+            chapter[@"error"] = malformed ? nil : data;
+        }
+
+        if (malformed) {
+            [malformedIdentifiers addObject:scene.identifier];
+        }
+    }
+
+    for (NSString *identifier in identifiers) {
+        NSDictionary *chapter = chaptersByIdentifier[identifier];
+
+        if (chapter && ![malformedIdentifiers containsObject:identifier] && (chapter[@"response"] || chapter[@"error"])) {
+            [chapters addObject:chapter];
+        }
+    }
+
+    if (skippedCount) {
+        *skippedCount = identifiers.count - chapters.count;
+    }
+
+    return chapters;
+}
+
++ (BOOL)isValidSceneDictionary:(id)dictionary {
+
+    if (![dictionary isKindOfClass:[NSDictionary class]] || ![dictionary[@"type"] isKindOfClass:[NSNumber class]] ||
+        ![dictionary[@"id"] isKindOfClass:[NSString class]] || !((NSString *)dictionary[@"id"]).length) {
+
+        return NO;
+    }
+
+    NSUInteger type = ((NSNumber *)dictionary[@"type"]).unsignedIntegerValue;
+
+    if (type > YHVClosingScene) {
+        return NO;
+    }
+
+    return dictionary[@"data"] || type == YHVDataScene || type == YHVClosingScene;
+}
+
+
+#pragma mark - Replay
+
+- (void)replayWithCompletion:(void(^)(YHVLoadReplayReport *report))block {
+
+    NSAssert(block, @"Replay error. Completion block not provided.");
+
+    NSUInteger concurrency = MAX(self.concurrency, 1);
+    NSUInteger requestsPerSecond = self.requestsPerSecond;
+    NSUInteger count = self.chapters.count * self.repeatCount;
+    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+    configuration.HTTPMaximumConnectionsPerHost = (NSInteger)concurrency;
+    configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+    configuration.URLCache = nil;
+
+    NSURLSession *session = [NSURLSession sessionWithConfiguration:configuration];
+    dispatch_semaphore_t slots = dispatch_semaphore_create((long)concurrency);
+    NSMutableArray<NSString *> *mismatches = [NSMutableArray new];
+    NSMutableArray<NSNumber *> *latencies = [NSMutableArray new];
+    dispatch_group_t group = dispatch_group_create();
+    __block NSUInteger mismatchedCount = 0;
+    __block NSUInteger failedCount = 0;
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        CFAbsoluteTime startDate = CFAbsoluteTimeGetCurrent();
+
+        for (NSUInteger requestIdx = 0; requestIdx < count; requestIdx++) {
+            NSDictionary *chapter = self.chapters[requestIdx % self.chapters.count];
+            NSURLRequest *request = [self targetRequestForRequest:chapter[@"request"]];
+
+            dispatch_semaphore_wait(slots, DISPATCH_TIME_FOREVER);
+
+            if (requestsPerSecond) {
+                CFAbsoluteTime delay = startDate + (double)requestIdx / requestsPerSecond - CFAbsoluteTimeGetCurrent();
+
+                if (delay > 0.f) {
+                    [NSThread sleepForTimeInterval:delay];
+                }
+            }
+
+            CFAbsoluteTime requestDate = CFAbsoluteTimeGetCurrent();
+            dispatch_group_enter(group);
+
+            [[session dataTaskWithRequest:request
+                        completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+
+                CFAbsoluteTime latency = CFAbsoluteTimeGetCurrent() - requestDate;
+                NSString *mismatch = [self mismatchForChapter:chapter withResponse:response data:data error:error];
+
+                dispatch_sync(self.resourceAccessQueue, ^{
+                    if (error && !chapter[@"error"]) {
+                        failedCount++;
+                    } else {
+                        [latencies addObject:@(latency)];
+                    }
+
+                    if (mismatch) {
+                        mismatchedCount++;
+
+                        if (mismatches.count < kYHVLoadReplayerMaximumMismatchDescriptions) {
+                            [mismatches addObject:mismatch];
+                        }
+                    }
+                });
+
+                dispatch_semaphore_signal(slots);
+                dispatch_group_leave(group);
+            }] resume];
+        }
+
+        dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+        [session finishTasksAndInvalidate];
+
+        __block YHVLoadReplayReport *report = nil;
+        dispatch_sync(self.resourceAccessQueue, ^{
+            report = [YHVLoadReplayReport reportWithLatencies:latencies
+                                                requestsCount:count
+                                          failedRequestsCount:failedCount
+                                     mismatchedResponsesCount:mismatchedCount
+                                                   mismatches:mismatches
+                                                     duration:CFAbsoluteTimeGetCurrent() - startDate];
+        });
+
+        block(report);
+    });
+}
+
+- (NSURLRequest *)targetRequestForRequest:(NSURLRequest *)request {
+
+    NSURLComponents *components = [NSURLComponents componentsWithURL:request.URL resolvingAgainstBaseURL:YES];
+    NSString *targetURLString = self.targetURL.absoluteString;
+
+    while ([targetURLString hasSuffix:@"/"]) {
+        targetURLString = [targetURLString substringToIndex:targetURLString.length - 1];
+    }
+
+    NSMutableString *urlString = [NSMutableString stringWithString:targetURLString];
+    [urlString appendString:components.percentEncodedPath.length ? components.percentEncodedPath : @"/"];
+
+    if (components.percentEncodedQuery) {
+        [urlString appendFormat:@"?%@", components.percentEncodedQuery];
+    }
+
+    NSMutableURLRequest *targetRequest = [request mutableCopy];
+    targetRequest.URL = [NSURL URLWithString:urlString];
+
+    return targetRequest;
+}
+
+- (NSString *)mismatchForChapter:(NSDictionary *)chapter
+                    withResponse:(NSURLResponse *)response
+                            data:(NSData *)data
+                           error:(NSError *)error {
+
+    NSURLRequest *request = chapter[@"request"];
+    NSHTTPURLResponse *recordedResponse = chapter[@"response"];
+    NSError *recordedError = chapter[@"error"];
+    NSString *prefix = [NSString stringWithFormat:@"%@ %@", request.HTTPMethod, request.URL.absoluteString];
+
+    if (!recordedResponse && recordedError) {
+        return error ? nil : [NSString stringWithFormat:@"%@: expected error %@ (%@), received response", prefix,
+                              recordedError.domain, @(recordedError.code)];
+    }
+
+    if (error) {
+        return [NSString stringWithFormat:@"%@: expected response, received error %@ (%@)", prefix, error.domain, @(error.code)];
+    }
+
+    NSInteger statusCode = [response isKindOfClass:[NSHTTPURLResponse class]] ? ((NSHTTPURLResponse *)response).statusCode : 0;
+
+    if (recordedResponse && recordedResponse.statusCode != statusCode) {
+        return [NSString stringWithFormat:@"%@: expected status %@, received %@", prefix, @(recordedResponse.statusCode),
+                @(statusCode)];
+    }
+
+    NSData *recordedData = chapter[@"data"];
+
+    if (self.compareResponseBodies && (recordedData.length || data.length) && ![recordedData isEqualToData:data]) {
+        return [NSString stringWithFormat:@"%@: expected %@ bytes body, received different %@ bytes body", prefix,
+                @(recordedData.length), @(data.length)];
+    }
+
+    return nil;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,80 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      Loopback HTTP/1.1 server which replay responses from inserted cassette.
+ * @discussion Server allow to use recorded cassettes with clients which doesn't use Foundation URL loading system (command-line tools,
+ *             helper processes or non-Foundation networking components).
+ *             Each received request matched against currently inserted into \b YHVVCR cassette using same matchers and playback mode
+ *             as \a NSURLSession and \a NSURLConnection requests. Response, data and closing scenes sent back to client using chunked
+ *             transfer encoding. Server support persistent (keep-alive) and concurrent connections.
+ *             Requests for which there is no recorded chapters receive \c 404 response, recorded errors reported with \c 502 response
+ *             (or by connection close if response already has been sent).
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVReplayServer : NSObject
+
+
+#pragma mark Information
+
+/**
+ * @brief      Stores reference on base URL which is used to compose requests for matching against cassette's chapters.
+ * @discussion Received request's path and query appended to this URL. If \c nil, request composed using \c Host header and \c http
+ *             scheme. Requests which use absolute URL as target (proxy style) used as-is.
+ */
+@property (nonatomic, nullable, readonly, copy) NSURL *baseURL;
+
+/**
+ * @brief  Stores whether server is listening for connections or not.
+ */
+@property (nonatomic, readonly, assign, getter = isRunning) BOOL running;
+
+/**
+ * @brief  Stores port on which server is listening for connections (\c 0 if server not running).
+ */
+@property (nonatomic, readonly, assign) uint16_t port;
+
+/**
+ * @brief  Stores reference on URL which can be used by clients to reach server (\c nil if server not running).
+ */
+@property (nonatomic, nullable, readonly, copy) NSURL *URL;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Create and configure replay server.
+ *
+ * @param baseURL Reference on URL of service which has been recorded on cassette.
+ *
+ * @return Configured and ready to use replay server.
+ */
++ (instancetype)serverWithBaseURL:(nullable NSURL *)baseURL;
+
+
+#pragma mark - State
+
+/**
+ * @brief  Start listening for connections on loopback interface.
+ *
+ * @param port Port on which server should listen for connections. Pass \c 0 to let system pick free port.
+ *
+ * @return Whether server has been started or not.
+ */
+- (BOOL)startOnPort:(uint16_t)port;
+
+/**
+ * @brief  Stop listening for new connections and close all active connections.
+ */
+- (void)stop;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,252 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVReplayServer.h"
+#import "YHVReplayConnection.h"
+#import <netinet/in.h>
+#import <sys/socket.h>
+#import <arpa/inet.h>
+#import <unistd.h>
+#import <fcntl.h>
+
+
+#pragma mark Constants
+
+/**
+ * @brief  Stores maximum number of pending connections.
+ */
+static int const kYHVReplayServerBacklog = 128;
+
+
+#pragma mark - Private interface declaration
+
+@interface YHVReplayServer ()
+
+
+#pragma mark - Information
+
+@property (nonatomic, nullable, copy) NSURL *baseURL;
+@property (nonatomic, assign) uint16_t port;
+
+/**
+ * @brief  Stores reference on source which is used to accept new connections on listening socket.
+ */
+@property (nonatomic, nullable, strong) dispatch_source_t acceptSource;
+
+/**
+ * @brief  Stores reference on set of active client connections.
+ */
+@property (nonatomic, strong) NSMutableSet<YHVReplayConnection *> *connections;
+
+/**
+ * @brief  Stores reference on queue which is used to serialize access to server's state.
+ */
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize replay server.
+ *
+ * @param baseURL Reference on URL of service which has been recorded on cassette.
+ *
+ * @return Initialized and ready to use replay server.
+ */
+- (instancetype)initWithBaseURL:(nullable NSURL *)baseURL;
+
+
+#pragma mark - Connections
+
+/**
+ * @brief  Accept pending connections on listening socket.
+ *
+ * @param socket Listening socket descriptor.
+ */
+- (void)acceptConnectionsOnSocket:(int)socket;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVReplayServer
+
+
+#pragma mark - Information
+
+- (BOOL)isRunning {
+
+    __block BOOL running = NO;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        running = self.acceptSource != nil;
+    });
+
+    return running;
+}
+
+- (NSURL *)URL {
+
+    __block uint16_t port = 0;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        port = self.acceptSource ? self.port : 0;
+    });
+
+    return port ? [NSURL URLWithString:[NSString stringWithFormat:@"http://127.0.0.1:%@", @(port)]] : nil;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)serverWithBaseURL:(NSURL *)baseURL {
+
+    return [[self alloc] initWithBaseURL:baseURL];
+}
+
+- (instancetype)initWithBaseURL:(NSURL *)baseURL {
+
+    if ((self = [super init])) {
+        _resourceAccessQueue = dispatch_queue_create("com.yetanotherhttpvcr.replay-server", DISPATCH_QUEUE_SERIAL);
+        _connections = [NSMutableSet new];
+        _baseURL = [baseURL copy];
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+
+    if (_acceptSource) {
+        dispatch_source_cancel(_acceptSource);
+    }
+
+    for (YHVReplayConnection *connection in _connections) {
+        [connection close];
+    }
+}
+
+
+#pragma mark - State
+
+- (BOOL)startOnPort:(uint16_t)port {
+
+    __block BOOL started = NO;
+
+    dispatch_sync(self.resourceAccessQueue, ^{
+        if (self.acceptSource) {
+            started = YES;
+            return;
+        }
+
+        int listeningSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+        if (listeningSocket < 0) {
+            return;
+        }
+
+        int reuseAddress = 1;
+        setsockopt(listeningSocket, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress));
+        fcntl(listeningSocket, F_SETFL, fcntl(listeningSocket, F_GETFL, 0) | O_NONBLOCK);
+
+        struct sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_len = sizeof(address);
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addressLength = sizeof(address);
+
+        if (bind(listeningSocket, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+            listen(listeningSocket, kYHVReplayServerBacklog) != 0 ||
+            getsockname(listeningSocket, (struct sockaddr *)&address, &addressLength) != 0) {
+
+            close(listeningSocket);
+            return;
+        }
+
+        dispatch_source_t source = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, (uintptr_t)listeningSocket, 0,
+                                                          self.resourceAccessQueue);
+        __weak __typeof(self) weakSelf = self;
+
+        dispatch_source_set_event_handler(source, ^{
+            [weakSelf acceptConnectionsOnSocket:listeningSocket];
+        });
+
+        dispatch_source_set_cancel_handler(source, ^{
+            close(listeningSocket);
+        });
+
+        self.port = ntohs(address.sin_port);
+        self.acceptSource = source;
+        dispatch_resume(source);
+        started = YES;
+    });
+
+    return started;
+}
+
+- (void)stop {
+
+    __block NSSet<YHVReplayConnection *> *connections = nil;
+
+    dispatch_sync(self.resourceAccessQueue, ^{
+        if (self.acceptSource) {
+            dispatch_source_cancel(self.acceptSource);
+        }
+
+        connections = [self.connections copy];
+        [self.connections removeAllObjects];
+        self.acceptSource = nil;
+        self.port = 0;
+    });
+
+    for (YHVReplayConnection *connection in connections) {
+        [connection close];
+    }
+}
+
+
+#pragma mark - Connections
+
+- (void)acceptConnectionsOnSocket:(int)socket {
+
+    unsigned long pendingCount = MAX(dispatch_source_get_data(self.acceptSource), 1);
+    __weak __typeof(self) weakSelf = self;
+
+    for (unsigned long connectionIdx = 0; connectionIdx < pendingCount; connectionIdx++) {
+        int clientSocket = accept(socket, NULL, NULL);
+
+        if (clientSocket < 0) {
+            break;
+        }
+
+#ifdef SO_NOSIGPIPE
+        int noSigPipe = 1;
+        setsockopt(clientSocket, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif // SO_NOSIGPIPE
+
+        YHVReplayConnection *connection = [YHVReplayConnection connectionWithSocket:clientSocket
+                                                                            baseURL:self.baseURL
+                                                                       closeHandler:^(YHVReplayConnection *closedConnection) {
+            __strong __typeof(weakSelf) strongSelf = weakSelf;
+
+            if (strongSelf) {
+                dispatch_async(strongSelf.resourceAccessQueue, ^{
+                    [strongSelf.connections removeObject:closedConnection];
+                });
+            }
+        }];
+
+        [self.connections addObject:connection];
+        [connection open];
+    }
+}
+
+#pragma mark -
+
+
+@end
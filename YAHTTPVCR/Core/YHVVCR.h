@@ -78,6 +78,69 @@ NS_ASSUME_NONNULL_BEGIN
 + (void)ejectCassette;
 
 
+#pragma mark - Context
+
+/**
+ * @brief      Insert new or existing cassette into VCR for specified \c context.
+ * @discussion Cassettes inserted for different contexts can be used at the same time (for example by test cases which run in parallel).
+ *             Request handled by cassette which has been inserted for it's context. Context can be bound to session configuration
+ *             (\c +setContext:forSessionConfiguration:) or stamped on request (\c +setContext:forRequest:). Requests w/o context
+ *             handled by cassette inserted with \c +insertCassetteWithPath: or \c +insertCassetteWithConfiguration:.
+ *
+ * @param context Reference on unique context identifier.
+ * @param block   Reference on block which can be used to customize cassette's behaviour. Block pass only one argument - configuration
+ *                object which later will be merged with VCR's configuration and used for cassette.
+ *
+ * @return Reference on cassette which has been inserted into VCR.
+ *
+ * @since 1.6.0
+ */
++ (YHVCassette *)insertCassetteForContext:(NSString *)context withConfiguration:(void(^)(YHVConfiguration *configuration))block;
+
+/**
+ * @brief  Eject cassette which has been inserted for specified \c context.
+ *
+ * @param context Reference on unique context identifier which has been used during cassette insertion.
+ *
+ * @since 1.6.0
+ */
++ (void)ejectCassetteForContext:(NSString *)context;
+
+/**
+ * @brief  Retrieve cassette which has been inserted for specified \c context.
+ *
+ * @param context Reference on unique context identifier which has been used during cassette insertion.
+ *
+ * @return Reference on cassette or \c nil in case if there is no cassette for \c context.
+ *
+ * @since 1.6.0
+ */
++ (nullable YHVCassette *)cassetteForContext:(NSString *)context;
+
+/**
+ * @brief      Bind session configuration to \c context.
+ * @discussion Requests of sessions which will be created with this configuration will be handled by cassette inserted for \c context.
+ *
+ * @param context       Reference on unique context identifier.
+ * @param configuration Reference on configuration which will be used to create session.
+ *
+ * @since 1.6.0
+ */
++ (void)setContext:(NSString *)context forSessionConfiguration:(NSURLSessionConfiguration *)configuration;
+
+/**
+ * @brief      Stamp \c context on request.
+ * @discussion Request will be handled by cassette inserted for \c context. Context can't be changed once set.
+ *             Request can be used as template for multiple tasks: each task get own copy of context and track own progress.
+ *
+ * @param context Reference on unique context identifier.
+ * @param request Reference on request which should be handled by cassette inserted for \c context.
+ *
+ * @since 1.6.0
+ */
++ (void)setContext:(NSString *)context forRequest:(NSMutableURLRequest *)request;
+
+
 #pragma mark - Matchers
 
 /**
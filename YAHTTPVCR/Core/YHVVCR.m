@@ -8,15 +8,21 @@
 #import "NSURLSessionConnection+YHVRecorder.h"
 #import "NSDictionary+YHVNSURLRequest.h"
 #import "NSURLSessionTask+YHVRecorder.h"
-#import "NSMutableDictionary+YHVMisc.h"
 #import "NSURLConnection+YHVRecorder.h"
 #import "YHVConfiguration+Private.h"
 #import "NSURLRequest+YHVPlayer.h"
-#import "NSDictionary+YHVNSURL.h"
+#import "YHVReplacementRuleSet.h"
+#import "YHVTeeInputStream.h"
 #import "YHVPrivateStructures.h"
 #import "YHVCassette+Private.h"
 #import "YHVRequestMatchers.h"
+#import "YHVJSONRedactor.h"
+#import "YHVURLRewriter.h"
+#import "YHVHostsRuleSet.h"
+#import "YHVRequestTag.h"
 #import "YHVNSURLProtocol.h"
+#import <stdatomic.h>
+#import <sched.h>
 
 
 #pragma mark Extern
@@ -40,6 +46,113 @@ YHVMatchers YHVMatcher = {
  */
 static BOOL YHVMatchQueryWithSortedListValue = YES;
 
+/**
+ * @brief      Storage for retained reference on cassette which currently inserted into VCR.
+ * @discussion Reference published with atomic exchange, so it can be read from any thread w/o locks.
+ *
+ * @since 1.6.0
+ */
+static _Atomic(void *) YHVInsertedCassette = NULL;
+
+/**
+ * @brief      Storage for number of readers which currently retain reference on inserted cassette.
+ * @discussion Readers registered in counter which correspond to current \c YHVCassetteReadersEpoch value. When cassette replaced,
+ *             epoch is switched and previous cassette released only after all readers from previous epoch completed.
+ *
+ * @since 1.6.0
+ */
+static atomic_uint YHVCassetteReaders[2];
+
+/**
+ * @brief  Storage for index of readers counter which should be used by new cassette readers.
+ *
+ * @since 1.6.0
+ */
+static atomic_uint YHVCassetteReadersEpoch = 0;
+
+/**
+ * @brief      Storage for retained reference on dictionary which map context to cassette inserted for it.
+ * @discussion Immutable dictionary published with same rules as \c YHVInsertedCassette.
+ *
+ * @since 1.6.0
+ */
+static _Atomic(void *) YHVContextCassettes = NULL;
+
+/**
+ * @brief      Storage for retained reference on dictionary which map identifier of cassette inserted for context to cassette.
+ * @discussion Immutable dictionary published with same rules as \c YHVInsertedCassette.
+ *
+ * @since 1.6.0
+ */
+static _Atomic(void *) YHVIdentifiedCassettes = NULL;
+
+
+#pragma mark - Functions
+
+/**
+ * @brief  Retrieve retained reference on object which has been published in \c storage.
+ *
+ * @param storage Pointer on storage from which object should be read.
+ *
+ * @return Published object or \c nil in case if nothing published.
+ *
+ * @since 1.6.0
+ */
+static id YHVPublishedObject(_Atomic(void *) *storage) {
+    
+    unsigned int epoch = 0;
+    id object = nil;
+    
+    // Register reader in epoch which is still active after registration (writer may switch it in between).
+    while (YES) {
+        epoch = atomic_load(&YHVCassetteReadersEpoch);
+        atomic_fetch_add(&YHVCassetteReaders[epoch], 1);
+        
+        if (atomic_load(&YHVCassetteReadersEpoch) == epoch) {
+            break;
+        }
+        
+        atomic_fetch_sub(&YHVCassetteReaders[epoch], 1);
+    }
+    
+    void *objectReference = atomic_load(storage);
+    
+    if (objectReference) {
+        object = (__bridge_transfer id)CFRetain(objectReference);
+    }
+    
+    atomic_fetch_sub(&YHVCassetteReaders[epoch], 1);
+    
+    return object;
+}
+
+/**
+ * @brief      Publish object in \c storage.
+ * @discussion Previously published object released only after all readers which could see it completed. Writers should be serialized.
+ *
+ * @param storage Pointer on storage in which object should be published.
+ * @param object  Reference on object which should be published.
+ *
+ * @since 1.6.0
+ */
+static void YHVPublishObject(_Atomic(void *) *storage, id object) {
+    
+    void *previousObjectReference = atomic_exchange(storage, (object ? (__bridge_retained void *)object : NULL));
+    
+    if (!previousObjectReference) {
+        return;
+    }
+    
+    // Switch readers to another counter and wait till readers which could see previous object will complete.
+    unsigned int epoch = atomic_fetch_xor(&YHVCassetteReadersEpoch, 1);
+    
+    while (atomic_load(&YHVCassetteReaders[epoch]) > 0) {
+        sched_yield();
+    }
+    
+    CFRelease(previousObjectReference);
+}
+
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -56,9 +169,35 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, copy) YHVConfiguration *sharedConfiguration;
 
 /**
- * @brief  Stores reference on cassette which currently inserted into VCR.
+ * @brief      Stores reference on cassette which currently inserted into VCR.
+ * @discussion Reference can be read from any thread w/o locks. Previous cassette released only when there is no readers which may
+ *             retain it.
  */
-@property (nonatomic, strong, nullable) YHVCassette *cassette;
+@property (strong, nullable) YHVCassette *cassette;
+
+/**
+ * @brief      Stores reference on dictionary which map context to cassette inserted for it.
+ * @discussion Reference can be read from any thread w/o locks.
+ *
+ * @since 1.6.0
+ */
+@property (strong, nullable) NSDictionary<NSString *, YHVCassette *> *contextCassettes;
+
+/**
+ * @brief      Stores reference on dictionary which map identifier of cassette inserted for context to cassette.
+ * @discussion Reference can be read from any thread w/o locks.
+ *
+ * @since 1.6.0
+ */
+@property (strong, nullable) NSDictionary<NSString *, YHVCassette *> *identifiedCassettes;
+
+/**
+ * @brief      Stores reference on dictionary which map inserted cassette identifier to it's hosts filter.
+ * @discussion \a NSNull stored for cassettes which doesn't filter hosts.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *HTTPBodyCaptureHostsFilters;
 
 /**
  * @brief  Stores reference on dictionary which contain set of known matchers.
@@ -66,6 +205,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong) NSMutableDictionary<NSString *, YHVMatcherBlock> *matchers;
 
+/**
+ * @brief  Stores reference on dictionary which contain bundled matchers.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, strong) NSDictionary<NSString *, YHVMatcherBlock> *defaultMatchers;
+
 /**
  * @brief  Stores reference on queue which is used to serialize access to shared object information.
  */
@@ -82,6 +228,15 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (YHVVCR *)sharedInstance;
 
+/**
+ * @brief      Install URL loading system hooks which is required to play and record requests.
+ * @discussion Hooks installed on first VCR configuration or cassette insertion, so processes which only link framework doesn't pay
+ *             for swizzling at launch. Subsequent calls is no-op.
+ *
+ * @since 1.6.0
+ */
++ (void)installHooks;
+
 /**
  * @brief  Merge VCR's configuration with custom cassette's configuration.
  *
@@ -103,6 +258,65 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (YHVCassette *)insertCassetteWithDefault:(BOOL)isDefault configuration:(void(^)(YHVConfiguration *configuration))block;
 
+/**
+ * @brief  Insert new or existing cassette to VCR for specified \c context.
+ *
+ * @param context   Reference on context for which cassette should be inserted or \c nil to insert default cassette.
+ * @param isDefault Whether default VCR configuration should be used for cassette operation or not.
+ * @param block     Reference on block which can be used to customize cassette's behaviour.
+ *
+ * @return Reference on cassette which has been inserted to VCR.
+ *
+ * @since 1.6.0
+ */
+- (YHVCassette *)insertCassetteForContext:(nullable NSString *)context
+                              withDefault:(BOOL)isDefault
+                            configuration:(void(^)(YHVConfiguration *configuration))block;
+
+/**
+ * @brief  Eject cassette which has been inserted for specified \c context.
+ *
+ * @param context Reference on context for which cassette should be ejected or \c nil to eject default cassette.
+ *
+ * @since 1.6.0
+ */
+- (void)ejectCassetteForContext:(nullable NSString *)context;
+
+/**
+ * @brief      Update request body capture configuration.
+ * @discussion Body captured while there is at least one inserted cassette for hosts which is allowed by any of inserted cassettes.
+ *
+ * @since 1.6.0
+ */
+- (void)updateHTTPBodyCapture;
+
+
+#pragma mark - Routing
+
+/**
+ * @brief      Find cassette which should handle \c request.
+ * @discussion Cassette which already handled request found by it's identifier, otherwise cassette found by request's context. Requests
+ *             w/o context handled by default cassette.
+ *
+ * @param request Reference on request for which cassette should be found.
+ *
+ * @return Reference on cassette or \c nil in case if there is no cassettes which can handle request.
+ *
+ * @since 1.6.0
+ */
++ (nullable YHVCassette *)cassetteForRequest:(nullable NSURLRequest *)request;
+
+/**
+ * @brief  Find cassette which should handle \c task.
+ *
+ * @param task Reference on task for which cassette should be found.
+ *
+ * @return Reference on cassette or \c nil in case if there is no cassettes which can handle task.
+ *
+ * @since 1.6.0
+ */
++ (nullable YHVCassette *)cassetteForTask:(NSURLSessionTask *)task;
+
 /**
  * @brief  Compose full path to cassette's data file.
  *
@@ -162,10 +376,11 @@ NS_ASSUME_NONNULL_BEGIN
  * @brief  Create URL object filtering block.
  *
  * @param configuration Reference on cassette's configuration object.
+ * @param memoize       Whether path and query parameters filters depend only from URL, so filtered URLs can be memoized.
  *
  * @return Reference on block which will be called each time before URL object should be saved.
  */
-- (YHVURLFilterBlock)createURLFilterBlockWithConfiguration:(YHVConfiguration *)configuration;
+- (YHVURLFilterBlock)createURLFilterBlockWithConfiguration:(YHVConfiguration *)configuration memoize:(BOOL)memoize;
 
 /**
  * @brief  Create request filtering block based on request URL path part.
@@ -215,6 +430,18 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable NSArray<YHVMatcherBlock> *)matchersForConfiguration:(YHVConfiguration *)configuration;
 
+/**
+ * @brief      Get list of bundled matcher identifiers which is used by configuration.
+ * @discussion Matchers which has been replaced with custom blocks excluded from list.
+ *
+ * @param configuration Reference on object which contain list of required matcher identifiers.
+ *
+ * @return Reference on list with bundled matcher identifiers.
+ *
+ * @since 1.6.0
+ */
+- (NSArray<NSString *> *)defaultMatcherIdentifiersForConfiguration:(YHVConfiguration *)configuration;
+
 /**
  * @brief  Register bundled request matchers.
  */
@@ -247,13 +474,42 @@ NS_ASSUME_NONNULL_END
 
 + (YHVCassette *)cassette {
     
-    __block YHVCassette *cassette = nil;
+    return [self sharedInstance].cassette;
+}
+
++ (YHVCassette *)cassetteForContext:(NSString *)context {
     
-    dispatch_sync([self sharedInstance].resourceAccessQueue, ^{
-        cassette = [self sharedInstance]->_cassette;
-    });
+    return context ? [self sharedInstance].contextCassettes[context] : nil;
+}
+
+- (YHVCassette *)cassette {
     
-    return cassette;
+    return YHVPublishedObject(&YHVInsertedCassette);
+}
+
+- (void)setCassette:(YHVCassette *)cassette {
+    
+    YHVPublishObject(&YHVInsertedCassette, cassette);
+}
+
+- (NSDictionary<NSString *, YHVCassette *> *)contextCassettes {
+    
+    return YHVPublishedObject(&YHVContextCassettes);
+}
+
+- (void)setContextCassettes:(NSDictionary<NSString *, YHVCassette *> *)contextCassettes {
+    
+    YHVPublishObject(&YHVContextCassettes, contextCassettes);
+}
+
+- (NSDictionary<NSString *, YHVCassette *> *)identifiedCassettes {
+    
+    return YHVPublishedObject(&YHVIdentifiedCassettes);
+}
+
+- (void)setIdentifiedCassettes:(NSDictionary<NSString *, YHVCassette *> *)identifiedCassettes {
+    
+    YHVPublishObject(&YHVIdentifiedCassettes, identifiedCassettes);
 }
 
 + (NSDictionary<NSString *,YHVMatcherBlock> *)matchers {
@@ -270,13 +526,15 @@ NS_ASSUME_NONNULL_END
 
 #pragma mark - Initialization and Configuration
 
-+ (void)load {
-
-    [YHVNSURLSessionConfiguration injectProtocol];
-    [YHVNSURLSessionConnection makeRecordable];
-    [YHVNSURLSessionTask makeRecordable];
-    [YHVNSURLConnection makeRecordable];
-    [YHVNSURLRequest patch];
++ (void)installHooks {
+    
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        [YHVNSURLSessionConfiguration injectProtocol];
+        [YHVNSURLSessionConnection makeRecordable];
+        [YHVNSURLSessionTask makeRecordable];
+        [YHVNSURLConnection makeRecordable];
+    });
 }
 
 + (YHVVCR *)sharedInstance {
@@ -298,6 +556,7 @@ NS_ASSUME_NONNULL_END
     
     NSAssert(configuration.cassettesPath.length, @"VCR setup error. Cassettes path is empty or nil.");
     
+    [self installHooks];
     [self sharedInstance].sharedConfiguration = configuration;
     [[self sharedInstance] prepareCassettesDirectory];
 }
@@ -306,6 +565,7 @@ NS_ASSUME_NONNULL_END
     
     if ((self = [super init])) {
         _resourceAccessQueue = dispatch_queue_create("com.yetanotherhttpvcr.core", DISPATCH_QUEUE_SERIAL);
+        _HTTPBodyCaptureHostsFilters = [NSMutableDictionary new];
         _matchers = [NSMutableDictionary new];
         
         [self registerDefaultMatcher];
@@ -318,6 +578,8 @@ NS_ASSUME_NONNULL_END
     
     YHVConfiguration *configuration = [cassetteConfiguration copyWithDefaultsFromConfiguration:self.sharedConfiguration];
     configuration.cassettePath = [self pathForCassetteWithConfiguration:cassetteConfiguration];
+    configuration.matcherIdentifiers = [self defaultMatcherIdentifiersForConfiguration:configuration];
+    configuration.matcherNames = configuration.matchers;
     configuration.matchers = [self matchersForConfiguration:configuration];
     configuration.beforeRecordRequest = [self createBeforeRecordRequestBlockWithConfiguration:configuration];
     configuration.beforeRecordResponse = [self createBeforeRecordResponseBlockWithConfiguration:configuration];
@@ -344,20 +606,61 @@ NS_ASSUME_NONNULL_END
 
 + (void)ejectCassette {
     
-    dispatch_sync([self sharedInstance].resourceAccessQueue, ^{
-        [[self sharedInstance].cassette save];
-        [self sharedInstance].cassette = nil;
-    });
+    [[self sharedInstance] ejectCassetteForContext:nil];
+}
+
+
+#pragma mark - Context
+
++ (YHVCassette *)insertCassetteForContext:(NSString *)context withConfiguration:(void(^)(YHVConfiguration *configuration))block {
+    
+    NSAssert(context.length, @"Cassette insertion error. Context is empty or nil.");
+    NSAssert(block, @"Cassette insertion error. Configuration block not provided.");
+    
+    return [[self sharedInstance] insertCassetteForContext:context withDefault:NO configuration:block];
+}
+
++ (void)ejectCassetteForContext:(NSString *)context {
+    
+    NSAssert(context.length, @"Cassette eject error. Context is empty or nil.");
+    
+    [[self sharedInstance] ejectCassetteForContext:context];
+}
+
++ (void)setContext:(NSString *)context forSessionConfiguration:(NSURLSessionConfiguration *)configuration {
+    
+    NSAssert(context.length, @"Context binding error. Context is empty or nil.");
+    
+    [self installHooks];
+    [YHVNSURLSessionConfiguration setContext:context forConfiguration:configuration];
+}
+
++ (void)setContext:(NSString *)context forRequest:(NSMutableURLRequest *)request {
+    
+    NSAssert(context.length, @"Context binding error. Context is empty or nil.");
+    
+    request.YHV_context = context;
 }
 
 - (YHVCassette *)insertCassetteWithDefault:(BOOL)isDefault configuration:(void(^)(YHVConfiguration *configuration))block {
     
-    NSAssert(!self.cassette, @"Cassette insertion error. There is cassette in VCR. Eject cassette before inserting new.");
+    return [self insertCassetteForContext:nil withDefault:isDefault configuration:block];
+}
+
+- (YHVCassette *)insertCassetteForContext:(NSString *)context
+                              withDefault:(BOOL)isDefault
+                            configuration:(void(^)(YHVConfiguration *configuration))block {
+    
+    NSAssert(context || !self.cassette, @"Cassette insertion error. There is cassette in VCR. Eject cassette before inserting new.");
+    NSAssert(!context || !self.contextCassettes[context], @"Cassette insertion error. There is cassette for '%@' context in VCR. "
+             "Eject cassette before inserting new.", context);
     
     __block YHVCassette *cassette = nil;
     __block YHVConfiguration *configuration = [YHVConfiguration defaultConfiguration];
     configuration.matchers = nil;
     
+    [[self class] installHooks];
+    
     block(configuration);
     
     NSAssert(configuration.cassettePath.length, @"Cassette insertion error. Cassette path is empty or nil.");
@@ -367,15 +670,94 @@ NS_ASSUME_NONNULL_END
         configuration.playbackMode = isDefault ? self.sharedConfiguration.playbackMode : configuration.playbackMode;
         configuration.recordMode = isDefault ? self.sharedConfiguration.recordMode : configuration.recordMode;
         
-        self.cassette = [YHVCassette cassetteWithConfiguration:configuration];
-        [self->_cassette load];
+        // Cassette published only after it's content loaded, because readers doesn't wait for insertion completion.
+        cassette = [YHVCassette cassetteWithConfiguration:configuration];
+        [cassette load];
+        
+        if (context) {
+            NSMutableDictionary<NSString *, YHVCassette *> *identifiedCassettes = [NSMutableDictionary new];
+            NSMutableDictionary<NSString *, YHVCassette *> *contextCassettes = [NSMutableDictionary new];
+            [identifiedCassettes addEntriesFromDictionary:self.identifiedCassettes];
+            [contextCassettes addEntriesFromDictionary:self.contextCassettes];
+            identifiedCassettes[cassette.identifier] = cassette;
+            contextCassettes[context] = cassette;
+            
+            // Cassette should be known by it's identifier before requests can be routed to it by context.
+            self.identifiedCassettes = identifiedCassettes;
+            self.contextCassettes = contextCassettes;
+        } else {
+            self.cassette = cassette;
+        }
         
-        cassette = self.cassette;
+        self.HTTPBodyCaptureHostsFilters[cassette.identifier] = configuration.hostsFilter ?: [NSNull null];
+        [self updateHTTPBodyCapture];
     });
     
     return cassette;
 }
 
+- (void)ejectCassetteForContext:(NSString *)context {
+    
+    dispatch_sync(self.resourceAccessQueue, ^{
+        YHVCassette *cassette = context ? self.contextCassettes[context] : self.cassette;
+        
+        if (!cassette) {
+            return;
+        }
+        
+        [self.HTTPBodyCaptureHostsFilters removeObjectForKey:cassette.identifier];
+        [self updateHTTPBodyCapture];
+        [cassette save];
+        [cassette saveTrace];
+        
+        if (cassette.configuration.logStatisticsOnEject) {
+            NSLog(@"\nCASSETTE STATISTICS (%@)\n%@", cassette.configuration.cassettePath, cassette.statistics);
+        }
+        
+        if (context) {
+            NSMutableDictionary<NSString *, YHVCassette *> *identifiedCassettes = [self.identifiedCassettes mutableCopy];
+            NSMutableDictionary<NSString *, YHVCassette *> *contextCassettes = [self.contextCassettes mutableCopy];
+            [identifiedCassettes removeObjectForKey:cassette.identifier];
+            [contextCassettes removeObjectForKey:context];
+            
+            self.contextCassettes = contextCassettes.count ? contextCassettes : nil;
+            self.identifiedCassettes = identifiedCassettes.count ? identifiedCassettes : nil;
+        } else {
+            self.cassette = nil;
+        }
+    });
+}
+
+- (void)updateHTTPBodyCapture {
+    
+    NSArray *hostsFilters = self.HTTPBodyCaptureHostsFilters.allValues;
+    
+    if (!hostsFilters.count) {
+        [YHVNSURLRequest disableHTTPBodyCapture];
+        return;
+    }
+    
+    if ([hostsFilters containsObject:[NSNull null]]) {
+        [YHVNSURLRequest enableHTTPBodyCaptureWithHostsFilter:nil];
+        return;
+    }
+    
+    if (hostsFilters.count == 1) {
+        [YHVNSURLRequest enableHTTPBodyCaptureWithHostsFilter:hostsFilters.firstObject];
+        return;
+    }
+    
+    [YHVNSURLRequest enableHTTPBodyCaptureWithHostsFilter:^BOOL (NSString *host) {
+        for (YHVHostFilterBlock hostsFilter in hostsFilters) {
+            if (hostsFilter(host)) {
+                return YES;
+            }
+        }
+        
+        return NO;
+    }];
+}
+
 - (NSString *)pathForCassetteWithConfiguration:(YHVConfiguration *)configuration {
     
     NSString *path = [self.sharedConfiguration.cassettesPath stringByAppendingPathComponent:configuration.cassettePath];
@@ -405,46 +787,83 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Routing
+
++ (YHVCassette *)cassetteForRequest:(NSURLRequest *)request {
+    
+    YHVRequestTag *tag = request.YHV_tag;
+    NSString *cassetteIdentifier = tag.cassetteIdentifier;
+    NSString *context = tag.context;
+    YHVCassette *cassette = nil;
+    
+    if (!cassetteIdentifier && !context) {
+        return [self sharedInstance].cassette;
+    }
+    
+    if (cassetteIdentifier) {
+        cassette = [self sharedInstance].identifiedCassettes[cassetteIdentifier];
+    }
+    
+    if (!cassette && context) {
+        cassette = [self sharedInstance].contextCassettes[context];
+    }
+    
+    // Requests with context shouldn't be handled by default cassette to avoid cross-talk between contexts.
+    return cassette ?: (!context ? [self sharedInstance].cassette : nil);
+}
+
++ (YHVCassette *)cassetteForTask:(NSURLSessionTask *)task {
+    
+    NSURLRequest *request = task.originalRequest;
+    
+    if (!request.YHV_tag && task.currentRequest) {
+        request = task.currentRequest;
+    }
+    
+    return [self cassetteForRequest:request];
+}
+
+
 #pragma mark - Playback
 
 + (BOOL)canPlayResponseForRequest:(NSURLRequest *)request {
     
-    return [self.cassette canPlayResponseForRequest:request];
+    return [[self cassetteForRequest:request] canPlayResponseForRequest:request];
 }
 
 + (void)prepareToPlayResponsesWithProtocol:(YHVNSURLProtocol *)protocol; {
     
-    [self.cassette prepareToPlayResponsesWithProtocol:protocol];
+    [[self cassetteForRequest:protocol.request] prepareToPlayResponsesWithProtocol:protocol];
 }
 
 + (void)playResponsesForRequest:(NSURLRequest *)request {
     
-    [self.cassette playResponsesForRequest:request];
+    [[self cassetteForRequest:request] playResponsesForRequest:request];
 }
 
 + (void)handleRequestPlayedForTask:(NSURLSessionTask *)task {
     
-    [self.cassette handleRequestPlayedForTask:task];
+    [[self cassetteForTask:task] handleRequestPlayedForTask:task];
 }
 
 + (void)handleResponsePlayedForTask:(NSURLSessionTask *)task {
     
-    [self.cassette handleResponsePlayedForTask:task];
+    [[self cassetteForTask:task] handleResponsePlayedForTask:task];
 }
 
 + (void)handleDataPlayedForTask:(NSURLSessionTask *)task {
     
-    [self.cassette handleDataPlayedForTask:task];
+    [[self cassetteForTask:task] handleDataPlayedForTask:task];
 }
 
 + (void)handleError:(NSError *)error playedForTask:(NSURLSessionTask *)task {
     
-    [self.cassette handleError:error playedForTask:task];
+    [[self cassetteForTask:task] handleError:error playedForTask:task];
 }
 
 + (void)handleRequestPlayedForRequest:(NSURLRequest *)request {
     
-    [self.cassette handleRequestPlayedForRequest:request];
+    [[self cassetteForRequest:request] handleRequestPlayedForRequest:request];
 }
 
 
@@ -452,27 +871,27 @@ NS_ASSUME_NONNULL_END
 
 + (void)beginRecordingTask:(NSURLSessionTask *)task {
     
-    [self.cassette beginRecordingTask:task];
+    [[self cassetteForTask:task] beginRecordingTask:task];
 }
 
 + (void)recordResponse:(NSURLResponse *)response forTask:(NSURLSessionTask *)task {
     
-    [self.cassette recordResponse:response forTask:task];
+    [[self cassetteForTask:task] recordResponse:response forTask:task];
 }
 
 + (void)recordData:(NSData *)data forTask:(NSURLSessionTask *)task {
     
-    [self.cassette recordData:data forTask:task];
+    [[self cassetteForTask:task] recordData:data forTask:task];
 }
 
 + (void)recordCompletionWithError:(NSError *)error forTask:(NSURLSessionTask *)task {
     
-    [self.cassette recordCompletionWithError:error forTask:task];
+    [[self cassetteForTask:task] recordCompletionWithError:error forTask:task];
 }
 
 + (void)clearFetchedDataForTask:(NSURLSessionTask *)task {
     
-    [self.cassette clearFetchedDataForTask:task];
+    [[self cassetteForTask:task] clearFetchedDataForTask:task];
 }
 
 
@@ -480,22 +899,22 @@ NS_ASSUME_NONNULL_END
 
 + (void)beginRecordingRequest:(NSURLRequest *)request {
     
-    [self.cassette beginRecordingRequest:request];
+    [[self cassetteForRequest:request] beginRecordingRequest:request];
 }
 
 + (void)recordResponse:(NSURLResponse *)response forRequest:(NSURLRequest *)request {
     
-    [self.cassette recordResponse:response forRequest:request];
+    [[self cassetteForRequest:request] recordResponse:response forRequest:request];
 }
 
 + (void)recordData:(NSData *)data forRequest:(NSURLRequest *)request {
     
-    [self.cassette recordData:data forRequest:request];
+    [[self cassetteForRequest:request] recordData:data forRequest:request];
 }
 
 + (void)recordCompletionWithError:(NSError *)error forRequest:(NSURLRequest *)request {
     
-    [self.cassette recordCompletionWithError:error forRequest:request];
+    [[self cassetteForRequest:request] recordCompletionWithError:error forRequest:request];
 }
 
 
@@ -504,12 +923,16 @@ NS_ASSUME_NONNULL_END
 - (YHVBeforeRecordRequestBlock)createBeforeRecordRequestBlockWithConfiguration:(YHVConfiguration *)configuration {
     
     YHVBeforeRecordRequestBlock beforeRecordRequest = configuration.beforeRecordRequest ?: self.sharedConfiguration.beforeRecordRequest;
+    id queryParametersFilter = configuration.queryParametersFilter ?: self.sharedConfiguration.queryParametersFilter;
+    YHVPathFilterBlock pathFilter = configuration.pathFilter ?: self.sharedConfiguration.pathFilter;
+    BOOL shouldMemoizeURLs = !pathFilter && (!queryParametersFilter || [queryParametersFilter isKindOfClass:[NSDictionary class]]);
+    BOOL shouldFilterPOSTBody = (configuration.postBodyFilter ?: self.sharedConfiguration.postBodyFilter) != nil;
     configuration.hostsFilter = [self createHostFilterBlockWithConfiguration:configuration];
     configuration.headersFilter = [self createHeadersFilterBlockWithConfiguration:configuration];
     configuration.pathFilter = [self createPathFilterBlockWithConfiguration:configuration];
     configuration.queryParametersFilter = [self createQueryParametersFilterBlockWithConfiguration:configuration];
     configuration.postBodyFilter = [self createPOSTBodyFilterBlockWithConfiguration:configuration];
-    configuration.urlFilter = [self createURLFilterBlockWithConfiguration:configuration];
+    configuration.urlFilter = [self createURLFilterBlockWithConfiguration:configuration memoize:shouldMemoizeURLs];
     
     return ^NSURLRequest * (NSURLRequest *request) {
         if (configuration.hostsFilter && !((YHVHostFilterBlock)configuration.hostsFilter)(request.URL.host)) {
@@ -528,8 +951,17 @@ NS_ASSUME_NONNULL_END
         
         finalRequest.URL = configuration.urlFilter(finalRequest, finalRequest.URL);
         
-        if (configuration.postBodyFilter) {
-            finalRequest.HTTPBody = ((YHVPostBodyFilterBlock)configuration.postBodyFilter)(finalRequest, finalRequest.YHV_HTTPBody);
+        NSData *body = finalRequest.YHV_HTTPBody;
+        
+        // Streamed body should be captured before filtering, so live request and stub will have same body and digest.
+        if (shouldFilterPOSTBody && !body && [finalRequest.HTTPBodyStream isKindOfClass:[YHVTeeInputStream class]] &&
+            [(YHVTeeInputStream *)finalRequest.HTTPBodyStream drain]) {
+            body = finalRequest.YHV_HTTPBody;
+        }
+        
+        // Body stream which hasn't been captured yet should be kept, so it can be captured during transfer.
+        if (configuration.postBodyFilter && (body || !finalRequest.HTTPBodyStream)) {
+            finalRequest.HTTPBody = ((YHVPostBodyFilterBlock)configuration.postBodyFilter)(finalRequest, body);
         }
         
         NSURLRequest *updatedRequest = beforeRecordRequest ? beforeRecordRequest(finalRequest) : finalRequest;
@@ -576,10 +1008,10 @@ NS_ASSUME_NONNULL_END
         return hostsFilter;
     }
     
-    NSArray *allowedHosts = [hostsFilter copy];
+    YHVHostsRuleSet *allowedHosts = [YHVHostsRuleSet ruleSetWithHosts:hostsFilter];
     
     return ^BOOL (NSString *host) {
-        return [allowedHosts containsObject:host];
+        return [allowedHosts containsHost:host];
     };
 }
 
@@ -591,43 +1023,21 @@ NS_ASSUME_NONNULL_END
         return headersFilter;
     }
     
-    NSDictionary *headersForModification = [headersFilter copy];
+    YHVReplacementRuleSet *headersForModification = [YHVReplacementRuleSet ruleSetWithReplacements:headersFilter];
     
     return ^(__unused NSURLRequest *request, NSMutableDictionary *headers) {
-        [headers YHV_replaceValuesWithValuesFromDictionary:headersForModification];
+        [headersForModification applyToDictionary:headers];
     };
 }
 
-- (YHVURLFilterBlock)createURLFilterBlockWithConfiguration:(YHVConfiguration *)configuration {
+- (YHVURLFilterBlock)createURLFilterBlockWithConfiguration:(YHVConfiguration *)configuration memoize:(BOOL)memoize {
+    
+    YHVURLRewriter *rewriter = [YHVURLRewriter rewriterWithPathFilter:configuration.pathFilter
+                                                queryParametersFilter:configuration.queryParametersFilter
+                                                              memoize:memoize];
     
     return ^NSURL * (NSURLRequest *request, NSURL *url) {
-        NSMutableURLRequest *finalRequest = [request mutableCopy];
-        finalRequest.URL = url;
-        
-        if (configuration.pathFilter) {
-            NSURLComponents *urlComponents = [NSURLComponents componentsWithString:finalRequest.URL.absoluteString];
-            urlComponents.path = configuration.pathFilter(finalRequest);
-            finalRequest.URL = urlComponents.URL;
-        }
-        
-        if (configuration.queryParametersFilter) {
-            NSDictionary *query = [NSDictionary YHV_dictionaryWithQuery:finalRequest.URL.query
-                                                   sortQueryListOnMatch:NO];
-            NSMutableDictionary *mutableQuery = [query mutableCopy];
-            
-            ((YHVQueryParametersFilterBlock)configuration.queryParametersFilter)(request, mutableQuery);
-            
-            if (![mutableQuery isEqualToDictionary:query]) {
-                NSString *updatedQueryString = [mutableQuery YHV_toQueryString];
-                NSString *urlString = finalRequest.URL.absoluteString;
-                NSString *queryString = finalRequest.URL.query;
-                
-                urlString = [urlString stringByReplacingOccurrencesOfString:queryString withString:updatedQueryString];
-                finalRequest.URL = [NSURL URLWithString:urlString];
-            }
-        }
-        
-        return finalRequest.URL;
+        return [rewriter rewrittenURL:url forRequest:request];
     };
 }
 
@@ -650,10 +1060,10 @@ NS_ASSUME_NONNULL_END
         return queryParametersFilter;
     }
     
-    NSDictionary *queryKeysForModification = [queryParametersFilter copy];
+    YHVReplacementRuleSet *queryKeysForModification = [YHVReplacementRuleSet ruleSetWithReplacements:queryParametersFilter];
     
     return ^(__unused NSURLRequest *request, NSMutableDictionary *queryParameters) {
-        [queryParameters YHV_replaceValuesWithValuesFromDictionary:queryKeysForModification];
+        [queryKeysForModification applyToDictionary:queryParameters];
     };
 }
 
@@ -661,26 +1071,32 @@ NS_ASSUME_NONNULL_END
     
     id postBodyFilter = configuration.postBodyFilter ?: self.sharedConfiguration.postBodyFilter;
     NSArray<NSString *> *requestMethodsWithHTTPBody = @[@"post", @"put", @"patch"];
-    NSDictionary *bodyKeysForModification = nil;
+    YHVReplacementRuleSet *bodyKeysForModification = nil;
+    YHVJSONRedactor *jsonRedactor = nil;
     
     if ([postBodyFilter isKindOfClass:[NSDictionary class]]) {
-        bodyKeysForModification = [postBodyFilter copy];
+        bodyKeysForModification = [YHVReplacementRuleSet ruleSetWithReplacements:postBodyFilter];
+        jsonRedactor = [YHVJSONRedactor redactorWithReplacements:postBodyFilter];
     }
     
     return ^NSData * (NSURLRequest *request, NSData *body) {
-        if (![requestMethodsWithHTTPBody containsObject:request.HTTPMethod.lowercaseString]) {
+        if (!postBodyFilter || ![requestMethodsWithHTTPBody containsObject:request.HTTPMethod.lowercaseString]) {
             return body;
-        } else if (postBodyFilter && !bodyKeysForModification) {
+        } else if (!bodyKeysForModification) {
             return ((YHVPostBodyFilterBlock)postBodyFilter)(request, body);
         }
         
+        if ([YHVJSONRedactor canRedactDataWithContentType:[request valueForHTTPHeaderField:@"Content-Type"]]) {
+            return [jsonRedactor redactedDataFromData:body] ?: body;
+        }
+        
         NSMutableDictionary *keyValue = [[NSDictionary YHV_dictionaryFromNSURLRequestPOSTBody:request] mutableCopy];
         
         if (!keyValue) {
             return body;
         }
         
-        return [[keyValue YHV_replaceValuesWithValuesFromDictionary:bodyKeysForModification] YHV_POSTBodyForNSURLRequest:request];
+        return [[bodyKeysForModification applyToDictionary:keyValue] YHV_POSTBodyForNSURLRequest:request];
     };
 }
 
@@ -692,16 +1108,21 @@ NS_ASSUME_NONNULL_END
         return responseBodyFilter;
     }
     
-    NSDictionary *bodyKeysForModification = [responseBodyFilter copy];
+    YHVReplacementRuleSet *bodyKeysForModification = [YHVReplacementRuleSet ruleSetWithReplacements:responseBodyFilter];
+    YHVJSONRedactor *jsonRedactor = [YHVJSONRedactor redactorWithReplacements:responseBodyFilter];
     
     return ^NSData * (NSURLRequest * __unused request, NSHTTPURLResponse *response, NSData *data) {
+        if ([YHVJSONRedactor canRedactDataWithContentType:response.allHeaderFields[@"Content-Type"]]) {
+            return [jsonRedactor redactedDataFromData:data] ?: data;
+        }
+        
         NSMutableDictionary *keyValue = [[NSDictionary YHV_dictionaryFromData:data forNSHTTPURLResponse:response] mutableCopy];
         
         if (!keyValue) {
             return data;
         }
         
-        return [[keyValue YHV_replaceValuesWithValuesFromDictionary:bodyKeysForModification] YHV_DataForNSHTTPURLResponse:response];
+        return [[bodyKeysForModification applyToDictionary:keyValue] YHV_DataForNSHTTPURLResponse:response];
     };
 }
 
@@ -728,6 +1149,19 @@ NS_ASSUME_NONNULL_END
     return matchers;
 }
 
+- (NSArray<NSString *> *)defaultMatcherIdentifiersForConfiguration:(YHVConfiguration *)configuration {
+    
+    NSMutableArray<NSString *> *matcherIdentifiers = [NSMutableArray new];
+    
+    for (NSString *matcherIdentifier in configuration.matchers) {
+        if (self.matchers[matcherIdentifier] && self.matchers[matcherIdentifier] == self.defaultMatchers[matcherIdentifier]) {
+            [matcherIdentifiers addObject:matcherIdentifier];
+        }
+    }
+    
+    return matcherIdentifiers;
+}
+
 + (void)registerMatcher:(NSString *)identifier withBlock:(YHVMatcherBlock)block {
     
     if (!identifier || !block) {
@@ -765,6 +1199,7 @@ NS_ASSUME_NONNULL_END
         self.matchers[YHVMatcher.query] = YHVRequestMatchers.query;
         self.matchers[YHVMatcher.headers] = YHVRequestMatchers.headers;
         self.matchers[YHVMatcher.body] = YHVRequestMatchers.body;
+        self.defaultMatchers = [self.matchers copy];
     });
 }
 
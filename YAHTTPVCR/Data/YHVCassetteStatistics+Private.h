@@ -0,0 +1,121 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVCassetteStatistics.h"
+
+
+#pragma mark Constants
+
+/**
+ * @brief  Number of buckets in chapters replay latency histogram.
+ */
+#define YHVReplayLatencyBucketsCount 13
+
+
+#pragma mark - Structures
+
+/**
+ * @brief  Cassette's operation counters.
+ */
+typedef struct YHVCassetteCounters {
+    
+    /**
+     * @brief  Stores how long (in seconds) cassette's file has been loaded and deserialized.
+     */
+    NSTimeInterval loadDuration;
+    
+    /**
+     * @brief  Stores size of cassette's file which has been loaded.
+     */
+    unsigned long long loadedBytesCount;
+    
+    /**
+     * @brief  Stores how long (in seconds) cassette has been serialized and written to file (all saves).
+     */
+    NSTimeInterval saveDuration;
+    
+    /**
+     * @brief  Stores size of cassette's file after last save.
+     */
+    unsigned long long savedBytesCount;
+    
+    /**
+     * @brief  Stores number of recorded request lookups.
+     */
+    NSUInteger lookupsCount;
+    
+    /**
+     * @brief  Stores number of recorded requests which has been checked during all lookups.
+     */
+    NSUInteger scannedCandidatesCount;
+    
+    /**
+     * @brief  Stores maximum number of recorded requests which has been checked during single lookup.
+     */
+    NSUInteger maximumScannedCandidatesCount;
+    
+    /**
+     * @brief  Stores number of recorded requests which has been resolved using match index.
+     */
+    NSUInteger indexResolvedCandidatesCount;
+    
+    /**
+     * @brief  Stores number of response body bytes which has been played.
+     */
+    unsigned long long replayedBytesCount;
+    
+    /**
+     * @brief  Stores number of response body bytes which has been recorded.
+     */
+    unsigned long long recordedBytesCount;
+    
+    /**
+     * @brief  Stores number of replayed chapters in each latency bucket.
+     */
+    NSUInteger replayLatencyHistogram[YHVReplayLatencyBucketsCount];
+} YHVCassetteCounters;
+
+
+#pragma mark - Functions
+
+/**
+ * @brief  Find replay latency histogram bucket.
+ *
+ * @param latency Chapter replay latency (in seconds).
+ *
+ * @return Index of bucket into which \c latency falls.
+ */
+extern NSUInteger YHVReplayLatencyBucketIndex(NSTimeInterval latency);
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Private interface declaration
+
+@interface YHVCassetteStatistics (Private)
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Create and configure cassette's statistics snapshot.
+ *
+ * @param counters    Cassette's operation counters.
+ * @param evaluations Reference on dictionary with number of evaluations for each matcher.
+ * @param scenes      Number of scenes on cassette's tape.
+ * @param chapters    Number of chapters on cassette's tape.
+ *
+ * @return Configured and ready to use statistics snapshot.
+ */
++ (instancetype)statisticsWithCounters:(YHVCassetteCounters)counters
+                    matcherEvaluations:(NSDictionary<NSString *, NSNumber *> *)evaluations
+                           scenesCount:(NSUInteger)scenes
+                         chaptersCount:(NSUInteger)chapters;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
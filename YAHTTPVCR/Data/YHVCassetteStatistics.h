@@ -0,0 +1,118 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      Cassette's operation statistics snapshot.
+ * @discussion Snapshot allow to find out where test spend time with cassette: how long cassette has been loaded / saved, how many
+ *             recorded requests has been checked by matchers and how fast responses has been played.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVCassetteStatistics : NSObject
+
+
+#pragma mark Information
+
+/**
+ * @brief      Stores list of replay latency histogram buckets upper bounds (in seconds).
+ * @discussion Last bucket of \c replayLatencyHistogram doesn't have upper bound.
+ */
+@property (class, nonatomic, readonly, copy) NSArray<NSNumber *> *replayLatencyBucketsBounds;
+
+/**
+ * @brief  Stores how long (in seconds) cassette's file has been loaded and deserialized.
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval loadDuration;
+
+/**
+ * @brief  Stores size of cassette's file which has been loaded.
+ */
+@property (nonatomic, readonly, assign) unsigned long long loadedBytesCount;
+
+/**
+ * @brief  Stores how long (in seconds) cassette has been serialized and written to file (all saves).
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval saveDuration;
+
+/**
+ * @brief  Stores size of cassette's file after last save.
+ */
+@property (nonatomic, readonly, assign) unsigned long long savedBytesCount;
+
+/**
+ * @brief  Stores number of scenes on cassette's tape.
+ */
+@property (nonatomic, readonly, assign) NSUInteger scenesCount;
+
+/**
+ * @brief  Stores number of chapters (requests) on cassette's tape.
+ */
+@property (nonatomic, readonly, assign) NSUInteger chaptersCount;
+
+/**
+ * @brief  Stores number of recorded request lookups for requests sent by user's code.
+ */
+@property (nonatomic, readonly, assign) NSUInteger lookupsCount;
+
+/**
+ * @brief  Stores number of recorded requests which has been checked during all lookups.
+ */
+@property (nonatomic, readonly, assign) NSUInteger scannedCandidatesCount;
+
+/**
+ * @brief  Stores maximum number of recorded requests which has been checked during single lookup.
+ */
+@property (nonatomic, readonly, assign) NSUInteger maximumScannedCandidatesCount;
+
+/**
+ * @brief  Stores average number of recorded requests which has been checked during single lookup.
+ */
+@property (nonatomic, readonly, assign) double averageScannedCandidatesCount;
+
+/**
+ * @brief  Stores number of recorded requests which has been matched or rejected using match index w/o matchers evaluation.
+ */
+@property (nonatomic, readonly, assign) NSUInteger indexResolvedCandidatesCount;
+
+/**
+ * @brief  Stores how many times each of cassette's matchers has been evaluated.
+ */
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, NSNumber *> *matcherEvaluations;
+
+/**
+ * @brief  Stores number of response body bytes which has been played to user's code.
+ */
+@property (nonatomic, readonly, assign) unsigned long long replayedBytesCount;
+
+/**
+ * @brief  Stores number of response body bytes which has been recorded.
+ */
+@property (nonatomic, readonly, assign) unsigned long long recordedBytesCount;
+
+/**
+ * @brief      Stores histogram of chapters replay latency.
+ * @discussion Latency measured from moment when request has been matched to recorded chapter till chapter's closing (or error) scene
+ *             playback. Each entry is number of chapters which has been replayed faster than corresponding bound from
+ *             \c replayLatencyBucketsBounds (and slower than previous bound).
+ */
+@property (nonatomic, readonly, copy) NSArray<NSNumber *> *replayLatencyHistogram;
+
+
+#pragma mark - Serialization
+
+/**
+ * @brief  Compose dictionary which can be serialized to JSON for further processing.
+ *
+ * @return Dictionary with statistics values.
+ */
+- (NSDictionary *)dictionaryRepresentation;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
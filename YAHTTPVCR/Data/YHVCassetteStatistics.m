@@ -0,0 +1,165 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVCassetteStatistics+Private.h"
+
+
+#pragma mark Constants
+
+/**
+ * @brief  Upper bounds (in seconds) of replay latency histogram buckets (except last one).
+ */
+static NSTimeInterval const kYHVReplayLatencyBucketsBounds[YHVReplayLatencyBucketsCount - 1] = {
+    0.001f, 0.002f, 0.005f, 0.01f, 0.02f, 0.05f, 0.1f, 0.2f, 0.5f, 1.f, 2.f, 5.f
+};
+
+
+#pragma mark - Functions
+
+NSUInteger YHVReplayLatencyBucketIndex(NSTimeInterval latency) {
+    
+    NSUInteger bucketIdx = 0;
+    
+    while (bucketIdx < YHVReplayLatencyBucketsCount - 1 && latency >= kYHVReplayLatencyBucketsBounds[bucketIdx]) {
+        bucketIdx++;
+    }
+    
+    return bucketIdx;
+}
+
+
+#pragma mark - Private interface declaration
+
+@interface YHVCassetteStatistics ()
+
+
+#pragma mark - Information
+
+@property (nonatomic, assign) NSTimeInterval loadDuration;
+@property (nonatomic, assign) unsigned long long loadedBytesCount;
+@property (nonatomic, assign) NSTimeInterval saveDuration;
+@property (nonatomic, assign) unsigned long long savedBytesCount;
+@property (nonatomic, assign) NSUInteger scenesCount;
+@property (nonatomic, assign) NSUInteger chaptersCount;
+@property (nonatomic, assign) NSUInteger lookupsCount;
+@property (nonatomic, assign) NSUInteger scannedCandidatesCount;
+@property (nonatomic, assign) NSUInteger maximumScannedCandidatesCount;
+@property (nonatomic, assign) NSUInteger indexResolvedCandidatesCount;
+@property (nonatomic, copy) NSDictionary<NSString *, NSNumber *> *matcherEvaluations;
+@property (nonatomic, assign) unsigned long long replayedBytesCount;
+@property (nonatomic, assign) unsigned long long recordedBytesCount;
+@property (nonatomic, copy) NSArray<NSNumber *> *replayLatencyHistogram;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVCassetteStatistics
+
+
+#pragma mark - Information
+
++ (NSArray<NSNumber *> *)replayLatencyBucketsBounds {
+    
+    static NSArray<NSNumber *> *_replayLatencyBucketsBounds;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableArray<NSNumber *> *bounds = [NSMutableArray new];
+        
+        for (NSUInteger bucketIdx = 0; bucketIdx < YHVReplayLatencyBucketsCount - 1; bucketIdx++) {
+            [bounds addObject:@(kYHVReplayLatencyBucketsBounds[bucketIdx])];
+        }
+        
+        _replayLatencyBucketsBounds = [bounds copy];
+    });
+    
+    return _replayLatencyBucketsBounds;
+}
+
+- (double)averageScannedCandidatesCount {
+    
+    return self.lookupsCount ? (double)self.scannedCandidatesCount / self.lookupsCount : 0.f;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)statisticsWithCounters:(YHVCassetteCounters)counters
+                    matcherEvaluations:(NSDictionary<NSString *, NSNumber *> *)evaluations
+                           scenesCount:(NSUInteger)scenes
+                         chaptersCount:(NSUInteger)chapters {
+    
+    NSMutableArray<NSNumber *> *histogram = [NSMutableArray arrayWithCapacity:YHVReplayLatencyBucketsCount];
+    YHVCassetteStatistics *statistics = [self new];
+    
+    for (NSUInteger bucketIdx = 0; bucketIdx < YHVReplayLatencyBucketsCount; bucketIdx++) {
+        [histogram addObject:@(counters.replayLatencyHistogram[bucketIdx])];
+    }
+    
+    statistics.maximumScannedCandidatesCount = counters.maximumScannedCandidatesCount;
+    statistics.indexResolvedCandidatesCount = counters.indexResolvedCandidatesCount;
+    statistics.scannedCandidatesCount = counters.scannedCandidatesCount;
+    statistics.replayedBytesCount = counters.replayedBytesCount;
+    statistics.recordedBytesCount = counters.recordedBytesCount;
+    statistics.loadedBytesCount = counters.loadedBytesCount;
+    statistics.savedBytesCount = counters.savedBytesCount;
+    statistics.loadDuration = counters.loadDuration;
+    statistics.saveDuration = counters.saveDuration;
+    statistics.lookupsCount = counters.lookupsCount;
+    statistics.replayLatencyHistogram = histogram;
+    statistics.matcherEvaluations = evaluations;
+    statistics.chaptersCount = chapters;
+    statistics.scenesCount = scenes;
+    
+    return statistics;
+}
+
+
+#pragma mark - Serialization
+
+- (NSDictionary *)dictionaryRepresentation {
+    
+    return @{
+        @"load": @{ @"duration": @(self.loadDuration), @"bytes": @(self.loadedBytesCount) },
+        @"save": @{ @"duration": @(self.saveDuration), @"bytes": @(self.savedBytesCount) },
+        @"scenes": @(self.scenesCount),
+        @"chapters": @(self.chaptersCount),
+        @"lookups": @{
+            @"count": @(self.lookupsCount),
+            @"scannedCandidates": @(self.scannedCandidatesCount),
+            @"maximumScannedCandidates": @(self.maximumScannedCandidatesCount),
+            @"averageScannedCandidates": @(self.averageScannedCandidatesCount),
+            @"indexResolvedCandidates": @(self.indexResolvedCandidatesCount),
+            @"matcherEvaluations": self.matcherEvaluations
+        },
+        @"replayedBytes": @(self.replayedBytesCount),
+        @"recordedBytes": @(self.recordedBytesCount),
+        @"replayLatency": @{
+            @"bounds": [[self class] replayLatencyBucketsBounds],
+            @"histogram": self.replayLatencyHistogram
+        }
+    };
+}
+
+
+#pragma mark - Misc
+
+- (NSString *)description {
+    
+    return [NSString stringWithFormat:@"<YHVCassetteStatistics %p load: %.4fs (%@ bytes), save: %.4fs (%@ bytes), scenes: %@, "
+            "chapters: %@, lookups: %@ (%.2f candidates avg, %@ max), matchers: %@, replayed: %@ bytes, recorded: %@ bytes, "
+            "replay latency histogram: %@>", self, self.loadDuration, @(self.loadedBytesCount), self.saveDuration,
+            @(self.savedBytesCount), @(self.scenesCount), @(self.chaptersCount), @(self.lookupsCount),
+            self.averageScannedCandidatesCount, @(self.maximumScannedCandidatesCount), self.matcherEvaluations,
+            @(self.replayedBytesCount), @(self.recordedBytesCount), [self.replayLatencyHistogram componentsJoinedByString:@"/"]];
+}
+
+#pragma mark -
+
+
+@end
@@ -31,6 +31,32 @@ typedef NSURL * (^YHVURLFilterBlock)(NSURLRequest *request, NSURL *url);
  */
 @property (nonatomic, copy) YHVURLFilterBlock urlFilter;
 
+/**
+ * @brief      Stores reference on list of identifiers for matchers which is used by cassette.
+ * @discussion \c matchers replaced with list of matcher blocks when configuration is merged with shared configuration, but identifiers
+ *             required to find out which request fields can be compared using cassette's match index.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, copy) NSArray<NSString *> *matcherIdentifiers;
+
+/**
+ * @brief      Stores reference on list of names for all matchers which is used by cassette.
+ * @discussion Names stored in same order as matcher blocks in \c matchers and used to present matchers in cassette's statistics.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, copy) NSArray<NSString *> *matcherNames;
+
+/**
+ * @brief      Stores reference on set of lowercased \c throttledHosts.
+ * @discussion Set re-created each time when \c throttledHosts changed, so cassette can check played request's host w/o hosts list
+ *             normalization for each played chunk.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, nullable, readonly, copy) NSSet<NSString *> *lowercaseThrottledHosts;
+
 
 #pragma mark - Initialization and Configuration
 
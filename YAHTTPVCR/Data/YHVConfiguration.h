@@ -65,6 +65,80 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign) YHVPlaybackMode playbackMode;
 
+/**
+ * @brief      Stores maximum number of bytes per second with which recorded response body will be passed to URL loading system during
+ *             playback.
+ * @discussion Allow to check how application behave on slow connection w/o access to network. Value \c 0 disable bandwidth limitation.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, assign) NSUInteger playbackBytesPerSecond;
+
+/**
+ * @brief      Stores maximum size of response body chunk which will be passed to URL loading system at once during playback.
+ * @discussion Recorded response body will be split into chunks of specified size and they will be delivered one-by-one. Value \c 0 allow to
+ *             deliver recorded body as it has been stored on cassette.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, assign) NSUInteger playbackChunkSize;
+
+/**
+ * @brief      Stores delay (in seconds) after which first byte of response body will be passed to URL loading system during playback.
+ * @discussion Value \c 0 disable initial latency.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, assign) NSTimeInterval playbackInitialLatency;
+
+/**
+ * @brief      Stores reference on list of hosts for which playback throttling should be applied.
+ * @discussion Throttling configured with \c playbackBytesPerSecond, \c playbackChunkSize and \c playbackInitialLatency will be applied to
+ *             all stubbed requests if this property is \c nil.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, nullable, copy) NSArray<NSString *> *throttledHosts;
+
+/**
+ * @brief      Stores size (in bytes) of recorded response body after which it will be moved from memory to temporary file.
+ * @discussion Large response bodies (like media or exported files) stored in files owned by cassette till it will be saved. This allow to
+ *             keep memory usage low while recording. Value \c 0 disable temporary files usage.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, assign) NSUInteger spillToDiskThreshold;
+
+/**
+ * @brief      Stores maximum size (in bytes) of played scenes content which cassette keep in memory during playback.
+ * @discussion When budget exceeded, content of oldest played chapters released and loaded back from cassette file only if \c requests
+ *             or \c responses will be requested. Budget applied only to write protected cassettes. Value \c 0 keep all scenes in memory.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, assign) NSUInteger playedScenesMemoryBudget;
+
+/**
+ * @brief      Stores whether cassette's statistics should be printed into console when cassette ejected.
+ * @discussion Statistics contain load / save time, number of request lookups and matcher evaluations, amount of played and recorded
+ *             data and chapters replay latency. Same information can be retrieved at any moment from cassette's \c statistics.
+ *             By default set to: \c NO.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, assign) BOOL logStatisticsOnEject;
+
+/**
+ * @brief      Stores path to file into which cassette's playback and recording timeline should be written.
+ * @discussion Timeline written in Chrome trace-event format when cassette ejected and can be opened in any trace viewer. Each cassette
+ *             shown as separate process and each chapter as separate track with span for each scene. Events from all cassettes which
+ *             use same path during test suite run appended to same file.
+ *             By default set to: \c nil.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, nullable, copy) NSString *traceFilePath;
+
 /**
  * @brief  Stores reference on block which allow to alter request's URI path component before stub store.
  */
@@ -92,6 +166,8 @@ NS_ASSUME_NONNULL_BEGIN
  *             to pass \a NSDictionary instance which allow to replace or remove (should store [NSNull null] for \c key which should be removed)
  *             values in encoded POST body. \a NSDictionary can be used only against JSON object or \c application/x-www-form-urlencoded.
  *             \b YHVPostBodyFilterBlock can be used for same purpose and allow to make decisions dynamically basing on request.
+ * @discussion For JSON body keys replaced on any depth and key path (like \c user.token) can be used to target nested key. Rest of
+ *             JSON body stored without changes.
  */
 @property (nonatomic, nullable, copy) id postBodyFilter;
 
@@ -101,6 +177,8 @@ NS_ASSUME_NONNULL_BEGIN
  *             to pass \a NSDictionary instance which allow to replace or remove (should store [NSNull null] for \c key which should be removed)
  *             values in encoded POST body. \a NSDictionary can be used only against JSON object or \c application/x-www-form-urlencoded.
  *             \b YHVResponseBodyFilterBlock can be used for same purpose and allow to make decisions dynamically basing on response.
+ * @discussion For JSON body keys replaced on any depth and key path (like \c user.token) can be used to target nested key. Rest of
+ *             JSON body stored without changes.
  */
 @property (nonatomic, nullable, copy) id responseBodyFilter;
 
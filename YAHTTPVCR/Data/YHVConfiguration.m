@@ -16,6 +16,9 @@
  * @brief  Stores reference on block which allow to alter URI object before stub store.
  */
 @property (nonatomic, copy) YHVURLFilterBlock urlFilter;
+@property (nonatomic, copy) NSArray<NSString *> *matcherIdentifiers;
+@property (nonatomic, copy) NSArray<NSString *> *matcherNames;
+@property (nonatomic, copy) NSSet<NSString *> *lowercaseThrottledHosts;
 
 #pragma mark -
 
@@ -27,6 +30,15 @@
 @implementation YHVConfiguration
 
 
+#pragma mark - Information
+
+- (void)setThrottledHosts:(NSArray<NSString *> *)throttledHosts {
+    
+    _throttledHosts = [throttledHosts copy];
+    _lowercaseThrottledHosts = throttledHosts ? [NSSet setWithArray:[throttledHosts valueForKey:@"lowercaseString"]] : nil;
+}
+
+
 #pragma mark - Initialization and Configuration
 
 + (instancetype)defaultConfiguration {
@@ -59,6 +71,14 @@
     configuration.beforeRecordResponse = self.beforeRecordResponse;
     configuration.beforeRecordRequest = self.beforeRecordRequest;
     configuration.responseBodyFilter = self.responseBodyFilter;
+    configuration.playbackInitialLatency = self.playbackInitialLatency;
+    configuration.playbackBytesPerSecond = self.playbackBytesPerSecond;
+    configuration.playbackChunkSize = self.playbackChunkSize;
+    configuration.spillToDiskThreshold = self.spillToDiskThreshold;
+    configuration.playedScenesMemoryBudget = self.playedScenesMemoryBudget;
+    configuration.logStatisticsOnEject = self.logStatisticsOnEject;
+    configuration.traceFilePath = self.traceFilePath;
+    configuration.throttledHosts = self.throttledHosts;
     configuration.postBodyFilter = self.postBodyFilter;
     configuration.headersFilter = self.headersFilter;
     configuration.cassettesPath = self.cassettesPath;
@@ -68,6 +88,8 @@
     configuration.recordMode = self.recordMode;
     configuration.pathFilter = self.pathFilter;
     configuration.urlFilter = self.urlFilter;
+    configuration.matcherIdentifiers = self.matcherIdentifiers;
+    configuration.matcherNames = self.matcherNames;
     configuration.matchers = self.matchers;
     
     return configuration;
@@ -80,6 +102,14 @@
     configuration.beforeRecordResponse = configuration.beforeRecordResponse ?: defaultConfiguration.beforeRecordResponse;
     configuration.beforeRecordRequest = configuration.beforeRecordRequest ?: defaultConfiguration.beforeRecordRequest;
     configuration.responseBodyFilter = configuration.responseBodyFilter ?: defaultConfiguration.responseBodyFilter;
+    configuration.playbackInitialLatency = configuration.playbackInitialLatency ?: defaultConfiguration.playbackInitialLatency;
+    configuration.playbackBytesPerSecond = configuration.playbackBytesPerSecond ?: defaultConfiguration.playbackBytesPerSecond;
+    configuration.playbackChunkSize = configuration.playbackChunkSize ?: defaultConfiguration.playbackChunkSize;
+    configuration.spillToDiskThreshold = configuration.spillToDiskThreshold ?: defaultConfiguration.spillToDiskThreshold;
+    configuration.playedScenesMemoryBudget = configuration.playedScenesMemoryBudget ?: defaultConfiguration.playedScenesMemoryBudget;
+    configuration.logStatisticsOnEject = configuration.logStatisticsOnEject || defaultConfiguration.logStatisticsOnEject;
+    configuration.traceFilePath = configuration.traceFilePath ?: defaultConfiguration.traceFilePath;
+    configuration.throttledHosts = configuration.throttledHosts ?: defaultConfiguration.throttledHosts;
     configuration.postBodyFilter = configuration.postBodyFilter ?: defaultConfiguration.postBodyFilter;
     configuration.headersFilter = configuration.headersFilter ?: defaultConfiguration.headersFilter;
     configuration.cassettesPath = configuration.cassettesPath ?: defaultConfiguration.cassettesPath;
@@ -0,0 +1,41 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVLoadReplayReport.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Private interface declaration
+
+@interface YHVLoadReplayReport (Private)
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Create and configure replay report.
+ *
+ * @param latencies  Reference on list of completed requests latencies (in seconds).
+ * @param count      Number of requests which has been sent to target service.
+ * @param failed     Number of requests which failed with transport error.
+ * @param mismatched Number of responses which doesn't match to recorded response scenes.
+ * @param mismatches Reference on descriptions of responses mismatches.
+ * @param duration   How long (in seconds) replay took.
+ *
+ * @return Configured and ready to use replay report.
+ */
++ (instancetype)reportWithLatencies:(NSArray<NSNumber *> *)latencies
+                      requestsCount:(NSUInteger)count
+                failedRequestsCount:(NSUInteger)failed
+           mismatchedResponsesCount:(NSUInteger)mismatched
+                         mismatches:(NSArray<NSString *> *)mismatches
+                           duration:(NSTimeInterval)duration;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,95 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief  Results of cassette replay against target service.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVLoadReplayReport : NSObject
+
+
+#pragma mark Information
+
+/**
+ * @brief  Stores number of requests which has been sent to target service.
+ */
+@property (nonatomic, readonly, assign) NSUInteger requestsCount;
+
+/**
+ * @brief  Stores number of requests which failed with transport error while response has been recorded for them.
+ */
+@property (nonatomic, readonly, assign) NSUInteger failedRequestsCount;
+
+/**
+ * @brief  Stores number of responses which doesn't match to recorded response scenes.
+ */
+@property (nonatomic, readonly, assign) NSUInteger mismatchedResponsesCount;
+
+/**
+ * @brief      Stores reference on descriptions of responses mismatches.
+ * @discussion Only first \c 100 mismatches described.
+ */
+@property (nonatomic, readonly, copy) NSArray<NSString *> *mismatches;
+
+/**
+ * @brief  Stores how long (in seconds) replay took.
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval duration;
+
+/**
+ * @brief  Stores number of completed requests per second.
+ */
+@property (nonatomic, readonly, assign) double throughput;
+
+/**
+ * @brief  Stores median request latency (in seconds).
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval medianLatency;
+
+/**
+ * @brief  Stores 90th percentile of request latency (in seconds).
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval p90Latency;
+
+/**
+ * @brief  Stores 99th percentile of request latency (in seconds).
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval p99Latency;
+
+/**
+ * @brief  Stores maximum request latency (in seconds).
+ */
+@property (nonatomic, readonly, assign) NSTimeInterval maximumLatency;
+
+
+#pragma mark - Latency
+
+/**
+ * @brief  Calculate request latency for specified percentile.
+ *
+ * @param percentile Percentile (from \c 0 to \c 100) for which latency should be calculated.
+ *
+ * @return Request latency (in seconds) or \c 0 if there is no completed requests.
+ */
+- (NSTimeInterval)latencyAtPercentile:(double)percentile;
+
+
+#pragma mark - Serialization
+
+/**
+ * @brief  Compose dictionary which can be serialized to JSON for further processing.
+ *
+ * @return Dictionary with report's values.
+ */
+- (NSDictionary *)dictionaryRepresentation;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,138 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVLoadReplayReport+Private.h"
+
+
+#pragma mark Private interface declaration
+
+@interface YHVLoadReplayReport ()
+
+
+#pragma mark - Information
+
+@property (nonatomic, assign) NSUInteger requestsCount;
+@property (nonatomic, assign) NSUInteger failedRequestsCount;
+@property (nonatomic, assign) NSUInteger mismatchedResponsesCount;
+@property (nonatomic, copy) NSArray<NSString *> *mismatches;
+@property (nonatomic, assign) NSTimeInterval duration;
+
+/**
+ * @brief  Stores reference on sorted list of completed requests latencies.
+ */
+@property (nonatomic, copy) NSArray<NSNumber *> *latencies;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVLoadReplayReport
+
+
+#pragma mark - Information
+
+- (double)throughput {
+
+    return self.duration > 0.f ? self.latencies.count / self.duration : 0.f;
+}
+
+- (NSTimeInterval)medianLatency {
+
+    return [self latencyAtPercentile:50.f];
+}
+
+- (NSTimeInterval)p90Latency {
+
+    return [self latencyAtPercentile:90.f];
+}
+
+- (NSTimeInterval)p99Latency {
+
+    return [self latencyAtPercentile:99.f];
+}
+
+- (NSTimeInterval)maximumLatency {
+
+    return self.latencies.lastObject.doubleValue;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)reportWithLatencies:(NSArray<NSNumber *> *)latencies
+                      requestsCount:(NSUInteger)count
+                failedRequestsCount:(NSUInteger)failed
+           mismatchedResponsesCount:(NSUInteger)mismatched
+                         mismatches:(NSArray<NSString *> *)mismatches
+                           duration:(NSTimeInterval)duration {
+
+    YHVLoadReplayReport *report = [self new];
+    report.latencies = [latencies sortedArrayUsingSelector:@selector(compare:)];
+    report.mismatchedResponsesCount = mismatched;
+    report.failedRequestsCount = failed;
+    report.mismatches = mismatches;
+    report.requestsCount = count;
+    report.duration = duration;
+
+    return report;
+}
+
+
+#pragma mark - Latency
+
+- (NSTimeInterval)latencyAtPercentile:(double)percentile {
+
+    NSUInteger count = self.latencies.count;
+
+    if (!count) {
+        return 0.f;
+    }
+
+    // Nearest-rank percentile.
+    double rank = ceil(MIN(MAX(percentile, 0.f), 100.f) / 100.f * count);
+    NSUInteger index = rank > 0.f ? (NSUInteger)rank - 1 : 0;
+
+    return self.latencies[MIN(index, count - 1)].doubleValue;
+}
+
+
+#pragma mark - Serialization
+
+- (NSDictionary *)dictionaryRepresentation {
+
+    return @{
+        @"requests": @(self.requestsCount),
+        @"failed": @(self.failedRequestsCount),
+        @"mismatched": @(self.mismatchedResponsesCount),
+        @"mismatches": self.mismatches,
+        @"duration": @(self.duration),
+        @"throughput": @(self.throughput),
+        @"latency": @{
+            @"p50": @(self.medianLatency),
+            @"p90": @(self.p90Latency),
+            @"p99": @(self.p99Latency),
+            @"max": @(self.maximumLatency)
+        }
+    };
+}
+
+
+#pragma mark - Misc
+
+- (NSString *)description {
+
+    return [NSString stringWithFormat:@"<YHVLoadReplayReport %p requests: %@, failed: %@, mismatched: %@, throughput: %.2f req/s, "
+            "latency p50: %.4fs, p90: %.4fs, p99: %.4fs, max: %.4fs>", self, @(self.requestsCount), @(self.failedRequestsCount),
+            @(self.mismatchedResponsesCount), self.throughput, self.medianLatency, self.p90Latency, self.p99Latency,
+            self.maximumLatency];
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,40 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVRequestTag.h"
+
+
+#pragma mark Class forward
+
+@class YHVTeeInputStream;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Private interface declaration
+
+@interface YHVRequestTag ()
+
+
+#pragma mark - Information
+
+/**
+ * @brief      Stores reference on stream which is used to capture request's \c HTTPBodyStream content.
+ * @discussion Stream shared by all request copies, so captured body path and digest available for any of them once capture completed.
+ */
+@property (nonatomic, nullable, strong) YHVTeeInputStream *HTTPBodyStream;
+
+@property (nonatomic, assign) BOOL VCRIgnored;
+@property (nonatomic, assign) BOOL usingNSURLSession;
+@property (nonatomic, nullable, copy) NSString *identifier;
+@property (nonatomic, nullable, copy) NSString *cassetteIdentifier;
+@property (nonatomic, nullable, copy) NSString *cassetteChapterIdentifier;
+@property (nonatomic, nullable, copy) NSString *context;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
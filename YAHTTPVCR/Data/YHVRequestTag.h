@@ -0,0 +1,65 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      Storage for VCR information associated with request.
+ * @discussion Single tag object stored as \a NSURLProtocol property in request, so all VCR information can be retrieved with one property
+ *             lookup. Tag is immutable: request copies share tag which has been stored before copy, but any change create new tag for
+ *             changed request only, so copies stay independent.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVRequestTag : NSObject <NSSecureCoding, NSCopying>
+
+
+#pragma mark Information
+
+/**
+ * @brief  Stores whether request has been ignored by VCR or not.
+ */
+@property (nonatomic, readonly, assign) BOOL VCRIgnored;
+
+/**
+ * @brief  Stores whether request delivered using \a NSURLSession or \a NSURLConnection.
+ */
+@property (nonatomic, readonly, assign) BOOL usingNSURLSession;
+
+/**
+ * @brief  Stores reference on unique request identifier (inherited from task or own).
+ */
+@property (nonatomic, nullable, readonly, copy) NSString *identifier;
+
+/**
+ * @brief  Stores reference on identifier of cassette which handle request.
+ */
+@property (nonatomic, nullable, readonly, copy) NSString *cassetteIdentifier;
+
+/**
+ * @brief  Stores reference on identifier of chapter in which request used.
+ */
+@property (nonatomic, nullable, readonly, copy) NSString *cassetteChapterIdentifier;
+
+/**
+ * @brief  Stores reference on context which should be used to find out which of inserted cassettes should handle request.
+ */
+@property (nonatomic, nullable, readonly, copy) NSString *context;
+
+/**
+ * @brief  Stores reference on full path to file which contain captured \c HTTPBodyStream content.
+ */
+@property (nonatomic, nullable, readonly, copy) NSString *HTTPBodyPath;
+
+/**
+ * @brief  Stores reference on SHA-256 digest of captured \c HTTPBodyStream content.
+ */
+@property (nonatomic, nullable, readonly, copy) NSData *HTTPBodyDigest;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
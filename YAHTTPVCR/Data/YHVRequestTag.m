@@ -0,0 +1,130 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVRequestTag+Private.h"
+#import "YHVTeeInputStream.h"
+
+
+#pragma mark Constants
+
+/**
+ * @brief  Stores reference on key under which request ignorance flag stored by coder.
+ */
+static NSString * const kYHVRequestTagIgnoredKey = @"ignored";
+
+/**
+ * @brief  Stores reference on key under which \a NSURLSession usage flag stored by coder.
+ */
+static NSString * const kYHVRequestTagUsingSessionKey = @"session";
+
+/**
+ * @brief  Stores reference on key under which unique request identifier stored by coder.
+ */
+static NSString * const kYHVRequestTagIdentifierKey = @"id";
+
+/**
+ * @brief  Stores reference on key under which cassette identifier stored by coder.
+ */
+static NSString * const kYHVRequestTagCassetteIdentifierKey = @"cassette";
+
+/**
+ * @brief  Stores reference on key under which cassette chapter identifier stored by coder.
+ */
+static NSString * const kYHVRequestTagChapterIdentifierKey = @"chapter";
+
+/**
+ * @brief  Stores reference on key under which cassette context stored by coder.
+ */
+static NSString * const kYHVRequestTagContextKey = @"context";
+
+/**
+ * @brief  Stores reference on key under which path to captured body stream content stored by coder.
+ */
+static NSString * const kYHVRequestTagHTTPBodyPathKey = @"body";
+
+/**
+ * @brief  Stores reference on key under which captured body stream content digest stored by coder.
+ */
+static NSString * const kYHVRequestTagHTTPBodyDigestKey = @"digest";
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVRequestTag
+
+@synthesize HTTPBodyPath = _HTTPBodyPath;
+@synthesize HTTPBodyDigest = _HTTPBodyDigest;
+
+
+#pragma mark - Information
+
+- (NSString *)HTTPBodyPath {
+    
+    YHVTeeInputStream *stream = self.HTTPBodyStream;
+    
+    // Path to spill file can be used only after all source stream bytes has been written into it.
+    return stream.digest ? stream.path : _HTTPBodyPath;
+}
+
+- (NSData *)HTTPBodyDigest {
+    
+    return self.HTTPBodyStream.digest ?: _HTTPBodyDigest;
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (BOOL)supportsSecureCoding {
+    
+    return YES;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)coder {
+    
+    if ((self = [super init])) {
+        _VCRIgnored = [coder decodeBoolForKey:kYHVRequestTagIgnoredKey];
+        _usingNSURLSession = [coder decodeBoolForKey:kYHVRequestTagUsingSessionKey];
+        _identifier = [coder decodeObjectOfClass:[NSString class] forKey:kYHVRequestTagIdentifierKey];
+        _cassetteIdentifier = [coder decodeObjectOfClass:[NSString class] forKey:kYHVRequestTagCassetteIdentifierKey];
+        _cassetteChapterIdentifier = [coder decodeObjectOfClass:[NSString class] forKey:kYHVRequestTagChapterIdentifierKey];
+        _context = [coder decodeObjectOfClass:[NSString class] forKey:kYHVRequestTagContextKey];
+        _HTTPBodyPath = [coder decodeObjectOfClass:[NSString class] forKey:kYHVRequestTagHTTPBodyPathKey];
+        _HTTPBodyDigest = [coder decodeObjectOfClass:[NSData class] forKey:kYHVRequestTagHTTPBodyDigestKey];
+    }
+    
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)coder {
+    
+    [coder encodeBool:self.VCRIgnored forKey:kYHVRequestTagIgnoredKey];
+    [coder encodeBool:self.usingNSURLSession forKey:kYHVRequestTagUsingSessionKey];
+    [coder encodeObject:self.identifier forKey:kYHVRequestTagIdentifierKey];
+    [coder encodeObject:self.cassetteIdentifier forKey:kYHVRequestTagCassetteIdentifierKey];
+    [coder encodeObject:self.cassetteChapterIdentifier forKey:kYHVRequestTagChapterIdentifierKey];
+    [coder encodeObject:self.context forKey:kYHVRequestTagContextKey];
+    [coder encodeObject:self.HTTPBodyPath forKey:kYHVRequestTagHTTPBodyPathKey];
+    [coder encodeObject:self.HTTPBodyDigest forKey:kYHVRequestTagHTTPBodyDigestKey];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    
+    YHVRequestTag *tag = [[[self class] allocWithZone:zone] init];
+    tag->_VCRIgnored = _VCRIgnored;
+    tag->_usingNSURLSession = _usingNSURLSession;
+    tag->_identifier = _identifier;
+    tag->_cassetteIdentifier = _cassetteIdentifier;
+    tag->_cassetteChapterIdentifier = _cassetteChapterIdentifier;
+    tag->_context = _context;
+    tag->_HTTPBodyStream = _HTTPBodyStream;
+    tag->_HTTPBodyPath = _HTTPBodyPath;
+    tag->_HTTPBodyDigest = _HTTPBodyDigest;
+    
+    return tag;
+}
+
+#pragma mark -
+
+
+@end
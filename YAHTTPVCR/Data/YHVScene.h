@@ -33,6 +33,47 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, readonly, strong) id<YHVSerializableDataProtocol> data;
 
+/**
+ * @brief      Stores reference on path to file which contain scene's data.
+ * @discussion Large response bodies stored in temporary files to reduce memory usage. In this case \c data is memory mapped content of
+ *             this file.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, nullable, readonly, copy) NSString *dataPath;
+
+/**
+ * @brief      Stores reference on value of \c Content-Type header which describe scene's data.
+ * @discussion Textual data scenes serialized as inline UTF-8 string instead of Base64 encoded string.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, nullable, copy) NSString *contentType;
+
+/**
+ * @brief      Stores whether scene has been restored from cassette.
+ * @discussion Serialized data decoded only on first \c data access and reused as-is when cassette is saved.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, readonly, assign, getter = isSerialized) BOOL serialized;
+
+/**
+ * @brief      Stores whether scene's data has been released or not.
+ * @discussion Released scene's \c data is \c nil till serialized data will be restored.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, readonly, assign, getter = isDataReleased) BOOL dataReleased;
+
+/**
+ * @brief      Stores approximate number of bytes which is used by scene's data.
+ * @discussion Size of decoded and serialized data representations taken into account.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, readonly, assign) NSUInteger estimatedDataSize;
+
 /**
  * @brief  Stores whether scene currently playing it's content or not.
  */
@@ -57,6 +98,19 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (instancetype)sceneWithIdentifier:(NSString *)identifier type:(YHVSceneType)type data:(nullable id)data;
 
+/**
+ * @brief  Create and configure scene instance which use content of file as it's data.
+ *
+ * @param identifier Unique chapter identifier to which scene belongs.
+ * @param type       Type of scene and data which stored in scene.
+ * @param path       Reference on path to file which contain scene's data.
+ *
+ * @return Configured and read to use scene instance or \c nil in case if file can't be mapped.
+ *
+ * @since 1.6.0
+ */
++ (nullable instancetype)sceneWithIdentifier:(NSString *)identifier type:(YHVSceneType)type dataAtPath:(NSString *)path;
+
 
 #pragma mark - Playback
 
@@ -74,6 +128,26 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)setPlayed;
 
+
+#pragma mark - Memory management
+
+/**
+ * @brief      Release decoded and serialized scene's data.
+ * @discussion Only scenes which has been restored from cassette can release their data.
+ *
+ * @since 1.6.0
+ */
+- (void)releaseData;
+
+/**
+ * @brief  Restore serialized data of scene which released it's data before.
+ *
+ * @param serializedData Reference on serialized scene's data which has been loaded from cassette.
+ *
+ * @since 1.6.0
+ */
+- (void)restoreSerializedData:(id)serializedData;
+
 #pragma mark -
 
 
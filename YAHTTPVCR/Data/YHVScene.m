@@ -4,10 +4,16 @@
  */
 #import "YHVScene.h"
 #import "YHVSerializationHelper.h"
+#import "NSData+YHVSerialization.h"
 
 
 #pragma mark Constants
 
+/**
+ * @brief  Stores approximate size of objects (requests, responses and errors) which is stored in scene.
+ */
+static NSUInteger const kYHVSceneObjectDataSizeEstimate = 1024;
+
 /**
  * @brief  Stores reference on key under which stored unique scene identifier inside of serialized dictionary.
  */
@@ -55,6 +61,35 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong) id<YHVSerializableDataProtocol> data;
 
+/**
+ * @brief  Stores reference on path to file which contain scene's data.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, nullable, copy) NSString *dataPath;
+
+/**
+ * @brief      Stores reference on serialized scene's data which has been restored from cassette.
+ * @discussion Used to decode \c data on demand and as scene's data representation during cassette save.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, nullable, strong) id serializedData;
+
+/**
+ * @brief  Stores whether \c serializedData already has been decoded into \c data or not.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, assign) BOOL dataDecoded;
+
+/**
+ * @brief  Stores whether scene's data has been released or not.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, assign) BOOL dataReleased;
+
 /**
  * @brief  Stores whether scene currently playing it's content or not.
  */
@@ -79,18 +114,6 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (instancetype)initWithIdentifier:(NSString *)identifier type:(YHVSceneType)type data:(nullable id)data;
 
-
-#pragma mark - Deserialization
-
-/**
- * @brief  Extract data object which is presented with scene.
- *
- * @param dictionary Reference on dictionary which present previously serialized scene.
- *
- * @return Reference on previously represented data object.
- */
-+ (nullable id)dataObjectFromDictionary:(NSDictionary *)dictionary;
-
 #pragma mark -
 
 
@@ -106,6 +129,62 @@ NS_ASSUME_NONNULL_END
 
 #pragma mark - Information
 
+- (id<YHVSerializableDataProtocol>)data {
+    
+    __block id<YHVSerializableDataProtocol> data = nil;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        if (self->_serializedData && !self->_dataDecoded) {
+            self->_data = [YHVSerializationHelper objectFromDictionary:self->_serializedData];
+            self->_dataDecoded = YES;
+        }
+        
+        data = self->_data;
+    });
+    
+    return data;
+}
+
+- (BOOL)isSerialized {
+    
+    __block BOOL serialized = NO;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        serialized = self->_serializedData != nil || self->_dataReleased;
+    });
+    
+    return serialized;
+}
+
+- (BOOL)isDataReleased {
+    
+    __block BOOL dataReleased = NO;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        dataReleased = self->_dataReleased;
+    });
+    
+    return dataReleased;
+}
+
+- (NSUInteger)estimatedDataSize {
+    
+    __block NSUInteger size = 0;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        id data = self->_data;
+        
+        if ([data isKindOfClass:[NSData class]]) {
+            size += ((NSData *)data).length;
+        } else if (data) {
+            size += kYHVSceneObjectDataSizeEstimate;
+        }
+        
+        // Serialized data stored as dictionary with Base64 / UTF-8 string or as nested dictionaries for objects.
+        for (id value in [self->_serializedData isKindOfClass:[NSDictionary class]] ? [self->_serializedData allValues] : @[]) {
+            size += [value isKindOfClass:[NSString class]] ? ((NSString *)value).length : kYHVSceneObjectDataSizeEstimate;
+        }
+    });
+    
+    return size;
+}
+
 - (BOOL)playing {
     
     __block BOOL playing = NO;
@@ -140,7 +219,11 @@ NS_ASSUME_NONNULL_END
         NSAssert(dictionary[kYHVSceneDataKey], @"Scene data is 'nil'.");
     }
     
-    return [self sceneWithIdentifier:dictionary[kYHVSceneIdentifierKey] type:type data:[self dataObjectFromDictionary:dictionary]];
+    // Scene's data decoded only when it will be requested for first time.
+    YHVScene *scene = [self sceneWithIdentifier:dictionary[kYHVSceneIdentifierKey] type:type data:nil];
+    scene.serializedData = dictionary[kYHVSceneDataKey];
+    
+    return scene;
 }
 
 + (instancetype)sceneWithIdentifier:(NSString *)identifier type:(YHVSceneType)type data:(id)data {
@@ -153,6 +236,19 @@ NS_ASSUME_NONNULL_END
     return [[self alloc] initWithIdentifier:identifier type:type data:data];
 }
 
++ (instancetype)sceneWithIdentifier:(NSString *)identifier type:(YHVSceneType)type dataAtPath:(NSString *)path {
+    
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:nil];
+    YHVScene *scene = nil;
+    
+    if (data) {
+        scene = [self sceneWithIdentifier:identifier type:type data:data];
+        scene.dataPath = path;
+    }
+    
+    return scene;
+}
+
 - (instancetype)initWithIdentifier:(NSString *)identifier type:(YHVSceneType)type data:(id)data {
     
     if ((self = [super init])) {
@@ -186,27 +282,60 @@ NS_ASSUME_NONNULL_END
 }
 
 
+#pragma mark - Memory management
+
+- (void)releaseData {
+    
+    dispatch_sync(self.resourceAccessQueue, ^{
+        if (!self->_serializedData) {
+            return;
+        }
+        
+        self->_serializedData = nil;
+        self->_dataDecoded = NO;
+        self->_dataReleased = YES;
+        self->_data = nil;
+    });
+}
+
+- (void)restoreSerializedData:(id)serializedData {
+    
+    dispatch_sync(self.resourceAccessQueue, ^{
+        if (!self->_dataReleased) {
+            return;
+        }
+        
+        self->_serializedData = serializedData;
+        self->_dataReleased = NO;
+    });
+}
+
+
 #pragma mark - Serialization
 
 - (NSDictionary *)YHV_dictionaryRepresentation {
     
     NSMutableDictionary *dictionary = [NSMutableDictionary new];
     dictionary[kYHVSceneIdentifierKey] = self.identifier;
-    dictionary[kYHVSceneDataKey] = [YHVSerializationHelper dictionaryFromObject:self.data];
     dictionary[kYHVSceneTypeKey] = @(self.type);
     
+    __block id serializedData = nil;
+    dispatch_sync(self.resourceAccessQueue, ^{
+        serializedData = self->_serializedData;
+    });
+    
+    if (serializedData) {
+        dictionary[kYHVSceneDataKey] = serializedData;
+    } else if (self.contentType && [(id)self.data isKindOfClass:[NSData class]]) {
+        dictionary[kYHVSceneDataKey] = [(NSData *)self.data YHV_dictionaryRepresentationWithContentType:self.contentType];
+    } else {
+        dictionary[kYHVSceneDataKey] = [YHVSerializationHelper dictionaryFromObject:self.data];
+    }
+    
     return dictionary;
 }
 
 
-#pragma mark - Deserialization
-
-+ (id)dataObjectFromDictionary:(NSDictionary *)dictionary {
-
-    return dictionary[kYHVSceneDataKey] ? [YHVSerializationHelper objectFromDictionary:dictionary[kYHVSceneDataKey]] : nil;
-}
-
-
 #pragma mark - Misc
 
 - (NSString *)description {
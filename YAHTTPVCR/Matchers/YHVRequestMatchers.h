@@ -71,6 +71,25 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (BOOL)request:(NSURLRequest *)originalRequest isMatchingTo:(NSURLRequest *)stubRequest withMatchers:(NSArray<YHVMatcherBlock> *)matchers;
 
+/**
+ * @brief      Check whether two requests match to each other and count matchers evaluations.
+ * @discussion Matchers evaluated in order and evaluation stops on first mismatch, so only evaluated matchers counted.
+ *
+ * @param originalRequest Reference on request which has been passed from URL loading system.
+ * @param stubRequest     Reference on request which has been passed from cassette's tape.
+ * @param matchers        Reference on list of matchers which should be used.
+ * @param counts          Pointer on array (with same number of elements as in \c matchers) in which counter of each evaluated matcher
+ *                        should be increased.
+ *
+ * @return \c YES in case if all matchers returned positive response.
+ *
+ * @since 1.6.0
+ */
++ (BOOL)request:(NSURLRequest *)originalRequest
+   isMatchingTo:(NSURLRequest *)stubRequest
+   withMatchers:(NSArray<YHVMatcherBlock> *)matchers
+    evaluations:(nullable NSUInteger *)counts;
+
 #pragma mark -
 
 
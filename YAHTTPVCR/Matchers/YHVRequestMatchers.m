@@ -145,6 +145,15 @@
 + (YHVMatcherBlock)body {
     
     return ^BOOL (NSURLRequest *request, NSURLRequest *stubRequest) {
+        // Streamed bodies compared by digest first, so identical uploads won't be loaded for comparison.
+        if (request.HTTPBodyStream || stubRequest.HTTPBodyStream) {
+            NSData *requestDigest = request.YHV_HTTPBodyDigest;
+            
+            if (requestDigest && [requestDigest isEqualToData:stubRequest.YHV_HTTPBodyDigest]) {
+                return YES;
+            }
+        }
+        
         if (!request.YHV_HTTPBody && !stubRequest.YHV_HTTPBody) {
 #if YHV_OUTPUT_MATCHING
              NSLog(@"\nBODY MATCH (STUB %@)\nORIG: %@\nSTUB: %@\nMATCH: YES",
@@ -219,6 +228,15 @@
 
 + (BOOL)request:(NSURLRequest *)originalRequest isMatchingTo:(NSURLRequest *)stubRequest withMatchers:(NSArray<YHVMatcherBlock> *)matchers {
     
+    return [self request:originalRequest isMatchingTo:stubRequest withMatchers:matchers evaluations:NULL];
+}
+
++ (BOOL)request:(NSURLRequest *)originalRequest
+   isMatchingTo:(NSURLRequest *)stubRequest
+   withMatchers:(NSArray<YHVMatcherBlock> *)matchers
+    evaluations:(NSUInteger *)counts {
+    
+    NSUInteger matcherIdx = 0;
     BOOL match = NO;
     
     if (!matchers.count) {
@@ -228,9 +246,15 @@
     for (YHVMatcherBlock matchBlock in matchers) {
         match = matchBlock(originalRequest, stubRequest);
         
+        if (counts) {
+            counts[matcherIdx]++;
+        }
+        
         if (!match) {
             break;
         }
+        
+        matcherIdx++;
     }
     
     return match;
@@ -20,7 +20,16 @@ NS_ASSUME_NONNULL_BEGIN
  *
  * @return Uncompressed binary data.
  */
-- (NSData *)YHV_unzipped;
+- (nullable NSData *)YHV_unzipped;
+
+/**
+ * @brief Compress data using \c gzip format.
+ *
+ * @return Compressed binary data.
+ *
+ * @since 1.6.0
+ */
+- (nullable NSData *)YHV_zipped;
 
 #pragma nark -
 
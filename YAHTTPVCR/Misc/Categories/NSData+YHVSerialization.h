@@ -11,6 +11,21 @@
 @interface NSData (YHVSerialization) <YHVSerializableDataProtocol>
 
 
+#pragma mark - Serialization
+
+/**
+ * @brief      Serialize data with respect to type of it's content.
+ * @discussion Data which represent textual content (according to \c contentType) and is valid UTF-8 stored as inline string. All other
+ *             data stored as Base64 encoded string.
+ *
+ * @param contentType Value of \c Content-Type header which describe data.
+ *
+ * @return Data dictionary representation.
+ *
+ * @since 1.6.0
+ */
+- (NSDictionary *)YHV_dictionaryRepresentationWithContentType:(NSString *)contentType;
+
 #pragma mark -
 
 
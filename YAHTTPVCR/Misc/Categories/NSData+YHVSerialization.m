@@ -3,6 +3,8 @@
  * @since 1.0.0
  */
 #import "NSData+YHVSerialization.h"
+#import "YHVSerializationHelper+Private.h"
+#import "YHVBase64.h"
 
 
 #pragma mark Constants
@@ -17,6 +19,35 @@ static NSString * const kYHVObjectClassKey = @"cls";
  */
 static NSString * const kYHVDataKey = @"base64";
 
+/**
+ * @brief  Stores reference on key under which UTF-8 string stored inside of serialized dictionary.
+ */
+static NSString * const kYHVTextKey = @"text";
+
+
+#pragma mark - Private interface declaration
+
+@interface NSData (YHVSerializationPrivate)
+
+
+#pragma mark - Misc
+
+/**
+ * @brief  Check whether passed content type describe textual content which can be stored as UTF-8 string.
+ *
+ * @param contentType Value of \c Content-Type header.
+ *
+ * @return \c YES in case if content type represent text in UTF-8 (or compatible) encoding.
+ *
+ * @since 1.6.0
+ */
++ (BOOL)YHV_isTextContentType:(NSString *)contentType;
+
+#pragma mark -
+
+
+@end
+
 
 #pragma mark - Interface implementation
 
@@ -28,17 +59,69 @@ static NSString * const kYHVDataKey = @"base64";
 - (NSDictionary *)YHV_dictionaryRepresentation {
     
     NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithDictionary:@{ kYHVObjectClassKey: NSStringFromClass([NSData class]) }];
-    dictionary[kYHVDataKey] = [self base64EncodedStringWithOptions:(NSDataBase64EncodingOptions)0];
+    dictionary[kYHVDataKey] = [YHVBase64 stringByEncodingData:self];
     
     return dictionary;
 }
 
+- (NSDictionary *)YHV_dictionaryRepresentationWithContentType:(NSString *)contentType {
+    
+    static uint8_t const kYHVUTF8BOM[] = { 0xEF, 0xBB, 0xBF };
+    NSString *text = nil;
+    
+    // BOM dropped during string conversion, so such data kept as binary to be restored byte-to-byte.
+    if (self.length && [NSData YHV_isTextContentType:contentType] &&
+        (self.length < sizeof(kYHVUTF8BOM) || memcmp(self.bytes, kYHVUTF8BOM, sizeof(kYHVUTF8BOM)) != 0)) {
+        
+        text = [[NSString alloc] initWithData:self encoding:NSUTF8StringEncoding];
+    }
+    
+    if (!text) {
+        return [self YHV_dictionaryRepresentation];
+    }
+    
+    return @{ kYHVObjectClassKey: kYHVTextDataClassTag, kYHVTextKey: text };
+}
+
 + (instancetype)YHV_objectFromDictionary:(NSDictionary *)dictionary {
     
     NSAssert(dictionary, @"[%@] Unable initialize NSURLRequest instance from 'nil'.", NSStringFromClass(self));
-    NSAssert(dictionary[kYHVDataKey], @"[%@] Data base64 string is missing.", NSStringFromClass(self));
+    NSAssert(dictionary[kYHVDataKey] || dictionary[kYHVTextKey], @"[%@] Data base64 string is missing.", NSStringFromClass(self));
+    
+    if ([dictionary[kYHVTextKey] isKindOfClass:[NSString class]]) {
+        return [((NSString *)dictionary[kYHVTextKey]) dataUsingEncoding:NSUTF8StringEncoding];
+    }
+    
+    return [YHVBase64 dataByDecodingString:dictionary[kYHVDataKey]];
+}
+
+
+#pragma mark - Misc
+
++ (BOOL)YHV_isTextContentType:(NSString *)contentType {
+    
+    NSArray<NSString *> *components = [contentType.lowercaseString componentsSeparatedByString:@";"];
+    NSString *mimeType = [components.firstObject stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
+    
+    if (!mimeType.length) {
+        return NO;
+    }
+    
+    for (NSUInteger componentIdx = 1; componentIdx < components.count; componentIdx++) {
+        NSString *parameter = [components[componentIdx] stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
+        
+        if ([parameter hasPrefix:@"charset="]) {
+            NSString *charset = [[parameter substringFromIndex:8] stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"\"'"]];
+            
+            if (![@[@"utf-8", @"utf8", @"us-ascii"] containsObject:charset]) {
+                return NO;
+            }
+        }
+    }
     
-    return [[self alloc] initWithBase64EncodedString:dictionary[kYHVDataKey] options:(NSDataBase64DecodingOptions)0];
+    return ([mimeType hasPrefix:@"text/"] || [mimeType hasSuffix:@"/json"] || [mimeType hasSuffix:@"+json"] ||
+            [mimeType hasSuffix:@"/xml"] || [mimeType hasSuffix:@"+xml"] ||
+            [@[@"application/x-www-form-urlencoded", @"application/javascript", @"application/graphql"] containsObject:mimeType]);
 }
 
 #pragma mark -
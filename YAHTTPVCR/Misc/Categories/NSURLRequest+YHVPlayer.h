@@ -1,4 +1,11 @@
 #import <Foundation/Foundation.h>
+#import "YHVStructures.h"
+
+
+#pragma mark Class forward
+
+@class YHVRequestTag;
+
 
 /**
  * @brief      \a NSURLRequest functionality extension.
@@ -13,10 +20,29 @@
 #pragma mark Information
 
 /**
- * @brief  Stores reference on configured POST body.
+ * @brief      Stores reference on object which contain all VCR information associated with request.
+ * @discussion Tag allow to read multiple values with single request property lookup.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, readonly, strong) YHVRequestTag *YHV_tag;
+
+/**
+ * @brief      Stores reference on configured POST body.
+ * @discussion If request body has been provided with \c HTTPBodyStream, captured stream content will be returned (if stream has been
+ *             read already).
  */
 @property (nonatomic, readonly, strong) NSData *YHV_HTTPBody;
 
+/**
+ * @brief      Stores reference on SHA-256 digest of POST body.
+ * @discussion If request body has been provided with \c HTTPBodyStream which hasn't been read yet, it will be drained to compute
+ *             digest.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, readonly, strong) NSData *YHV_HTTPBodyDigest;
+
 /**
  * @brief  Stores whether request has been ignored by VCR or not.
  *
@@ -48,6 +74,14 @@
  */
 @property (nonatomic, copy) NSString *YHV_cassetteChapterIdentifier;
 
+/**
+ * @brief      Stores reference on context which should be used to find out which of inserted cassettes should handle this request.
+ * @discussion Context can be set only once.
+ *
+ * @since 1.6.0
+ */
+@property (nonatomic, copy) NSString *YHV_context;
+
 
 #pragma mark - Compare
 
@@ -84,6 +118,28 @@
  */
 + (void)patch;
 
+
+#pragma mark - POST body capture
+
+/**
+ * @brief      Start POST body capture for requests which is sent to hosts allowed by filter.
+ * @discussion POST body captured by reference (w/o copy) and only while cassette inserted into VCR. \c HTTPBodyStream content captured
+ *             into temporary file while it is read by URL loading system. Interface will be patched if required.
+ *
+ * @param hostsFilter Reference on block which allow to decide whether body for request to specified host should be captured or not. If
+ *                    \c nil passed, body will be captured for all hosts.
+ *
+ * @since 1.6.0
+ */
++ (void)enableHTTPBodyCaptureWithHostsFilter:(YHVHostFilterBlock)hostsFilter;
+
+/**
+ * @brief  Stop POST body capture.
+ *
+ * @since 1.6.0
+ */
++ (void)disableHTTPBodyCapture;
+
 #pragma mark -
 
 
@@ -4,24 +4,88 @@
  */
 #import "NSURLRequest+YHVPlayer.h"
 #import "YHVMethodsSwizzler.h"
+#import "YHVTeeInputStream.h"
+#import "YHVRequestTag+Private.h"
+#import <CommonCrypto/CommonDigest.h>
+#import <stdatomic.h>
 
 
 #pragma mark Constants
 
-static NSString * const kYHVRequestCassetteChapterIdentifierKey = @"YHVRequestCassetteChapterIdentifier";
-static NSString * const kYHVRequestCassetteIdentifierKey = @"YHVRequestCassetteIdentifier";
-static NSString * const kYHVRequestUsingSessionKey = @"YHVRequestUsingSession";
-static NSString * const kYHVRequestIdentifierKey = @"YHVRequestIdentifier";
 static NSString * const kYHVRequestPOSTBodyKey = @"YHVRequestPOSTBody";
-static NSString * const kYHVRequestIgnoredKey = @"kYHVRequestIgnored";
+static NSString * const kYHVRequestTagKey = @"YHVRequestTag";
+
+
+#pragma mark - Statics
+
+/**
+ * @brief  Storage for flag which specify whether POST body should be captured or not.
+ *
+ * @since 1.6.0
+ */
+static atomic_bool YHVHTTPBodyCaptureEnabled = false;
+
+/**
+ * @brief  Storage for block which is used to decide whether body for request to specified host should be captured or not.
+ *
+ * @since 1.6.0
+ */
+static YHVHostFilterBlock YHVHTTPBodyCaptureHostsFilter = nil;
+
+
+#pragma mark - Private interface declaration
+
+@interface NSURLRequest (YHVPlayerPrivate)
+
+
+#pragma mark - Information
+
+/**
+ * @brief      Replace request's tag with updated copy.
+ * @discussion Tag which is stored in request may be shared with request copies, so it never modified in place.
+ *
+ * @param block Reference on block which should update passed tag copy and return whether it should be stored or not.
+ *
+ * @since 1.6.0
+ */
+- (void)YHV_updateTagWithBlock:(BOOL(^)(YHVRequestTag *tag))block;
+
+#pragma mark -
+
+
+@end
 
 
 @interface YHVNSURLRequest ()
 
 
+#pragma mark - Information
+
+/**
+ * @brief  Retrieve reference on queue which is used to serialize access to POST body capture configuration.
+ *
+ * @return Reference on serial queue.
+ *
+ * @since 1.6.0
+ */
++ (dispatch_queue_t)resourceAccessQueue;
+
+/**
+ * @brief  Check whether POST body of passed request should be captured or not.
+ *
+ * @param request Reference on request for which POST body has been set.
+ *
+ * @return Whether body capture enabled and request's host allowed by filter or not.
+ *
+ * @since 1.6.0
+ */
++ (BOOL)shouldCaptureHTTPBodyForRequest:(NSURLRequest *)request;
+
+
 #pragma mark - Swizzle methods
 
 - (void)YHV_setHTTPBody:(NSData * _Nullable)HTTPBody;
+- (void)YHV_setHTTPBodyStream:(NSInputStream * _Nullable)HTTPBodyStream;
 
 #pragma mark -
 
@@ -38,63 +102,157 @@ static NSString * const kYHVRequestIgnoredKey = @"kYHVRequestIgnored";
 
 - (NSData *)YHV_HTTPBody {
     
-    return [NSURLProtocol propertyForKey:kYHVRequestPOSTBodyKey inRequest:self] ?: self.HTTPBody;
+    NSData *body = [NSURLProtocol propertyForKey:kYHVRequestPOSTBodyKey inRequest:self] ?: self.HTTPBody;
+    NSString *bodyPath = !body ? self.YHV_tag.HTTPBodyPath : nil;
+    
+    if (bodyPath) {
+        body = [NSData dataWithContentsOfFile:bodyPath options:NSDataReadingMappedAlways error:nil];
+    }
+    
+    return body;
+}
+
+- (NSData *)YHV_HTTPBodyDigest {
+    
+    NSData *body = [NSURLProtocol propertyForKey:kYHVRequestPOSTBodyKey inRequest:self] ?: self.HTTPBody;
+    YHVRequestTag *tag = self.YHV_tag;
+    
+    if (!body && !tag.HTTPBodyDigest && [self.HTTPBodyStream isKindOfClass:[YHVTeeInputStream class]]) {
+        [(YHVTeeInputStream *)self.HTTPBodyStream drain];
+    }
+    
+    if (!body && tag.HTTPBodyDigest) {
+        return tag.HTTPBodyDigest;
+    } else if (!body) {
+        return nil;
+    }
+    
+    NSMutableData *digest = [NSMutableData dataWithLength:CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(body.bytes, (CC_LONG)body.length, digest.mutableBytes);
+    
+    return digest;
+}
+
+- (YHVRequestTag *)YHV_tag {
+    
+    return [NSURLProtocol propertyForKey:kYHVRequestTagKey inRequest:self];
+}
+
+- (void)YHV_updateTagWithBlock:(BOOL(^)(YHVRequestTag *tag))block {
+    
+    YHVRequestTag *tag = [self.YHV_tag copy] ?: [YHVRequestTag new];
+    
+    if (block(tag)) {
+        [NSURLProtocol setProperty:tag forKey:kYHVRequestTagKey inRequest:(NSMutableURLRequest *)self];
+    }
 }
 
 - (void)setYHV_VCRIgnored:(BOOL)ignored {
     
-    [NSURLProtocol setProperty:@(ignored) forKey:kYHVRequestIgnoredKey inRequest:(NSMutableURLRequest *)self];
+    if (self.YHV_tag.VCRIgnored == ignored) {
+        return;
+    }
+    
+    [self YHV_updateTagWithBlock:^BOOL (YHVRequestTag *tag) {
+        tag.VCRIgnored = ignored;
+        
+        return YES;
+    }];
 }
 
 - (BOOL)YHV_VCRIgnored {
     
-    return ((NSNumber *)[NSURLProtocol propertyForKey:kYHVRequestIgnoredKey inRequest:self]).boolValue;
+    return self.YHV_tag.VCRIgnored;
 }
 
 - (void)setYHV_usingNSURLSession:(BOOL)usingNSURLSession {
     
-    [NSURLProtocol setProperty:@(usingNSURLSession) forKey:kYHVRequestUsingSessionKey inRequest:(NSMutableURLRequest *)self];
+    if (self.YHV_tag.usingNSURLSession == usingNSURLSession) {
+        return;
+    }
+    
+    [self YHV_updateTagWithBlock:^BOOL (YHVRequestTag *tag) {
+        tag.usingNSURLSession = usingNSURLSession;
+        
+        return YES;
+    }];
 }
 
 - (BOOL)YHV_usingNSURLSession {
     
-    return ((NSNumber *)[NSURLProtocol propertyForKey:kYHVRequestUsingSessionKey inRequest:self]).boolValue;
+    return self.YHV_tag.usingNSURLSession;
 }
 
 - (void)setYHV_identifier:(NSString *)identifier {
     
-    if (!self.YHV_identifier) {
-        [NSURLProtocol setProperty:identifier forKey:kYHVRequestIdentifierKey inRequest:(NSMutableURLRequest *)self];
-    }
+    [self YHV_updateTagWithBlock:^BOOL (YHVRequestTag *tag) {
+        if (tag.identifier) {
+            return NO;
+        }
+        
+        tag.identifier = identifier;
+        
+        return YES;
+    }];
 }
 
 - (NSString *)YHV_identifier {
     
-    return [NSURLProtocol propertyForKey:kYHVRequestIdentifierKey inRequest:self];
+    return self.YHV_tag.identifier;
 }
 
 - (void)setYHV_cassetteIdentifier:(NSString *)identifier {
     
-    if (!self.YHV_cassetteIdentifier) {
-        [NSURLProtocol setProperty:identifier forKey:kYHVRequestCassetteIdentifierKey inRequest:(NSMutableURLRequest *)self];
-    }
+    [self YHV_updateTagWithBlock:^BOOL (YHVRequestTag *tag) {
+        if (tag.cassetteIdentifier) {
+            return NO;
+        }
+        
+        tag.cassetteIdentifier = identifier;
+        
+        return YES;
+    }];
 }
 
 - (NSString *)YHV_cassetteIdentifier {
     
-    return [NSURLProtocol propertyForKey:kYHVRequestCassetteIdentifierKey inRequest:self];
+    return self.YHV_tag.cassetteIdentifier;
 }
 
 - (void)setYHV_cassetteChapterIdentifier:(NSString *)identifier {
     
-    if (!self.YHV_cassetteChapterIdentifier) {
-        [NSURLProtocol setProperty:identifier forKey:kYHVRequestCassetteChapterIdentifierKey inRequest:(NSMutableURLRequest *)self];
-    }
+    [self YHV_updateTagWithBlock:^BOOL (YHVRequestTag *tag) {
+        if (tag.cassetteChapterIdentifier) {
+            return NO;
+        }
+        
+        tag.cassetteChapterIdentifier = identifier;
+        
+        return YES;
+    }];
 }
 
 - (NSString *)YHV_cassetteChapterIdentifier {
     
-    return [NSURLProtocol propertyForKey:kYHVRequestCassetteChapterIdentifierKey inRequest:self];
+    return self.YHV_tag.cassetteChapterIdentifier;
+}
+
+- (void)setYHV_context:(NSString *)context {
+    
+    [self YHV_updateTagWithBlock:^BOOL (YHVRequestTag *tag) {
+        if (tag.context) {
+            return NO;
+        }
+        
+        tag.context = context;
+        
+        return YES;
+    }];
+}
+
+- (NSString *)YHV_context {
+    
+    return self.YHV_tag.context;
 }
 
 
@@ -170,6 +328,37 @@ static NSString * const kYHVRequestIgnoredKey = @"kYHVRequestIgnored";
 @implementation YHVNSURLRequest
 
 
+#pragma mark - Information
+
++ (dispatch_queue_t)resourceAccessQueue {
+    
+    static dispatch_queue_t _sharedResourceAccessQueue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _sharedResourceAccessQueue = dispatch_queue_create("com.yetanotherhttpvcr.request", DISPATCH_QUEUE_SERIAL);
+    });
+    
+    return _sharedResourceAccessQueue;
+}
+
++ (BOOL)shouldCaptureHTTPBodyForRequest:(NSURLRequest *)request {
+    
+    if (!atomic_load(&YHVHTTPBodyCaptureEnabled)) {
+        return NO;
+    }
+    
+    __block YHVHostFilterBlock hostsFilter = nil;
+    __block BOOL captureEnabled = NO;
+    
+    dispatch_sync(self.resourceAccessQueue, ^{
+        captureEnabled = atomic_load(&YHVHTTPBodyCaptureEnabled);
+        hostsFilter = YHVHTTPBodyCaptureHostsFilter;
+    });
+    
+    return captureEnabled && (!hostsFilter || !request.URL.host || hostsFilter(request.URL.host));
+}
+
+
 #pragma mark - Initialization
 
 + (void)patch {
@@ -181,17 +370,61 @@ static NSString * const kYHVRequestIgnoredKey = @"kYHVRequestIgnored";
 }
 
 
+#pragma mark - POST body capture
+
++ (void)enableHTTPBodyCaptureWithHostsFilter:(YHVHostFilterBlock)hostsFilter {
+    
+    [self patch];
+    
+    dispatch_sync(self.resourceAccessQueue, ^{
+        YHVHTTPBodyCaptureHostsFilter = [hostsFilter copy];
+        atomic_store(&YHVHTTPBodyCaptureEnabled, true);
+    });
+}
+
++ (void)disableHTTPBodyCapture {
+    
+    dispatch_sync(self.resourceAccessQueue, ^{
+        atomic_store(&YHVHTTPBodyCaptureEnabled, false);
+        YHVHTTPBodyCaptureHostsFilter = nil;
+    });
+}
+
+
 #pragma mark - Swizzle methods
 
 - (void)YHV_setHTTPBody:(NSData *)HTTPBody {
     
-    NSData *data = HTTPBody ?: ((NSURLRequest *)self).HTTPBody;
+    NSMutableURLRequest *request = (NSMutableURLRequest *)self;
+    
+    [self YHV_setHTTPBody:HTTPBody];
+    
+    // Body reset (for example when URL loading system move it to stream) doesn't affect already captured body.
+    if (HTTPBody && [YHVNSURLRequest shouldCaptureHTTPBodyForRequest:request]) {
+        // Store reference on body which is held by request itself.
+        [NSURLProtocol setProperty:request.HTTPBody forKey:kYHVRequestPOSTBodyKey inRequest:request];
+    }
+}
+
+- (void)YHV_setHTTPBodyStream:(NSInputStream *)HTTPBodyStream {
+    
+    NSMutableURLRequest *request = (NSMutableURLRequest *)self;
     
-    if (data) {
-        [NSURLProtocol setProperty:data forKey:kYHVRequestPOSTBodyKey inRequest:(NSMutableURLRequest *)self];
+    if (HTTPBodyStream && ![HTTPBodyStream isKindOfClass:[YHVTeeInputStream class]] &&
+        [YHVNSURLRequest shouldCaptureHTTPBodyForRequest:request]) {
+        
+        YHVTeeInputStream *teeStream = [YHVTeeInputStream streamWithInputStream:HTTPBodyStream completion:nil];
+        HTTPBodyStream = teeStream;
+        
+        // Stream shared with request copies, so captured body will be available for recorded request as well.
+        [request YHV_updateTagWithBlock:^BOOL (YHVRequestTag *tag) {
+            tag.HTTPBodyStream = teeStream;
+            
+            return YES;
+        }];
     }
     
-    [self YHV_setHTTPBody:HTTPBody];
+    [self YHV_setHTTPBodyStream:HTTPBodyStream];
 }
 
 #pragma mark -
@@ -4,6 +4,7 @@
  */
 #import "NSURLRequest+YHVSerialization.h"
 #import "NSURLRequest+YHVPlayer.h"
+#import "NSData+YHVSerialization.h"
 #import "YHVSerializationHelper.h"
 
 
@@ -80,7 +81,7 @@ static NSString * const kYHVRequestNetworkTypeKey = @"network";
     dictionary[kYHVRequestURLKey] = self.URL.absoluteString;
     dictionary[kYHVRequestHTTPMethodKey] = self.HTTPMethod.lowercaseString;
     dictionary[kYHVRequestHeadersKey] = self.allHTTPHeaderFields;
-    dictionary[kYHVRequestHTTPBodyKey] = [YHVSerializationHelper dictionaryFromObject:(id)self.YHV_HTTPBody];
+    dictionary[kYHVRequestHTTPBodyKey] = [self.YHV_HTTPBody YHV_dictionaryRepresentationWithContentType:[self valueForHTTPHeaderField:@"Content-Type"]];
     dictionary[kYHVRequestCachePolicyKey] = @(self.cachePolicy);
     dictionary[kYHVRequestTimeoutKey] = @(self.timeoutInterval);
     dictionary[kYHVRequestCookiesHandlingKey] = @(self.HTTPShouldHandleCookies);
@@ -17,6 +17,21 @@
  */
 + (void)injectProtocol;
 
+
+#pragma mark - Context
+
+/**
+ * @brief      Bind session configuration to cassette's context.
+ * @discussion VCR's protocol in configuration replaced with subclass which stamp \c context on every request, so requests from
+ *             sessions created with this configuration will be handled by cassette inserted for \c context.
+ *
+ * @param context       Reference on context which should be used by session's requests.
+ * @param configuration Reference on configuration which should be bound to \c context.
+ *
+ * @since 1.6.0
+ */
++ (void)setContext:(NSString *)context forConfiguration:(NSURLSessionConfiguration *)configuration;
+
 #pragma mark -
 
 
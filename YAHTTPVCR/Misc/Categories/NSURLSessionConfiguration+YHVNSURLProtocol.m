@@ -5,6 +5,7 @@
 #import "NSURLSessionConfiguration+YHVNSURLProtocol.h"
 #import "YHVMethodsSwizzler.h"
 #import "YHVNSURLProtocol.h"
+#import <objc/runtime.h>
 
 
 #pragma mark Proteced interface declaration
@@ -30,6 +31,18 @@
  */
 + (void)addProtocolToConfiguration:(NSURLSessionConfiguration *)configuration;
 
+/**
+ * @brief      Retrieve VCR's protocol subclass which stamp \c context on handled requests.
+ * @discussion Subclass created once for each \c context.
+ *
+ * @param context Reference on context which should be used by protocol.
+ *
+ * @return Protocol subclass bound to \c context.
+ *
+ * @since 1.6.0
+ */
++ (Class)protocolClassForContext:(NSString *)context;
+
 #pragma mark -
 
 
@@ -54,6 +67,23 @@
 }
 
 
+#pragma mark - Context
+
++ (void)setContext:(NSString *)context forConfiguration:(NSURLSessionConfiguration *)configuration {
+    
+    NSMutableArray *protocols = [NSMutableArray new];
+    
+    for (Class protocolClass in configuration.protocolClasses) {
+        if (![protocolClass isSubclassOfClass:[YHVNSURLProtocol class]]) {
+            [protocols addObject:protocolClass];
+        }
+    }
+    
+    [protocols insertObject:[self protocolClassForContext:context] atIndex:0];
+    configuration.protocolClasses = protocols;
+}
+
+
 #pragma mark - Swizzle methods
 
 + (id)YHV_backgroundSessionConfiguration:(id)arg1 {
@@ -107,6 +137,35 @@
     configuration.protocolClasses = protocols;
 }
 
++ (Class)protocolClassForContext:(NSString *)context {
+    
+    static NSMutableDictionary<NSString *, Class> *_protocolClasses;
+    static dispatch_queue_t _protocolClassesAccessQueue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _protocolClassesAccessQueue = dispatch_queue_create("com.yetanotherhttpvcr.protocol-classes", DISPATCH_QUEUE_SERIAL);
+        _protocolClasses = [NSMutableDictionary new];
+    });
+    
+    __block Class protocolClass = nil;
+    
+    dispatch_sync(_protocolClassesAccessQueue, ^{
+        protocolClass = _protocolClasses[context];
+        
+        if (!protocolClass) {
+            NSString *className = [NSString stringWithFormat:@"%@_%@", NSStringFromClass([YHVNSURLProtocol class]),
+                                   @(_protocolClasses.count)];
+            protocolClass = objc_allocateClassPair([YHVNSURLProtocol class], className.UTF8String, 0);
+            objc_registerClassPair(protocolClass);
+            
+            [protocolClass setContext:context];
+            _protocolClasses[context] = protocolClass;
+        }
+    });
+    
+    return protocolClass;
+}
+
 
 #pragma mark -
 
@@ -133,6 +133,10 @@
         task.originalRequest.YHV_usingNSURLSession = request.YHV_usingNSURLSession;
     }
     
+    if (request.YHV_context && !task.originalRequest.YHV_context) {
+        task.originalRequest.YHV_context = request.YHV_context;
+    }
+    
     if (request.YHV_identifier && !task.originalRequest.YHV_identifier) {
         task.originalRequest.YHV_identifier = request.YHV_identifier;
     }
@@ -0,0 +1,56 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      Base64 encoding / decoding helper.
+ * @discussion Helper use vector instructions (SSSE3 on x86_64 and NEON on arm64) for bulk of data and scalar implementation for tail
+ *             and on other architectures. Output is identical to \a NSData Base64 implementation used with default options.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVBase64 : NSObject
+
+
+#pragma mark Encoding
+
+/**
+ * @brief  Encode passed binary data into Base64 string.
+ *
+ * @param data Reference on data which should be encoded.
+ *
+ * @return Base64 encoded string (w/o line breaks).
+ */
++ (NSString *)stringByEncodingData:(NSData *)data;
+
+/**
+ * @brief  Encode passed binary data into Base64 encoded ASCII characters.
+ *
+ * @param data Reference on data which should be encoded.
+ *
+ * @return Base64 encoded data (w/o line breaks).
+ */
++ (NSData *)dataByEncodingData:(NSData *)data;
+
+
+#pragma mark - Decoding
+
+/**
+ * @brief      Decode passed Base64 string into binary data.
+ * @discussion Strings which can't be handled by fast path (contain characters outside of Base64 alphabet or not padded) passed to
+ *             \a NSData Base64 implementation.
+ *
+ * @param string Reference on Base64 encoded string.
+ *
+ * @return Decoded data or \c nil in case if \c string is not valid Base64 string.
+ */
++ (nullable NSData *)dataByDecodingString:(NSString *)string;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
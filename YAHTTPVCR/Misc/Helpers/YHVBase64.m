@@ -0,0 +1,439 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVBase64.h"
+#if defined(__SSSE3__)
+#import <tmmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#import <arm_neon.h>
+#endif
+
+
+#pragma mark Constants
+
+/**
+ * @brief  Stores Base64 alphabet.
+ */
+static const uint8_t kYHVBase64EncodeTable[64] = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+};
+
+/**
+ * @brief  Stores value which is used in decode table for characters outside of Base64 alphabet.
+ */
+static const uint8_t kYHVBase64InvalidCharacter = 0xFF;
+
+
+#pragma mark - Scalar implementation
+
+/**
+ * @brief  Build table which map Base64 alphabet characters to their 6-bit values.
+ *
+ * @return Pointer on 256 entries table.
+ */
+static const uint8_t *YHVBase64DecodeTable(void) {
+
+    static uint8_t decodeTable[256];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        memset(decodeTable, kYHVBase64InvalidCharacter, sizeof(decodeTable));
+
+        for (uint8_t idx = 0; idx < 64; idx++) {
+            decodeTable[kYHVBase64EncodeTable[idx]] = idx;
+        }
+    });
+
+    return decodeTable;
+}
+
+/**
+ * @brief  Encode bytes using scalar implementation.
+ *
+ * @param src    Pointer on bytes which should be encoded.
+ * @param length Number of bytes which should be encoded.
+ * @param dst    Pointer on buffer into which encoded characters should be written (should fit whole encoded string).
+ */
+static void YHVBase64EncodeScalar(const uint8_t *src, size_t length, uint8_t *dst) {
+
+    for (; length >= 3; length -= 3, src += 3, dst += 4) {
+        dst[0] = kYHVBase64EncodeTable[src[0] >> 2];
+        dst[1] = kYHVBase64EncodeTable[((src[0] & 0x03) << 4) | (src[1] >> 4)];
+        dst[2] = kYHVBase64EncodeTable[((src[1] & 0x0F) << 2) | (src[2] >> 6)];
+        dst[3] = kYHVBase64EncodeTable[src[2] & 0x3F];
+    }
+
+    if (length == 0) {
+        return;
+    }
+
+    dst[0] = kYHVBase64EncodeTable[src[0] >> 2];
+
+    if (length == 1) {
+        dst[1] = kYHVBase64EncodeTable[(src[0] & 0x03) << 4];
+        dst[2] = '=';
+    } else {
+        dst[1] = kYHVBase64EncodeTable[((src[0] & 0x03) << 4) | (src[1] >> 4)];
+        dst[2] = kYHVBase64EncodeTable[(src[1] & 0x0F) << 2];
+    }
+
+    dst[3] = '=';
+}
+
+/**
+ * @brief  Decode complete (w/o padding) quantums using scalar implementation.
+ *
+ * @param src    Pointer on characters which should be decoded.
+ * @param length Number of characters which should be decoded (multiple of 4).
+ * @param dst    Pointer on buffer into which decoded bytes should be written.
+ *
+ * @return Whether all characters belong to Base64 alphabet or not.
+ */
+static BOOL YHVBase64DecodeScalar(const uint8_t *src, size_t length, uint8_t *dst) {
+
+    const uint8_t *decodeTable = YHVBase64DecodeTable();
+
+    for (; length >= 4; length -= 4, src += 4, dst += 3) {
+        uint8_t a = decodeTable[src[0]], b = decodeTable[src[1]], c = decodeTable[src[2]], d = decodeTable[src[3]];
+
+        // Characters outside of alphabet has high bits set in decode table.
+        if ((a | b | c | d) & 0xC0) {
+            return NO;
+        }
+
+        dst[0] = (uint8_t)((a << 2) | (b >> 4));
+        dst[1] = (uint8_t)((b << 4) | (c >> 2));
+        dst[2] = (uint8_t)((c << 6) | d);
+    }
+
+    return YES;
+}
+
+
+#pragma mark - Vectorized implementation
+
+#if defined(__SSSE3__)
+
+/**
+ * @brief  Encode as much as possible bytes with SSSE3 instructions (12 bytes per iteration).
+ *
+ * @return Number of bytes which has been encoded.
+ */
+static size_t YHVBase64EncodeVector(const uint8_t *src, size_t length, uint8_t *dst) {
+
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i offsets = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    size_t processed = 0;
+
+    // Each iteration load 16 bytes, but use only 12 of them.
+    while (length - processed >= 16) {
+        __m128i input = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(src + processed)), shuffle);
+
+        // Split each 3 bytes into four 6-bit indices.
+        __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        __m128i t1 = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(t0, t1);
+
+        // Translate indices into alphabet characters by adding range offset.
+        __m128i ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        ranges = _mm_sub_epi8(ranges, _mm_cmpgt_epi8(indices, _mm_set1_epi8(25)));
+        _mm_storeu_si128((__m128i *)dst, _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, ranges)));
+
+        processed += 12;
+        dst += 16;
+    }
+
+    return processed;
+}
+
+/**
+ * @brief  Decode as much as possible characters with SSSE3 instructions (16 characters per iteration).
+ *
+ * @return Number of characters which has been decoded. Processing stops at first non-alphabet character.
+ */
+static size_t YHVBase64DecodeVector(const uint8_t *src, size_t length, uint8_t *dst) {
+
+    const __m128i lowerNibbleLookup = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B,
+                                                    0x1B, 0x1A);
+    const __m128i upperNibbleLookup = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                                    0x10, 0x10);
+    const __m128i offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m128i slash = _mm_set1_epi8(0x2F);
+    size_t processed = 0;
+
+    // Each iteration store 16 bytes, but only 12 of them is decoded data, so iteration should leave space for extra bytes.
+    while (length - processed >= 24) {
+        __m128i input = _mm_loadu_si128((const __m128i *)(src + processed));
+        __m128i upperNibbles = _mm_and_si128(_mm_srli_epi32(input, 4), slash);
+        __m128i lowerNibbles = _mm_and_si128(input, slash);
+        __m128i upper = _mm_shuffle_epi8(upperNibbleLookup, upperNibbles);
+        __m128i lower = _mm_shuffle_epi8(lowerNibbleLookup, lowerNibbles);
+
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lower, upper), _mm_setzero_si128())) != 0) {
+            break;
+        }
+
+        __m128i range = _mm_add_epi8(_mm_cmpeq_epi8(input, slash), upperNibbles);
+        __m128i values = _mm_add_epi8(input, _mm_shuffle_epi8(offsets, range));
+
+        // Merge four 6-bit values into three bytes.
+        __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128((__m128i *)dst, _mm_shuffle_epi8(merged, pack));
+
+        processed += 16;
+        dst += 12;
+    }
+
+    return processed;
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+/**
+ * @brief  Encode as much as possible bytes with NEON instructions (48 bytes per iteration).
+ *
+ * @return Number of bytes which has been encoded.
+ */
+static size_t YHVBase64EncodeVector(const uint8_t *src, size_t length, uint8_t *dst) {
+
+    const uint8x16x4_t alphabet = vld1q_u8_x4(kYHVBase64EncodeTable);
+    const uint8x16_t mask = vdupq_n_u8(0x3F);
+    size_t processed = 0;
+
+    while (length - processed >= 48) {
+        uint8x16x3_t input = vld3q_u8(src + processed);
+        uint8x16x4_t output;
+
+        output.val[0] = vshrq_n_u8(input.val[0], 2);
+        output.val[1] = vandq_u8(vorrq_u8(vshrq_n_u8(input.val[1], 4), vshlq_n_u8(input.val[0], 4)), mask);
+        output.val[2] = vandq_u8(vorrq_u8(vshrq_n_u8(input.val[2], 6), vshlq_n_u8(input.val[1], 2)), mask);
+        output.val[3] = vandq_u8(input.val[2], mask);
+
+        output.val[0] = vqtbl4q_u8(alphabet, output.val[0]);
+        output.val[1] = vqtbl4q_u8(alphabet, output.val[1]);
+        output.val[2] = vqtbl4q_u8(alphabet, output.val[2]);
+        output.val[3] = vqtbl4q_u8(alphabet, output.val[3]);
+        vst4q_u8(dst, output);
+
+        processed += 48;
+        dst += 64;
+    }
+
+    return processed;
+}
+
+/**
+ * @brief  Translate 16 characters into their 6-bit values.
+ * @discussion Characters outside of alphabet translated into value with high bits set.
+ */
+static inline uint8x16_t YHVBase64DecodeVectorCharacters(uint8x16_t characters, uint8x16x4_t lowerTable, uint8x16x4_t upperTable) {
+
+    // Indices outside of 64 entries table produce 0 with vqtbl4q_u8 and keep previous value with vqtbx4q_u8.
+    uint8x16_t values = vqtbl4q_u8(lowerTable, characters);
+    values = vqtbx4q_u8(values, upperTable, vsubq_u8(characters, vdupq_n_u8(64)));
+
+    return vorrq_u8(values, vcgeq_u8(characters, vdupq_n_u8(128)));
+}
+
+/**
+ * @brief  Decode as much as possible characters with NEON instructions (64 characters per iteration).
+ *
+ * @return Number of characters which has been decoded. Processing stops at first non-alphabet character.
+ */
+static size_t YHVBase64DecodeVector(const uint8_t *src, size_t length, uint8_t *dst) {
+
+    const uint8_t *decodeTable = YHVBase64DecodeTable();
+    const uint8x16x4_t lowerTable = vld1q_u8_x4(decodeTable);
+    const uint8x16x4_t upperTable = vld1q_u8_x4(decodeTable + 64);
+    size_t processed = 0;
+
+    while (length - processed >= 64) {
+        uint8x16x4_t input = vld4q_u8(src + processed);
+        uint8x16_t a = YHVBase64DecodeVectorCharacters(input.val[0], lowerTable, upperTable);
+        uint8x16_t b = YHVBase64DecodeVectorCharacters(input.val[1], lowerTable, upperTable);
+        uint8x16_t c = YHVBase64DecodeVectorCharacters(input.val[2], lowerTable, upperTable);
+        uint8x16_t d = YHVBase64DecodeVectorCharacters(input.val[3], lowerTable, upperTable);
+
+        if (vmaxvq_u8(vorrq_u8(vorrq_u8(a, b), vorrq_u8(c, d))) >= 64) {
+            break;
+        }
+
+        uint8x16x3_t output;
+        output.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+        output.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+        output.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+        vst3q_u8(dst, output);
+
+        processed += 64;
+        dst += 48;
+    }
+
+    return processed;
+}
+
+#else
+
+static size_t YHVBase64EncodeVector(const uint8_t *__unused src, size_t __unused length, uint8_t *__unused dst) {
+
+    return 0;
+}
+
+static size_t YHVBase64DecodeVector(const uint8_t *__unused src, size_t __unused length, uint8_t *__unused dst) {
+
+    return 0;
+}
+
+#endif
+
+
+#pragma mark - Codec
+
+/**
+ * @brief  Encode bytes into Base64 characters.
+ *
+ * @param src    Pointer on bytes which should be encoded.
+ * @param length Number of bytes which should be encoded.
+ * @param dst    Pointer on buffer into which encoded characters should be written (should fit whole encoded string).
+ */
+static void YHVBase64Encode(const uint8_t *src, size_t length, uint8_t *dst) {
+
+    size_t processed = YHVBase64EncodeVector(src, length, dst);
+
+    YHVBase64EncodeScalar(src + processed, length - processed, dst + (processed / 3) * 4);
+}
+
+/**
+ * @brief  Decode padded Base64 characters.
+ *
+ * @param src       Pointer on characters which should be decoded.
+ * @param length    Number of characters which should be decoded.
+ * @param dst       Pointer on buffer into which decoded bytes should be written (at least \c length / 4 * 3 bytes).
+ * @param dstLength Pointer which will be used to store number of decoded bytes.
+ *
+ * @return Whether passed characters is padded Base64 string or not.
+ */
+static BOOL YHVBase64Decode(const uint8_t *src, size_t length, uint8_t *dst, size_t *dstLength) {
+
+    const uint8_t *decodeTable = YHVBase64DecodeTable();
+    size_t padding = 0;
+
+    if (length % 4 != 0) {
+        return NO;
+    }
+
+    if (length && src[length - 1] == '=') {
+        padding = src[length - 2] == '=' ? 2 : 1;
+    }
+
+    size_t fullLength = padding ? length - 4 : length;
+    size_t processed = YHVBase64DecodeVector(src, fullLength, dst);
+
+    if (!YHVBase64DecodeScalar(src + processed, fullLength - processed, dst + (processed / 4) * 3)) {
+        return NO;
+    }
+
+    dst += (fullLength / 4) * 3;
+    *dstLength = (fullLength / 4) * 3;
+
+    if (padding) {
+        const uint8_t *quantum = src + fullLength;
+        uint8_t a = decodeTable[quantum[0]], b = decodeTable[quantum[1]];
+        uint8_t c = padding == 1 ? decodeTable[quantum[2]] : 0;
+
+        if (a == kYHVBase64InvalidCharacter || b == kYHVBase64InvalidCharacter || c == kYHVBase64InvalidCharacter) {
+            return NO;
+        }
+
+        dst[0] = (uint8_t)((a << 2) | (b >> 4));
+
+        if (padding == 1) {
+            dst[1] = (uint8_t)((b << 4) | (c >> 2));
+        }
+
+        *dstLength += 3 - padding;
+    }
+
+    return YES;
+}
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVBase64
+
+
+#pragma mark - Encoding
+
++ (NSString *)stringByEncodingData:(NSData *)data {
+
+    size_t encodedLength = ((data.length + 2) / 3) * 4;
+
+    if (encodedLength == 0) {
+        return @"";
+    }
+
+    uint8_t *buffer = malloc(encodedLength);
+
+    if (!buffer) {
+        return [data base64EncodedStringWithOptions:(NSDataBase64EncodingOptions)0];
+    }
+
+    YHVBase64Encode(data.bytes, data.length, buffer);
+
+    return [[NSString alloc] initWithBytesNoCopy:buffer length:encodedLength encoding:NSASCIIStringEncoding freeWhenDone:YES];
+}
+
++ (NSData *)dataByEncodingData:(NSData *)data {
+
+    size_t encodedLength = ((data.length + 2) / 3) * 4;
+
+    if (encodedLength == 0) {
+        return [NSData new];
+    }
+
+    uint8_t *buffer = malloc(encodedLength);
+
+    if (!buffer) {
+        return [data base64EncodedDataWithOptions:(NSDataBase64EncodingOptions)0];
+    }
+
+    YHVBase64Encode(data.bytes, data.length, buffer);
+
+    return [NSData dataWithBytesNoCopy:buffer length:encodedLength freeWhenDone:YES];
+}
+
+
+#pragma mark - Decoding
+
++ (NSData *)dataByDecodingString:(NSString *)string {
+
+    const char *characters = CFStringGetCStringPtr((__bridge CFStringRef)string, kCFStringEncodingASCII);
+    NSData *stringData = nil;
+    size_t length = string.length;
+
+    if (!characters) {
+        stringData = [string dataUsingEncoding:NSASCIIStringEncoding];
+        characters = stringData.bytes;
+        length = stringData.length;
+    }
+
+    size_t decodedLength = 0;
+    uint8_t *buffer = characters ? malloc(MAX((length / 4) * 3, 1)) : NULL;
+
+    if (buffer && YHVBase64Decode((const uint8_t *)characters, length, buffer, &decodedLength)) {
+        return [NSData dataWithBytesNoCopy:buffer length:decodedLength freeWhenDone:YES];
+    }
+
+    free(buffer);
+
+    return [[NSData alloc] initWithBase64EncodedString:string options:(NSDataBase64DecodingOptions)0];
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,47 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      Compiled list of allowed hosts.
+ * @discussion Rule set created once during cassette insertion from \c hostsFilter list, so check for each request doesn't depend from
+ *             number of allowed hosts.
+ *             Host names compared case-insensitively. Entry which starts with \c *. (like \c *.example.com) allow any sub-domain of
+ *             specified domain (but not domain itself).
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVHostsRuleSet : NSObject
+
+
+#pragma mark Initialization and Configuration
+
+/**
+ * @brief  Create and configure hosts rule set.
+ *
+ * @param hosts Reference on list of allowed host names and wildcard domains.
+ *
+ * @return Configured and ready to use rule set.
+ */
++ (instancetype)ruleSetWithHosts:(NSArray<NSString *> *)hosts;
+
+
+#pragma mark - Matching
+
+/**
+ * @brief  Check whether host is allowed by rule set.
+ *
+ * @param host Reference on host name which should be checked.
+ *
+ * @return Whether host is in the list of allowed hosts or is sub-domain of allowed wildcard domain.
+ */
+- (BOOL)containsHost:(nullable NSString *)host;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,125 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVHostsRuleSet.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Protected interface declaration
+
+@interface YHVHostsRuleSet ()
+
+
+#pragma mark - Information
+
+/**
+ * @brief  Stores reference on set of lowercased host names which should be matched exactly.
+ */
+@property (nonatomic, strong) NSSet<NSString *> *hosts;
+
+/**
+ * @brief  Stores reference on set of lowercased domain suffixes (with leading dot) for wildcard entries.
+ */
+@property (nonatomic, strong) NSSet<NSString *> *domainSuffixes;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize hosts rule set.
+ *
+ * @param hosts Reference on list of allowed host names and wildcard domains.
+ *
+ * @return Initialized and ready to use rule set.
+ */
+- (instancetype)initWithHosts:(NSArray<NSString *> *)hosts;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVHostsRuleSet
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)ruleSetWithHosts:(NSArray<NSString *> *)hosts {
+
+    return [[self alloc] initWithHosts:hosts];
+}
+
+- (instancetype)initWithHosts:(NSArray<NSString *> *)hosts {
+
+    if ((self = [super init])) {
+        NSMutableSet<NSString *> *domainSuffixes = [NSMutableSet new];
+        NSMutableSet<NSString *> *exactHosts = [NSMutableSet new];
+
+        for (NSString *host in hosts) {
+            if (![host isKindOfClass:[NSString class]]) {
+                continue;
+            }
+
+            NSString *rule = host.lowercaseString;
+
+            if ([rule hasPrefix:@"*."] && rule.length > 2) {
+                [domainSuffixes addObject:[rule substringFromIndex:1]];
+            } else {
+                [exactHosts addObject:rule];
+            }
+        }
+
+        _domainSuffixes = [domainSuffixes copy];
+        _hosts = [exactHosts copy];
+    }
+
+    return self;
+}
+
+
+#pragma mark - Matching
+
+- (BOOL)containsHost:(NSString *)host {
+
+    if (!host.length) {
+        return NO;
+    }
+
+    NSString *lowercaseHost = host.lowercaseString;
+
+    if ([self.hosts containsObject:lowercaseHost]) {
+        return YES;
+    }
+
+    if (!self.domainSuffixes.count) {
+        return NO;
+    }
+
+    // Walk through host's parent domains (label by label), so number of lookups depends only from host itself.
+    NSRange searchRange = NSMakeRange(0, lowercaseHost.length);
+    NSRange dotRange = [lowercaseHost rangeOfString:@"." options:NSLiteralSearch range:searchRange];
+
+    while (dotRange.location != NSNotFound) {
+        if ([self.domainSuffixes containsObject:[lowercaseHost substringFromIndex:dotRange.location]]) {
+            return YES;
+        }
+
+        searchRange.location = dotRange.location + 1;
+        searchRange.length = lowercaseHost.length - searchRange.location;
+        dotRange = [lowercaseHost rangeOfString:@"." options:NSLiteralSearch range:searchRange];
+    }
+
+    return NO;
+}
+
+#pragma mark -
+
+
+@end
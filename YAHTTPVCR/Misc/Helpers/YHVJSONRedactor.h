@@ -0,0 +1,57 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      JSON body redactor.
+ * @discussion Redactor walk through JSON document bytes once and replace or remove values for keys which has rules. Bytes which
+ *             doesn't belong to modified members copied as-is, so formatting and keys order of rest of document doesn't change.
+ *             Rule key without dots match key with same name in object on any depth. Rule key with dots (like \c user.token) is path
+ *             to key from root object (arrays doesn't add components to path). Keys compared case-insensitively. \a NSNull used as
+ *             replacement value cause member removal.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVJSONRedactor : NSObject
+
+
+#pragma mark Initialization and Configuration
+
+/**
+ * @brief  Create and configure JSON redactor.
+ *
+ * @param replacements Reference on dictionary which maps key names or key paths to values which should be used instead of original.
+ *
+ * @return Configured and ready to use redactor.
+ */
++ (instancetype)redactorWithReplacements:(NSDictionary *)replacements;
+
+
+#pragma mark - Redaction
+
+/**
+ * @brief  Check whether data with specified content type can be processed by redactor.
+ *
+ * @param contentType Reference on type which has been used to encode data for transfer over the network.
+ *
+ * @return \c YES in case if \c application/json content type passed.
+ */
++ (BOOL)canRedactDataWithContentType:(nullable NSString *)contentType;
+
+/**
+ * @brief  Replace or remove values in JSON document for keys which has rules.
+ *
+ * @param data Reference on JSON document data.
+ *
+ * @return Redacted document data or \c nil in case if \c data is not valid JSON document.
+ */
+- (nullable NSData *)redactedDataFromData:(nullable NSData *)data;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,554 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVJSONRedactor.h"
+
+
+#pragma mark Defines
+
+/**
+ * @brief  Maximum nesting level of JSON document which can be processed by redactor.
+ */
+#define YHVJSONRedactorMaximumDepth 512
+
+
+#pragma mark - Structures
+
+/**
+ * @brief  Structure which describe state of JSON document processing.
+ */
+typedef struct YHVJSONRedactionContext {
+
+    /**
+     * @brief  Pointer on JSON document bytes.
+     */
+    const uint8_t *bytes;
+
+    /**
+     * @brief  Length of JSON document.
+     */
+    NSUInteger length;
+
+    /**
+     * @brief  Index of byte which should be processed next.
+     */
+    NSUInteger position;
+
+    /**
+     * @brief  Index of first byte which hasn't been copied or dropped yet.
+     */
+    NSUInteger flushedPosition;
+
+    /**
+     * @brief  Reference on data object into which redacted document is written.
+     */
+    __unsafe_unretained NSMutableData *output;
+
+    /**
+     * @brief  Whether any member has been modified or not.
+     */
+    BOOL modified;
+} YHVJSONRedactionContext;
+
+
+#pragma mark - Functions
+
+/**
+ * @brief  Move context's position to first non-whitespace byte.
+ *
+ * @param context Pointer on document processing state.
+ */
+static void YHVJSONSkipWhitespace(YHVJSONRedactionContext *context) {
+
+    while (context->position < context->length) {
+        uint8_t byte = context->bytes[context->position];
+
+        if (byte != ' ' && byte != '\t' && byte != '\n' && byte != '\r') {
+            break;
+        }
+
+        context->position++;
+    }
+}
+
+/**
+ * @brief  Move context's position after string which starts at current position.
+ *
+ * @param context Pointer on document processing state.
+ *
+ * @return Whether string has been closed before document end or not.
+ */
+static BOOL YHVJSONScanString(YHVJSONRedactionContext *context) {
+
+    context->position++;
+
+    while (context->position < context->length) {
+        uint8_t byte = context->bytes[context->position];
+
+        if (byte == '\\') {
+            context->position += 2;
+        } else {
+            context->position++;
+
+            if (byte == '"') {
+                return YES;
+            }
+        }
+    }
+
+    return NO;
+}
+
+/**
+ * @brief  Move context's position after number or literal which starts at current position.
+ *
+ * @param context Pointer on document processing state.
+ *
+ * @return Whether scalar value has been found at current position or not.
+ */
+static BOOL YHVJSONScanScalar(YHVJSONRedactionContext *context) {
+
+    NSUInteger start = context->position;
+
+    while (context->position < context->length) {
+        uint8_t byte = context->bytes[context->position];
+
+        if (byte == ',' || byte == ']' || byte == '}' || byte == ' ' || byte == '\t' || byte == '\n' || byte == '\r') {
+            break;
+        }
+
+        context->position++;
+    }
+
+    return context->position > start;
+}
+
+/**
+ * @brief  Copy not processed document bytes into output.
+ *
+ * @param context  Pointer on document processing state.
+ * @param position Index of byte till which (not including) data should be copied.
+ */
+static void YHVJSONFlush(YHVJSONRedactionContext *context, NSUInteger position) {
+
+    if (position > context->flushedPosition) {
+        [context->output appendBytes:(context->bytes + context->flushedPosition) length:(position - context->flushedPosition)];
+        context->flushedPosition = position;
+    }
+}
+
+/**
+ * @brief  Exclude part of document from output.
+ *
+ * @param context Pointer on document processing state.
+ * @param start   Index of first byte which should be dropped.
+ * @param end     Index of byte after last byte which should be dropped.
+ */
+static void YHVJSONDrop(YHVJSONRedactionContext *context, NSUInteger start, NSUInteger end) {
+
+    YHVJSONFlush(context, start);
+    context->flushedPosition = end;
+    context->modified = YES;
+}
+
+/**
+ * @brief  Decode JSON string.
+ *
+ * @param bytes Pointer on JSON document bytes.
+ * @param start Index of opening quote.
+ * @param end   Index of byte after closing quote.
+ *
+ * @return Decoded string or \c nil in case of malformed string.
+ */
+static NSString * YHVJSONStringFromBytes(const uint8_t *bytes, NSUInteger start, NSUInteger end) {
+
+    if (!memchr(bytes + start + 1, '\\', end - start - 2)) {
+        return [[NSString alloc] initWithBytes:(bytes + start + 1) length:(end - start - 2) encoding:NSUTF8StringEncoding];
+    }
+
+    NSMutableData *data = [NSMutableData dataWithBytes:"[" length:1];
+    [data appendBytes:(bytes + start) length:(end - start)];
+    [data appendBytes:"]" length:1];
+    NSArray *strings = [NSJSONSerialization JSONObjectWithData:data options:(NSJSONReadingOptions)0 error:nil];
+
+    return [strings.firstObject isKindOfClass:[NSString class]] ? strings.firstObject : nil;
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Protected interface declaration
+
+@interface YHVJSONRedactor ()
+
+
+#pragma mark - Information
+
+/**
+ * @brief  Stores reference on dictionary which maps lowercased key names to encoded replacement values (or \a NSNull).
+ */
+@property (nonatomic, strong) NSDictionary<NSString *, id> *keyReplacements;
+
+/**
+ * @brief  Stores reference on dictionary which maps lowercased key paths to encoded replacement values (or \a NSNull).
+ */
+@property (nonatomic, strong) NSDictionary<NSString *, id> *pathReplacements;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize JSON redactor.
+ *
+ * @param replacements Reference on dictionary which maps key names or key paths to values which should be used instead of original.
+ *
+ * @return Initialized and ready to use redactor.
+ */
+- (instancetype)initWithReplacements:(NSDictionary *)replacements;
+
+
+#pragma mark - Redaction
+
+/**
+ * @brief  Process JSON value which starts at current context's position.
+ *
+ * @param context  Pointer on document processing state.
+ * @param path     Lowercased path to value's parent object (if path rules used).
+ * @param matching Whether rules should be applied to value's members or not.
+ * @param depth    Value's nesting level.
+ *
+ * @return Whether value has been processed or not.
+ */
+- (BOOL)scanValueWithContext:(YHVJSONRedactionContext *)context
+                      atPath:(nullable NSString *)path
+                    matching:(BOOL)matching
+                       depth:(NSUInteger)depth;
+
+/**
+ * @brief  Process JSON object which starts at current context's position.
+ *
+ * @param context  Pointer on document processing state.
+ * @param path     Lowercased path to object (if path rules used).
+ * @param matching Whether rules should be applied to object's members or not.
+ * @param depth    Object's nesting level.
+ *
+ * @return Whether object has been processed or not.
+ */
+- (BOOL)scanObjectWithContext:(YHVJSONRedactionContext *)context
+                       atPath:(nullable NSString *)path
+                     matching:(BOOL)matching
+                        depth:(NSUInteger)depth;
+
+/**
+ * @brief  Process JSON array which starts at current context's position.
+ *
+ * @param context  Pointer on document processing state.
+ * @param path     Lowercased path to array (if path rules used).
+ * @param matching Whether rules should be applied to array's elements or not.
+ * @param depth    Array's nesting level.
+ *
+ * @return Whether array has been processed or not.
+ */
+- (BOOL)scanArrayWithContext:(YHVJSONRedactionContext *)context
+                      atPath:(nullable NSString *)path
+                    matching:(BOOL)matching
+                       depth:(NSUInteger)depth;
+
+
+#pragma mark - Misc
+
+/**
+ * @brief  Encode replacement value to JSON.
+ *
+ * @param value Reference on value which should be encoded.
+ *
+ * @return Encoded value or \c nil in case if value can't be represented in JSON.
+ */
+- (nullable NSData *)encodedReplacement:(id)value;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVJSONRedactor
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)redactorWithReplacements:(NSDictionary *)replacements {
+
+    return [[self alloc] initWithReplacements:replacements];
+}
+
+- (instancetype)initWithReplacements:(NSDictionary *)replacements {
+
+    if ((self = [super init])) {
+        NSMutableDictionary<NSString *, id> *pathReplacements = [NSMutableDictionary new];
+        NSMutableDictionary<NSString *, id> *keyReplacements = [NSMutableDictionary new];
+
+        for (NSString *key in replacements) {
+            if (![key isKindOfClass:[NSString class]]) {
+                continue;
+            }
+
+            id replacement = replacements[key];
+            replacement = [replacement isKindOfClass:[NSNull class]] ? replacement : [self encodedReplacement:replacement];
+
+            if (!replacement) {
+                continue;
+            }
+
+            NSString *ruleKey = key.lowercaseString;
+
+            if ([ruleKey rangeOfString:@"."].location != NSNotFound) {
+                pathReplacements[ruleKey] = replacement;
+            } else {
+                keyReplacements[ruleKey] = replacement;
+            }
+        }
+
+        _pathReplacements = [pathReplacements copy];
+        _keyReplacements = [keyReplacements copy];
+    }
+
+    return self;
+}
+
+
+#pragma mark - Redaction
+
++ (BOOL)canRedactDataWithContentType:(NSString *)contentType {
+
+    return contentType && [contentType.lowercaseString rangeOfString:@"application/json"].location != NSNotFound;
+}
+
+- (NSData *)redactedDataFromData:(NSData *)data {
+
+    if (!data.length) {
+        return nil;
+    }
+
+    if (!self.keyReplacements.count && !self.pathReplacements.count) {
+        return data;
+    }
+
+    NSMutableData *output = [NSMutableData dataWithCapacity:data.length];
+    YHVJSONRedactionContext context = { data.bytes, data.length, 0, 0, output, NO };
+
+    YHVJSONSkipWhitespace(&context);
+
+    if (![self scanValueWithContext:&context atPath:nil matching:YES depth:0]) {
+        return nil;
+    }
+
+    YHVJSONSkipWhitespace(&context);
+
+    if (context.position != context.length) {
+        return nil;
+    }
+
+    if (!context.modified) {
+        return data;
+    }
+
+    YHVJSONFlush(&context, context.length);
+
+    return output;
+}
+
+- (BOOL)scanValueWithContext:(YHVJSONRedactionContext *)context
+                      atPath:(NSString *)path
+                    matching:(BOOL)matching
+                       depth:(NSUInteger)depth {
+
+    if (depth > YHVJSONRedactorMaximumDepth || context->position >= context->length) {
+        return NO;
+    }
+
+    switch (context->bytes[context->position]) {
+        case '{':
+            return [self scanObjectWithContext:context atPath:path matching:matching depth:depth];
+        case '[':
+            return [self scanArrayWithContext:context atPath:path matching:matching depth:depth];
+        case '"':
+            return YHVJSONScanString(context);
+        default:
+            return YHVJSONScanScalar(context);
+    }
+}
+
+- (BOOL)scanObjectWithContext:(YHVJSONRedactionContext *)context
+                       atPath:(NSString *)path
+                     matching:(BOOL)matching
+                        depth:(NSUInteger)depth {
+
+    const uint8_t *bytes = context->bytes;
+    NSUInteger keptMembersCount = 0;
+
+    context->position++;
+    NSUInteger memberStart = context->position;
+    YHVJSONSkipWhitespace(context);
+
+    if (context->position < context->length && bytes[context->position] == '}') {
+        context->position++;
+
+        return YES;
+    }
+
+    while (context->position < context->length) {
+        YHVJSONSkipWhitespace(context);
+        NSUInteger keyStart = context->position;
+
+        if (keyStart >= context->length || bytes[keyStart] != '"' || !YHVJSONScanString(context)) {
+            return NO;
+        }
+
+        NSUInteger keyEnd = context->position;
+        YHVJSONSkipWhitespace(context);
+
+        if (context->position >= context->length || bytes[context->position] != ':') {
+            return NO;
+        }
+
+        context->position++;
+        YHVJSONSkipWhitespace(context);
+        NSUInteger valueStart = context->position;
+        NSString *memberPath = nil;
+        id replacement = nil;
+
+        if (matching) {
+            NSString *key = YHVJSONStringFromBytes(bytes, keyStart, keyEnd).lowercaseString;
+
+            if (!key) {
+                return NO;
+            }
+
+            if (self.pathReplacements.count) {
+                memberPath = path ? [@[path, key] componentsJoinedByString:@"."] : key;
+                replacement = self.pathReplacements[memberPath];
+            }
+
+            replacement = replacement ?: self.keyReplacements[key];
+        }
+
+        BOOL shouldRemoveMember = [replacement isKindOfClass:[NSNull class]];
+
+        // When all previous members has been removed, separator in front of first kept member should be removed as well.
+        if (!shouldRemoveMember && !keptMembersCount) {
+            const uint8_t *separator = memchr(bytes + memberStart, ',', keyStart - memberStart);
+
+            if (separator) {
+                NSUInteger separatorPosition = (NSUInteger)(separator - bytes);
+                YHVJSONDrop(context, separatorPosition, separatorPosition + 1);
+            }
+        }
+
+        if (![self scanValueWithContext:context atPath:memberPath matching:(matching && !replacement) depth:(depth + 1)]) {
+            return NO;
+        }
+
+        if (shouldRemoveMember) {
+            YHVJSONDrop(context, memberStart, context->position);
+        } else {
+            if (replacement) {
+                YHVJSONDrop(context, valueStart, context->position);
+                [context->output appendData:replacement];
+            }
+
+            keptMembersCount++;
+        }
+
+        memberStart = context->position;
+        YHVJSONSkipWhitespace(context);
+
+        if (context->position >= context->length) {
+            return NO;
+        }
+
+        uint8_t byte = bytes[context->position++];
+
+        if (byte == '}') {
+            return YES;
+        } else if (byte != ',') {
+            return NO;
+        }
+    }
+
+    return NO;
+}
+
+- (BOOL)scanArrayWithContext:(YHVJSONRedactionContext *)context
+                      atPath:(NSString *)path
+                    matching:(BOOL)matching
+                       depth:(NSUInteger)depth {
+
+    const uint8_t *bytes = context->bytes;
+
+    context->position++;
+    YHVJSONSkipWhitespace(context);
+
+    if (context->position < context->length && bytes[context->position] == ']') {
+        context->position++;
+
+        return YES;
+    }
+
+    while (context->position < context->length) {
+        YHVJSONSkipWhitespace(context);
+
+        if (![self scanValueWithContext:context atPath:path matching:matching depth:(depth + 1)]) {
+            return NO;
+        }
+
+        YHVJSONSkipWhitespace(context);
+
+        if (context->position >= context->length) {
+            return NO;
+        }
+
+        uint8_t byte = bytes[context->position++];
+
+        if (byte == ']') {
+            return YES;
+        } else if (byte != ',') {
+            return NO;
+        }
+    }
+
+    return NO;
+}
+
+
+#pragma mark - Misc
+
+- (NSData *)encodedReplacement:(id)value {
+
+    if ([value isKindOfClass:[NSDictionary class]] || [value isKindOfClass:[NSArray class]]) {
+        if (![NSJSONSerialization isValidJSONObject:value]) {
+            return nil;
+        }
+
+        return [NSJSONSerialization dataWithJSONObject:value options:(NSJSONWritingOptions)0 error:nil];
+    }
+
+    // Wrap scalar value into array, because fragments can't be serialized on all supported platforms.
+    if (![NSJSONSerialization isValidJSONObject:@[value]]) {
+        return nil;
+    }
+
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@[value] options:(NSJSONWritingOptions)0 error:nil];
+
+    return data.length > 2 ? [data subdataWithRange:NSMakeRange(1, data.length - 2)] : nil;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,133 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class YHVScene;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Types
+
+/**
+ * @brief  Result of request comparison with chapter's indexed request fingerprint.
+ */
+typedef NS_ENUM(NSUInteger, YHVMatchIndexResult) {
+
+    /**
+     * @brief  At least one of indexed fields doesn't match, so chapter's request won't match with configured matchers.
+     */
+    YHVMatchIndexMismatch,
+
+    /**
+     * @brief  All fields which is required by configured matchers match.
+     */
+    YHVMatchIndexMatch,
+
+    /**
+     * @brief  Index doesn't have enough information and chapter's request should be checked with configured matchers.
+     */
+    YHVMatchIndexUndecided
+};
+
+
+/**
+ * @brief      Persisted match index for cassette's chapters.
+ * @discussion Index store canonical method, scheme, host, port, path and query fingerprints along with body digest for each
+ *             chapter's request, so request can be matched to chapter w/o cassette's scenes decoding.
+ *             Index stored alongside with cassette and contain cassette's file size and modification date which is used to find out
+ *             whether index is stale or not.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVMatchIndex : NSObject
+
+
+#pragma mark Information
+
+/**
+ * @brief  Stores reference on identifiers of chapters which has been indexed.
+ */
+@property (nonatomic, readonly, copy) NSSet<NSString *> *chapterIdentifiers;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Compose path at which match index for cassette should be stored.
+ *
+ * @param path Reference on path to cassette's file.
+ *
+ * @return Full path to match index file.
+ */
++ (NSString *)pathForCassetteAtPath:(NSString *)path;
+
+/**
+ * @brief  Load match index which has been stored alongside with cassette.
+ *
+ * @param path Reference on path to cassette's file.
+ *
+ * @return Loaded match index or \c nil in case if index is missing, has unsupported version or stale.
+ */
++ (nullable instancetype)indexForCassetteAtPath:(NSString *)path;
+
+/**
+ * @brief      Create match index for chapter's request scenes.
+ * @discussion Fingerprints from passed \c index reused for chapters which already has been indexed, so only new chapter's request
+ *             scenes will be decoded.
+ *
+ * @param scenes Reference on list of chapter's request scenes.
+ * @param index  Reference on previously created match index.
+ *
+ * @return Configured and ready to use match index.
+ */
++ (instancetype)indexWithRequestScenes:(NSArray<YHVScene *> *)scenes reusingIndex:(nullable YHVMatchIndex *)index;
+
+
+#pragma mark - Storage
+
+/**
+ * @brief  Store match index alongside with cassette.
+ *
+ * @param path Reference on path to cassette's file which should be described by index.
+ *
+ * @return Whether index has been written or not.
+ */
+- (BOOL)writeForCassetteAtPath:(NSString *)path;
+
+
+#pragma mark - Matching
+
+/**
+ * @brief  Compose fingerprint for request.
+ *
+ * @param request  Reference on request for which fingerprint should be created.
+ * @param matchers Reference on list of bundled matcher identifiers which will be used to compare fingerprints.
+ *
+ * @return Request's fingerprint.
+ */
++ (NSDictionary *)fingerprintForRequest:(NSURLRequest *)request withMatchers:(NSArray<NSString *> *)matchers;
+
+/**
+ * @brief      Compare request's fingerprint to indexed chapter's request fingerprint.
+ * @discussion Only fields which is checked by passed matchers compared. Body digest used only to confirm match, because \c body
+ *             matcher normalize some of the bodies before comparison.
+ *
+ * @param fingerprint Reference on fingerprint which has been created for request.
+ * @param identifier  Unique identifier of chapter with which request should be compared.
+ * @param matchers    Reference on list of bundled matcher identifiers which should be used for comparison.
+ *
+ * @return One of \b YHVMatchIndexResult fields.
+ */
+- (YHVMatchIndexResult)matchFingerprint:(NSDictionary *)fingerprint
+                toChapterWithIdentifier:(NSString *)identifier
+                           withMatchers:(NSArray<NSString *> *)matchers;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
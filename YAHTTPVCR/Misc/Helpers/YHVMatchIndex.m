@@ -0,0 +1,361 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVMatchIndex.h"
+#import "NSURLRequest+YHVPlayer.h"
+#import "NSDictionary+YHVNSURL.h"
+#import "YHVStructures.h"
+#import "YHVScene.h"
+#import "YHVVCR.h"
+
+
+#pragma mark Constants
+
+/**
+ * @brief      Stores version of match index format.
+ * @discussion Version should be changed each time when fingerprint composition changes, so previously stored indices will be rebuilt.
+ */
+static NSUInteger const kYHVMatchIndexVersion = 1;
+
+/**
+ * @brief  Stores reference on extension which is appended to cassette's path to get match index path.
+ */
+static NSString * const kYHVMatchIndexPathExtension = @"index";
+
+/**
+ * @brief  Stores reference on key under which stored match index format version.
+ */
+static NSString * const kYHVMatchIndexVersionKey = @"version";
+
+/**
+ * @brief  Stores reference on key under which stored cassette's file size at the moment of index write.
+ */
+static NSString * const kYHVMatchIndexCassetteSizeKey = @"size";
+
+/**
+ * @brief  Stores reference on key under which stored cassette's file modification date (in milliseconds) at the moment of index
+ *         write.
+ */
+static NSString * const kYHVMatchIndexCassetteModificationDateKey = @"modified";
+
+/**
+ * @brief  Stores reference on key under which stored chapter's request fingerprints.
+ */
+static NSString * const kYHVMatchIndexChaptersKey = @"chapters";
+
+/**
+ * @brief  Stores reference on fingerprint keys under which stored request fields.
+ */
+static NSString * const kYHVMatchIndexMethodKey = @"method";
+static NSString * const kYHVMatchIndexSchemeKey = @"scheme";
+static NSString * const kYHVMatchIndexHostKey = @"host";
+static NSString * const kYHVMatchIndexPortKey = @"port";
+static NSString * const kYHVMatchIndexPathKey = @"path";
+static NSString * const kYHVMatchIndexQueryKey = @"query";
+static NSString * const kYHVMatchIndexDigestKey = @"digest";
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Protected interface declaration
+
+@interface YHVMatchIndex ()
+
+
+#pragma mark - Information
+
+/**
+ * @brief  Stores reference on dictionary which maps chapter identifier to it's request fingerprint.
+ */
+@property (nonatomic, copy) NSDictionary<NSString *, NSDictionary *> *fingerprints;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize match index.
+ *
+ * @param fingerprints Reference on dictionary which maps chapter identifier to it's request fingerprint.
+ *
+ * @return Initialized and ready to use match index.
+ */
+- (instancetype)initWithFingerprints:(NSDictionary<NSString *, NSDictionary *> *)fingerprints;
+
+
+#pragma mark - Misc
+
+/**
+ * @brief  Retrieve attributes of cassette's file which is used to detect stale index.
+ *
+ * @param path Reference on path to cassette's file.
+ *
+ * @return Dictionary with cassette's file size and modification date or \c nil in case if file doesn't exists.
+ */
++ (nullable NSDictionary *)attributesOfCassetteAtPath:(NSString *)path;
+
+/**
+ * @brief  Check whether fingerprint field values is equal.
+ *
+ * @param value      Reference on request fingerprint field value.
+ * @param stubValue  Reference on indexed fingerprint field value.
+ * @param allowEmpty Whether missing values in both fingerprints should be treated as equal or not.
+ *
+ * @return Whether values is equal or not.
+ */
++ (BOOL)value:(nullable id)value isEqualToValue:(nullable id)stubValue allowEmpty:(BOOL)allowEmpty;
+
+/**
+ * @brief  Check whether URI ports is equal.
+ *
+ * @param port     Reference on request's URI port.
+ * @param stubPort Reference on indexed URI port.
+ *
+ * @return Whether ports is equal in the same way as \c port matcher compare them or not.
+ */
++ (BOOL)port:(nullable NSNumber *)port isEqualToPort:(nullable NSNumber *)stubPort;
+
+/**
+ * @brief  Check whether URI queries is equal.
+ *
+ * @param query     Reference on request's URI query string.
+ * @param stubQuery Reference on indexed URI query string.
+ *
+ * @return Whether queries is equal in the same way as \c query matcher compare them or not.
+ */
++ (BOOL)query:(nullable NSString *)query isEqualToQuery:(nullable NSString *)stubQuery;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVMatchIndex
+
+
+#pragma mark - Information
+
+- (NSSet<NSString *> *)chapterIdentifiers {
+
+    return [NSSet setWithArray:self.fingerprints.allKeys];
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (NSString *)pathForCassetteAtPath:(NSString *)path {
+
+    return [path stringByAppendingPathExtension:kYHVMatchIndexPathExtension];
+}
+
++ (instancetype)indexForCassetteAtPath:(NSString *)path {
+
+    NSData *indexData = [NSData dataWithContentsOfFile:[self pathForCassetteAtPath:path]];
+    NSDictionary *attributes = [self attributesOfCassetteAtPath:path];
+
+    if (!indexData || !attributes) {
+        return nil;
+    }
+
+    NSDictionary *index = [NSJSONSerialization JSONObjectWithData:indexData options:(NSJSONReadingOptions)0 error:nil];
+
+    if (![index isKindOfClass:[NSDictionary class]] || ![index[kYHVMatchIndexChaptersKey] isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+
+    if (((NSNumber *)index[kYHVMatchIndexVersionKey]).unsignedIntegerValue != kYHVMatchIndexVersion ||
+        ![index[kYHVMatchIndexCassetteSizeKey] isEqual:attributes[kYHVMatchIndexCassetteSizeKey]] ||
+        ![index[kYHVMatchIndexCassetteModificationDateKey] isEqual:attributes[kYHVMatchIndexCassetteModificationDateKey]]) {
+
+        return nil;
+    }
+
+    return [[self alloc] initWithFingerprints:index[kYHVMatchIndexChaptersKey]];
+}
+
++ (instancetype)indexWithRequestScenes:(NSArray<YHVScene *> *)scenes reusingIndex:(YHVMatchIndex *)index {
+
+    NSMutableDictionary<NSString *, NSDictionary *> *fingerprints = [NSMutableDictionary new];
+    NSArray<NSString *> *matchers = @[YHVMatcher.method, YHVMatcher.uri, YHVMatcher.body];
+
+    for (YHVScene *scene in scenes) {
+        NSDictionary *fingerprint = index.fingerprints[scene.identifier];
+
+        if (!fingerprint && scene.type == YHVRequestScene && [(id)scene.data isKindOfClass:[NSURLRequest class]]) {
+            fingerprint = [self fingerprintForRequest:(NSURLRequest *)scene.data withMatchers:matchers];
+        }
+
+        if (fingerprint) {
+            fingerprints[scene.identifier] = fingerprint;
+        }
+    }
+
+    return [[self alloc] initWithFingerprints:fingerprints];
+}
+
+- (instancetype)initWithFingerprints:(NSDictionary<NSString *, NSDictionary *> *)fingerprints {
+
+    if ((self = [super init])) {
+        _fingerprints = [fingerprints copy];
+    }
+
+    return self;
+}
+
+
+#pragma mark - Storage
+
+- (BOOL)writeForCassetteAtPath:(NSString *)path {
+
+    NSMutableDictionary *index = [([[self class] attributesOfCassetteAtPath:path] ?: @{}) mutableCopy];
+    index[kYHVMatchIndexVersionKey] = @(kYHVMatchIndexVersion);
+    index[kYHVMatchIndexChaptersKey] = self.fingerprints;
+
+    if (!index[kYHVMatchIndexCassetteSizeKey]) {
+        return NO;
+    }
+
+    NSData *indexData = [NSJSONSerialization dataWithJSONObject:index options:(NSJSONWritingOptions)0 error:nil];
+
+    return [indexData writeToFile:[[self class] pathForCassetteAtPath:path] atomically:YES];
+}
+
+
+#pragma mark - Matching
+
++ (NSDictionary *)fingerprintForRequest:(NSURLRequest *)request withMatchers:(NSArray<NSString *> *)matchers {
+
+    NSMutableDictionary *fingerprint = [NSMutableDictionary new];
+    NSURL *url = request.URL;
+
+    fingerprint[kYHVMatchIndexMethodKey] = request.HTTPMethod.lowercaseString;
+    fingerprint[kYHVMatchIndexSchemeKey] = url.scheme.lowercaseString;
+    fingerprint[kYHVMatchIndexHostKey] = url.host.lowercaseString;
+    fingerprint[kYHVMatchIndexPortKey] = url.port;
+    fingerprint[kYHVMatchIndexPathKey] = url.path.lowercaseString;
+    fingerprint[kYHVMatchIndexQueryKey] = url.query;
+
+    // Digest calculation may require to drain request's body stream, so it is done only when it will be used.
+    if ([matchers containsObject:YHVMatcher.body]) {
+        fingerprint[kYHVMatchIndexDigestKey] = [request.YHV_HTTPBodyDigest base64EncodedStringWithOptions:(NSDataBase64EncodingOptions)0];
+    }
+
+    return fingerprint;
+}
+
+- (YHVMatchIndexResult)matchFingerprint:(NSDictionary *)fingerprint
+                toChapterWithIdentifier:(NSString *)identifier
+                           withMatchers:(NSArray<NSString *> *)matchers {
+
+    NSDictionary *stubFingerprint = self.fingerprints[identifier];
+    YHVMatchIndexResult result = YHVMatchIndexMatch;
+    BOOL matchURI = [matchers containsObject:YHVMatcher.uri];
+    Class cls = [self class];
+
+    if (!stubFingerprint) {
+        return YHVMatchIndexUndecided;
+    }
+
+    if ([matchers containsObject:YHVMatcher.method] &&
+        ![cls value:fingerprint[kYHVMatchIndexMethodKey] isEqualToValue:stubFingerprint[kYHVMatchIndexMethodKey] allowEmpty:NO]) {
+
+        return YHVMatchIndexMismatch;
+    }
+
+    if ((matchURI || [matchers containsObject:YHVMatcher.scheme]) &&
+        ![cls value:fingerprint[kYHVMatchIndexSchemeKey] isEqualToValue:stubFingerprint[kYHVMatchIndexSchemeKey] allowEmpty:NO]) {
+
+        return YHVMatchIndexMismatch;
+    }
+
+    if ((matchURI || [matchers containsObject:YHVMatcher.host]) &&
+        ![cls value:fingerprint[kYHVMatchIndexHostKey] isEqualToValue:stubFingerprint[kYHVMatchIndexHostKey] allowEmpty:NO]) {
+
+        return YHVMatchIndexMismatch;
+    }
+
+    if ((matchURI || [matchers containsObject:YHVMatcher.port]) &&
+        ![cls port:fingerprint[kYHVMatchIndexPortKey] isEqualToPort:stubFingerprint[kYHVMatchIndexPortKey]]) {
+
+        return YHVMatchIndexMismatch;
+    }
+
+    if ((matchURI || [matchers containsObject:YHVMatcher.path]) &&
+        ![cls value:fingerprint[kYHVMatchIndexPathKey] isEqualToValue:stubFingerprint[kYHVMatchIndexPathKey] allowEmpty:NO]) {
+
+        return YHVMatchIndexMismatch;
+    }
+
+    if ((matchURI || [matchers containsObject:YHVMatcher.query]) &&
+        ![cls query:fingerprint[kYHVMatchIndexQueryKey] isEqualToQuery:stubFingerprint[kYHVMatchIndexQueryKey]]) {
+
+        return YHVMatchIndexMismatch;
+    }
+
+    if ([matchers containsObject:YHVMatcher.body] &&
+        ![cls value:fingerprint[kYHVMatchIndexDigestKey] isEqualToValue:stubFingerprint[kYHVMatchIndexDigestKey] allowEmpty:YES]) {
+
+        result = YHVMatchIndexUndecided;
+    }
+
+    if ([matchers containsObject:YHVMatcher.headers]) {
+        result = YHVMatchIndexUndecided;
+    }
+
+    return result;
+}
+
+
+#pragma mark - Misc
+
++ (NSDictionary *)attributesOfCassetteAtPath:(NSString *)path {
+
+    NSDictionary<NSFileAttributeKey, id> *attributes = [NSFileManager.defaultManager attributesOfItemAtPath:path error:nil];
+
+    if (!attributes) {
+        return nil;
+    }
+
+    return @{
+        kYHVMatchIndexCassetteSizeKey: @(attributes.fileSize),
+        kYHVMatchIndexCassetteModificationDateKey: @((long long)llround(attributes.fileModificationDate.timeIntervalSince1970 * 1000.0))
+    };
+}
+
++ (BOOL)value:(id)value isEqualToValue:(id)stubValue allowEmpty:(BOOL)allowEmpty {
+
+    if (!value || !stubValue) {
+        return allowEmpty && !value && !stubValue;
+    }
+
+    return [value isEqual:stubValue];
+}
+
++ (BOOL)port:(NSNumber *)port isEqualToPort:(NSNumber *)stubPort {
+
+    // 'port' matcher treat request w/o explicit port as matching to any indexed port.
+    return !stubPort ? !port : (!port || [port isEqualToNumber:stubPort]);
+}
+
++ (BOOL)query:(NSString *)query isEqualToQuery:(NSString *)stubQuery {
+
+    if ((!query && !stubQuery) || [query isEqualToString:stubQuery]) {
+        return YES;
+    }
+
+    NSDictionary *queryDictionary = [NSDictionary YHV_dictionaryWithQuery:query sortQueryListOnMatch:YHVVCR.matchQueryWithSortedListValue];
+    NSDictionary *stubQueryDictionary = [NSDictionary YHV_dictionaryWithQuery:stubQuery
+                                                         sortQueryListOnMatch:YHVVCR.matchQueryWithSortedListValue];
+
+    return [queryDictionary isEqualToDictionary:stubQueryDictionary];
+}
+
+#pragma mark -
+
+
+@end
@@ -50,41 +50,53 @@
     
     source = isClassMethods ? object_getClass(source) : source;
     target = isClassMethods ? object_getClass(target) : target;
+    const char *methodPrefix = prefix.UTF8String;
+    size_t prefixLength = methodPrefix ? strlen(methodPrefix) : 0;
     unsigned int sourceMethodsCount = 0;
     Method *sourceMethods = class_copyMethodList(source, &sourceMethodsCount);
 
     for (unsigned int methodIdx = 0; methodIdx < sourceMethodsCount; methodIdx++) {
         SEL methodSelector = method_getName(sourceMethods[methodIdx]);
-        NSString *methodName = NSStringFromSelector(methodSelector);
+        const char *methodName = sel_getName(methodSelector);
         const char *methodTypeEncoding = method_getTypeEncoding(sourceMethods[methodIdx]);
         
-        if (prefix) {
-            if ([methodName rangeOfString:prefix].location == NSNotFound) {
+        // Selectors compared as C strings to avoid objects creation for each method of source class.
+        if (prefixLength) {
+            if (strncmp(methodName, methodPrefix, prefixLength) != 0) {
                 continue;
             }
             
-            methodName = [methodName stringByReplacingOccurrencesOfString:prefix withString:@""];
+            methodName += prefixLength;
         }
         
-        SEL originalSelector = NSSelectorFromString(methodName);
+        if (!methodName[0]) {
+            continue;
+        }
+        
+        SEL originalSelector = sel_registerName(methodName);
         SEL swizzledSelector = methodSelector;
         
-        IMP originalImplementation = class_getMethodImplementation(target, originalSelector);
-        IMP swizzledImplementation = method_getImplementation(sourceMethods[methodIdx]);
+        // Target is metaclass for class methods, so instance method lookup will find class method as well.
+        // class_getMethodImplementation can't be used for this check, because it returns forwarding stub for unknown selectors.
+        Method originalMethod = class_getInstanceMethod(target, originalSelector);
         
-        if (!originalSelector) {
-            NSLog(@"Unable to swizzle '%@', because '%@' doesn't have it.", methodName, NSStringFromClass(target));
+        if (!originalMethod) {
+            NSLog(@"Unable to swizzle '%s', because '%@' doesn't have it.", methodName, NSStringFromClass(target));
             
             continue;
         }
+        
+        IMP originalImplementation = method_getImplementation(originalMethod);
+        IMP swizzledImplementation = method_getImplementation(sourceMethods[methodIdx]);
 
         if (class_addMethod(target, swizzledSelector, originalImplementation, methodTypeEncoding)) {
             class_replaceMethod(target, originalSelector, swizzledImplementation, methodTypeEncoding);
         } else {
-            Method (*yhv_class_getMethod)(Class cls, SEL name) = isClassMethods ? class_getClassMethod : class_getInstanceMethod;
-            method_exchangeImplementations(yhv_class_getMethod(target, originalSelector), sourceMethods[methodIdx]);
+            method_exchangeImplementations(originalMethod, sourceMethods[methodIdx]);
         }
     }
+    
+    free(sourceMethods);
 }
 
 #pragma mark -
@@ -0,0 +1,47 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      Compiled list of key value replacement rules.
+ * @discussion Rule set created once during cassette insertion from \c headersFilter or \c queryParametersFilter dictionary, so keys
+ *             case-folding doesn't happen for each filtered request and cost of filtering depends only from number of keys in filtered
+ *             dictionary.
+ *             Keys compared case-insensitively. \a NSNull used as replacement value cause key removal.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVReplacementRuleSet : NSObject
+
+
+#pragma mark Initialization and Configuration
+
+/**
+ * @brief  Create and configure replacement rule set.
+ *
+ * @param replacements Reference on dictionary which maps key names to values which should be used instead of original.
+ *
+ * @return Configured and ready to use rule set.
+ */
++ (instancetype)ruleSetWithReplacements:(NSDictionary *)replacements;
+
+
+#pragma mark - Filtering
+
+/**
+ * @brief  Replace or remove values in passed dictionary for keys which has rules.
+ *
+ * @param dictionary Reference on dictionary which should be modified.
+ *
+ * @return Reference on passed dictionary so methods can be chained.
+ */
+- (NSMutableDictionary *)applyToDictionary:(NSMutableDictionary *)dictionary;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,100 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVReplacementRuleSet.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Protected interface declaration
+
+@interface YHVReplacementRuleSet ()
+
+
+#pragma mark - Information
+
+/**
+ * @brief  Stores reference on dictionary which maps lowercased key names to replacement values.
+ */
+@property (nonatomic, strong) NSDictionary<NSString *, id> *replacements;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize replacement rule set.
+ *
+ * @param replacements Reference on dictionary which maps key names to values which should be used instead of original.
+ *
+ * @return Initialized and ready to use rule set.
+ */
+- (instancetype)initWithReplacements:(NSDictionary *)replacements;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVReplacementRuleSet
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)ruleSetWithReplacements:(NSDictionary *)replacements {
+
+    return [[self alloc] initWithReplacements:replacements];
+}
+
+- (instancetype)initWithReplacements:(NSDictionary *)replacements {
+
+    if ((self = [super init])) {
+        NSMutableDictionary<NSString *, id> *caseFoldedReplacements = [NSMutableDictionary new];
+
+        for (id key in replacements) {
+            NSString *ruleKey = [key isKindOfClass:[NSString class]] ? ((NSString *)key).lowercaseString : key;
+            caseFoldedReplacements[ruleKey] = replacements[key];
+        }
+
+        _replacements = [caseFoldedReplacements copy];
+    }
+
+    return self;
+}
+
+
+#pragma mark - Filtering
+
+- (NSMutableDictionary *)applyToDictionary:(NSMutableDictionary *)dictionary {
+
+    if (!self.replacements.count || !dictionary.count) {
+        return dictionary;
+    }
+
+    for (id key in dictionary.allKeys) {
+        id ruleKey = [key isKindOfClass:[NSString class]] ? ((NSString *)key).lowercaseString : key;
+        id replacement = self.replacements[ruleKey];
+
+        if (!replacement) {
+            continue;
+        }
+
+        if ([replacement isKindOfClass:[NSNull class]]) {
+            [dictionary removeObjectForKey:key];
+        } else {
+            dictionary[key] = replacement;
+        }
+    }
+
+    return dictionary;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,66 @@
+#import <Foundation/Foundation.h>
+
+
+#pragma mark Class forward
+
+@class YHVReplayConnection;
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Types
+
+/**
+ * @brief  Connection close handling block.
+ *
+ * @param connection Reference on connection which has been closed.
+ */
+typedef void(^YHVReplayConnectionCloseBlock)(YHVReplayConnection *connection);
+
+
+/**
+ * @brief      Replay server's client connection.
+ * @discussion Connection parse HTTP/1.1 requests from socket and play responses for them from inserted cassette. Connection act as
+ *             URL loading protocol client, so responses played by cassette same way as for Foundation URL loading system.
+ *             Pipelined requests processed one after another.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVReplayConnection : NSObject <NSURLProtocolClient>
+
+
+#pragma mark Initialization and Configuration
+
+/**
+ * @brief  Create and configure connection for accepted client socket.
+ *
+ * @param socket  Accepted client socket descriptor. Connection take ownership over descriptor.
+ * @param baseURL Reference on URL which should be used to compose requests for matching.
+ * @param block   Reference on block which should be called when connection will be closed.
+ *
+ * @return Configured and ready to use connection.
+ */
++ (instancetype)connectionWithSocket:(int)socket
+                             baseURL:(nullable NSURL *)baseURL
+                        closeHandler:(YHVReplayConnectionCloseBlock)block;
+
+
+#pragma mark - State
+
+/**
+ * @brief  Start reading requests from client socket.
+ */
+- (void)open;
+
+/**
+ * @brief  Close client socket.
+ */
+- (void)close;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,822 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVReplayConnection.h"
+#import "YHVNSURLProtocol.h"
+#import "YHVVCR+Player.h"
+#import <sys/socket.h>
+#import <unistd.h>
+#import <fcntl.h>
+#import <errno.h>
+
+
+#pragma mark Constants
+
+/**
+ * @brief  Stores maximum size of request's head (request line and headers).
+ */
+static NSUInteger const kYHVReplayConnectionMaximumHeadLength = 65536;
+
+/**
+ * @brief  Stores size of buffer which is used to read data from socket.
+ */
+static NSUInteger const kYHVReplayConnectionReadBufferSize = 65536;
+
+/**
+ * @brief      Stores maximum time (in seconds) during which connection wait for client to receive sent data.
+ * @discussion Responses written synchronously on connection's queue, so client which stopped reading won't block it forever.
+ */
+static time_t const kYHVReplayConnectionSendTimeout = 10;
+
+
+#pragma mark - Private interface declaration
+
+@interface YHVReplayConnection ()
+
+
+#pragma mark - Information
+
+/**
+ * @brief  Stores client socket descriptor.
+ */
+@property (nonatomic, assign) int socket;
+
+/**
+ * @brief  Stores reference on URL which should be used to compose requests for matching.
+ */
+@property (nonatomic, nullable, copy) NSURL *baseURL;
+
+/**
+ * @brief  Stores reference on block which should be called when connection will be closed.
+ */
+@property (nonatomic, nullable, copy) YHVReplayConnectionCloseBlock closeHandler;
+
+/**
+ * @brief  Stores reference on source which is used to read data from client socket.
+ */
+@property (nonatomic, nullable, strong) dispatch_source_t readSource;
+
+/**
+ * @brief  Stores reference on queue which is used to serialize socket access and request processing.
+ */
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+
+/**
+ * @brief  Stores reference on data which has been received from client but not processed yet.
+ */
+@property (nonatomic, strong) NSMutableData *buffer;
+
+/**
+ * @brief  Stores reference on protocol which is used to play responses for currently processed request.
+ */
+@property (nonatomic, nullable, strong) YHVNSURLProtocol *protocol;
+
+/**
+ * @brief  Stores whether request currently processed or not.
+ */
+@property (nonatomic, assign, getter = isProcessing) BOOL processing;
+
+/**
+ * @brief  Stores whether response status line and headers has been sent for currently processed request.
+ */
+@property (nonatomic, assign) BOOL responseSent;
+
+/**
+ * @brief  Stores whether response for currently processed request can have body or not.
+ */
+@property (nonatomic, assign) BOOL bodyAllowed;
+
+/**
+ * @brief  Stores whether response body for currently processed request sent with chunked transfer encoding.
+ */
+@property (nonatomic, assign) BOOL chunked;
+
+/**
+ * @brief  Stores whether connection should be kept open after currently processed request completion.
+ */
+@property (nonatomic, assign) BOOL keepAlive;
+
+/**
+ * @brief  Stores whether connection has been closed or not.
+ */
+@property (nonatomic, assign, getter = isClosed) BOOL closed;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize connection for accepted client socket.
+ *
+ * @param socket  Accepted client socket descriptor.
+ * @param baseURL Reference on URL which should be used to compose requests for matching.
+ * @param block   Reference on block which should be called when connection will be closed.
+ *
+ * @return Initialized and ready to use connection.
+ */
+- (instancetype)initWithSocket:(int)socket baseURL:(nullable NSURL *)baseURL closeHandler:(YHVReplayConnectionCloseBlock)block;
+
+
+#pragma mark - Reading
+
+/**
+ * @brief  Read data which is available in client socket.
+ *
+ * @param length Number of bytes which is reported as available by read source.
+ */
+- (void)readAvailableDataWithLength:(unsigned long)length;
+
+/**
+ * @brief      Try to parse and handle next request from received data.
+ * @discussion Nothing will be done if another request currently processed or not whole request has been received.
+ */
+- (void)processBuffer;
+
+/**
+ * @brief  Parse request's body from received data.
+ *
+ * @param headers Reference on dictionary with lowercased request's header names and values.
+ * @param offset  Offset in buffer at which body starts.
+ * @param length  Pointer which will store number of bytes which has been used by body.
+ * @param failed  Pointer which will store whether body is malformed or not.
+ *
+ * @return Request body or \c nil in case if whole body not received yet.
+ */
+- (nullable NSData *)bodyWithHeaders:(NSDictionary<NSString *, NSString *> *)headers
+                            atOffset:(NSUInteger)offset
+                              length:(NSUInteger *)length
+                              failed:(BOOL *)failed;
+
+/**
+ * @brief  Decode request's body which has been sent with chunked transfer encoding.
+ *
+ * @param offset Offset in buffer at which body starts.
+ * @param length Pointer which will store number of bytes which has been used by encoded body.
+ * @param failed Pointer which will store whether body is malformed or not.
+ *
+ * @return Decoded request body or \c nil in case if whole body not received yet.
+ */
+- (nullable NSData *)chunkedBodyAtOffset:(NSUInteger)offset length:(NSUInteger *)length failed:(BOOL *)failed;
+
+
+#pragma mark - Request handling
+
+/**
+ * @brief  Compose request which can be matched against cassette's chapters.
+ *
+ * @param method  Request's HTTP method.
+ * @param target  Request's target from request line.
+ * @param headers Reference on dictionary with request's header names and values.
+ * @param body    Reference on request's body.
+ *
+ * @return Composed request or \c nil in case if valid URL can't be composed.
+ */
+- (nullable NSURLRequest *)requestWithMethod:(NSString *)method
+                                      target:(NSString *)target
+                                     headers:(NSDictionary<NSString *, NSString *> *)headers
+                                        body:(nullable NSData *)body;
+
+/**
+ * @brief  Play responses recorded for request.
+ *
+ * @param request Reference on request for which responses should be played.
+ */
+- (void)handleRequest:(NSURLRequest *)request;
+
+/**
+ * @brief  Complete currently processed request and proceed to next one (if any).
+ */
+- (void)finishRequest;
+
+
+#pragma mark - Writing
+
+/**
+ * @brief  Send response status line and headers.
+ *
+ * @param response Reference on response which should be sent to client.
+ */
+- (void)writeResponseHead:(NSHTTPURLResponse *)response;
+
+/**
+ * @brief  Send complete response with textual body.
+ *
+ * @param statusCode Response's HTTP status code.
+ * @param message    Reference on message which should be sent as response body.
+ */
+- (void)writeResponseWithStatusCode:(NSInteger)statusCode message:(NSString *)message;
+
+/**
+ * @brief  Send response body chunk.
+ *
+ * @param data Reference on chunk of body which should be sent to client.
+ */
+- (void)writeBodyData:(NSData *)data;
+
+/**
+ * @brief  Send data to client.
+ *
+ * @param data Reference on data which should be sent.
+ *
+ * @return Whether all data has been sent or not.
+ */
+- (BOOL)writeData:(NSData *)data;
+
+
+#pragma mark - Misc
+
+/**
+ * @brief  Close socket and notify connection owner.
+ */
+- (void)closeConnection;
+
+/**
+ * @brief  Compose set of header names which describe connection and shouldn't be passed along with request or response.
+ *
+ * @return Set of lowercased header names.
+ */
++ (NSSet<NSString *> *)hopByHopHeaders;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVReplayConnection
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)connectionWithSocket:(int)socket baseURL:(NSURL *)baseURL closeHandler:(YHVReplayConnectionCloseBlock)block {
+
+    return [[self alloc] initWithSocket:socket baseURL:baseURL closeHandler:block];
+}
+
+- (instancetype)initWithSocket:(int)socket baseURL:(NSURL *)baseURL closeHandler:(YHVReplayConnectionCloseBlock)block {
+
+    if ((self = [super init])) {
+        _resourceAccessQueue = dispatch_queue_create("com.yetanotherhttpvcr.replay-connection", DISPATCH_QUEUE_SERIAL);
+        _buffer = [NSMutableData new];
+        _baseURL = [baseURL copy];
+        _closeHandler = [block copy];
+        _socket = socket;
+    }
+
+    return self;
+}
+
+
+#pragma mark - State
+
+- (void)open {
+
+    dispatch_async(self.resourceAccessQueue, ^{
+        if (self.isClosed || self.readSource) {
+            return;
+        }
+
+        // Accepted socket inherit non-blocking mode from listening socket, but responses written synchronously.
+        struct timeval sendTimeout = { .tv_sec = kYHVReplayConnectionSendTimeout, .tv_usec = 0 };
+        fcntl(self.socket, F_SETFL, fcntl(self.socket, F_GETFL, 0) & ~O_NONBLOCK);
+        setsockopt(self.socket, SOL_SOCKET, SO_SNDTIMEO, &sendTimeout, sizeof(sendTimeout));
+
+        int clientSocket = self.socket;
+        dispatch_source_t source = dispatch_source_create(DISPATCH_SOURCE_TYPE_READ, (uintptr_t)clientSocket, 0,
+                                                          self.resourceAccessQueue);
+        __weak __typeof(self) weakSelf = self;
+
+        dispatch_source_set_event_handler(source, ^{
+            __strong __typeof(weakSelf) strongSelf = weakSelf;
+
+            if (strongSelf.readSource) {
+                [strongSelf readAvailableDataWithLength:dispatch_source_get_data(strongSelf.readSource)];
+            }
+        });
+
+        dispatch_source_set_cancel_handler(source, ^{
+            close(clientSocket);
+        });
+
+        self.readSource = source;
+        dispatch_resume(source);
+    });
+}
+
+- (void)close {
+
+    dispatch_async(self.resourceAccessQueue, ^{
+        [self closeConnection];
+    });
+}
+
+
+#pragma mark - Reading
+
+- (void)readAvailableDataWithLength:(unsigned long)length {
+
+    NSUInteger bufferSize = MAX(MIN((NSUInteger)length, kYHVReplayConnectionReadBufferSize), 1);
+    NSMutableData *data = [NSMutableData dataWithLength:bufferSize];
+    ssize_t readLength = recv(self.socket, data.mutableBytes, bufferSize, 0);
+
+    if (readLength <= 0) {
+        [self closeConnection];
+        return;
+    }
+
+    [self.buffer appendBytes:data.bytes length:(NSUInteger)readLength];
+    [self processBuffer];
+}
+
+- (void)processBuffer {
+
+    if (self.isClosed || self.isProcessing) {
+        return;
+    }
+
+    self.bodyAllowed = YES;
+    NSData *headTerminator = [@"\r\n\r\n" dataUsingEncoding:NSASCIIStringEncoding];
+    NSRange headRange = [self.buffer rangeOfData:headTerminator options:(NSDataSearchOptions)0
+                                           range:NSMakeRange(0, self.buffer.length)];
+
+    if (headRange.location == NSNotFound) {
+        if (self.buffer.length > kYHVReplayConnectionMaximumHeadLength) {
+            self.keepAlive = NO;
+            [self writeResponseWithStatusCode:431 message:@"Request header fields too large."];
+            [self closeConnection];
+        }
+
+        return;
+    }
+
+    NSData *headData = [self.buffer subdataWithRange:NSMakeRange(0, headRange.location)];
+    NSString *head = [[NSString alloc] initWithData:headData encoding:NSISOLatin1StringEncoding];
+    NSArray<NSString *> *lines = [head componentsSeparatedByString:@"\r\n"];
+    NSArray<NSString *> *requestLine = [lines.firstObject componentsSeparatedByString:@" "];
+    NSMutableDictionary<NSString *, NSString *> *normalizedHeaders = [NSMutableDictionary new];
+    NSMutableDictionary<NSString *, NSString *> *headers = [NSMutableDictionary new];
+
+    for (NSUInteger lineIdx = 1; lineIdx < lines.count; lineIdx++) {
+        NSRange separatorRange = [lines[lineIdx] rangeOfString:@":"];
+
+        if (separatorRange.location == NSNotFound) {
+            continue;
+        }
+
+        NSCharacterSet *whitespaces = [NSCharacterSet whitespaceCharacterSet];
+        NSString *name = [[lines[lineIdx] substringToIndex:separatorRange.location] stringByTrimmingCharactersInSet:whitespaces];
+        NSString *value = [[lines[lineIdx] substringFromIndex:NSMaxRange(separatorRange)] stringByTrimmingCharactersInSet:whitespaces];
+
+        normalizedHeaders[name.lowercaseString] = value;
+        headers[name] = value;
+    }
+
+    if (requestLine.count != 3 || ![requestLine[2] hasPrefix:@"HTTP/1."]) {
+        self.keepAlive = NO;
+        [self writeResponseWithStatusCode:400 message:@"Malformed request line."];
+        [self closeConnection];
+        return;
+    }
+
+    NSUInteger bodyOffset = NSMaxRange(headRange);
+    NSUInteger bodyLength = 0;
+    BOOL malformedBody = NO;
+    NSData *body = [self bodyWithHeaders:normalizedHeaders atOffset:bodyOffset length:&bodyLength failed:&malformedBody];
+
+    if (malformedBody) {
+        self.keepAlive = NO;
+        [self writeResponseWithStatusCode:400 message:@"Malformed request body."];
+        [self closeConnection];
+        return;
+    }
+
+    if (!body) {
+        return;
+    }
+
+    [self.buffer replaceBytesInRange:NSMakeRange(0, bodyOffset + bodyLength) withBytes:NULL length:0];
+
+    NSString *connectionHeader = normalizedHeaders[@"connection"].lowercaseString;
+    NSString *method = requestLine[0];
+
+    self.keepAlive = [requestLine[2] isEqualToString:@"HTTP/1.1"] && ![connectionHeader isEqualToString:@"close"];
+    self.bodyAllowed = ![method isEqualToString:@"HEAD"];
+    self.chunked = self.keepAlive;
+    self.responseSent = NO;
+    self.processing = YES;
+
+    NSURLRequest *request = [self requestWithMethod:method target:requestLine[1] headers:headers body:body];
+
+    if (!request) {
+        [self writeResponseWithStatusCode:400 message:@"Unable to compose request URL."];
+        [self finishRequest];
+        return;
+    }
+
+    [self handleRequest:request];
+}
+
+- (NSData *)bodyWithHeaders:(NSDictionary<NSString *, NSString *> *)headers
+                   atOffset:(NSUInteger)offset
+                     length:(NSUInteger *)length
+                     failed:(BOOL *)failed {
+
+    NSString *transferEncoding = headers[@"transfer-encoding"].lowercaseString;
+    NSString *contentLength = headers[@"content-length"];
+    *failed = NO;
+    *length = 0;
+
+    if (transferEncoding && ![transferEncoding isEqualToString:@"identity"]) {
+        return [self chunkedBodyAtOffset:offset length:length failed:failed];
+    }
+
+    long long bodyLength = contentLength.longLongValue;
+
+    if (bodyLength < 0) {
+        *failed = YES;
+        return nil;
+    }
+
+    if (self.buffer.length - offset < (unsigned long long)bodyLength) {
+        return nil;
+    }
+
+    *length = (NSUInteger)bodyLength;
+
+    return [self.buffer subdataWithRange:NSMakeRange(offset, *length)];
+}
+
+- (NSData *)chunkedBodyAtOffset:(NSUInteger)offset length:(NSUInteger *)length failed:(BOOL *)failed {
+
+    NSData *lineTerminator = [@"\r\n" dataUsingEncoding:NSASCIIStringEncoding];
+    NSMutableData *body = [NSMutableData new];
+    NSUInteger position = offset;
+
+    while (YES) {
+        NSRange lineRange = [self.buffer rangeOfData:lineTerminator options:(NSDataSearchOptions)0
+                                               range:NSMakeRange(position, self.buffer.length - position)];
+
+        if (lineRange.location == NSNotFound) {
+            return nil;
+        }
+
+        NSData *sizeData = [self.buffer subdataWithRange:NSMakeRange(position, lineRange.location - position)];
+        NSString *sizeLine = [[NSString alloc] initWithData:sizeData encoding:NSASCIIStringEncoding];
+        NSScanner *scanner = [NSScanner scannerWithString:sizeLine ?: @""];
+        unsigned long long chunkSize = 0;
+
+        if (![scanner scanHexLongLong:&chunkSize]) {
+            *failed = YES;
+            return nil;
+        }
+
+        position = NSMaxRange(lineRange);
+
+        if (chunkSize == 0) {
+            // Skip trailer fields (if any) up to empty line.
+            while (YES) {
+                lineRange = [self.buffer rangeOfData:lineTerminator options:(NSDataSearchOptions)0
+                                               range:NSMakeRange(position, self.buffer.length - position)];
+
+                if (lineRange.location == NSNotFound) {
+                    return nil;
+                }
+
+                BOOL emptyLine = lineRange.location == position;
+                position = NSMaxRange(lineRange);
+
+                if (emptyLine) {
+                    *length = position - offset;
+                    return body;
+                }
+            }
+        }
+
+        if (self.buffer.length - position < chunkSize + lineTerminator.length) {
+            return nil;
+        }
+
+        [body appendData:[self.buffer subdataWithRange:NSMakeRange(position, (NSUInteger)chunkSize)]];
+        position += (NSUInteger)chunkSize + lineTerminator.length;
+    }
+}
+
+
+#pragma mark - Request handling
+
+- (NSURLRequest *)requestWithMethod:(NSString *)method
+                             target:(NSString *)target
+                            headers:(NSDictionary<NSString *, NSString *> *)headers
+                               body:(NSData *)body {
+
+    NSString *lowercaseTarget = target.lowercaseString;
+    NSString *urlString = target;
+
+    if (![lowercaseTarget hasPrefix:@"http://"] && ![lowercaseTarget hasPrefix:@"https://"]) {
+        NSString *baseURLString = self.baseURL.absoluteString;
+
+        if (!baseURLString) {
+            NSString *host = nil;
+
+            for (NSString *header in headers) {
+                if ([header.lowercaseString isEqualToString:@"host"]) {
+                    host = headers[header];
+                }
+            }
+
+            baseURLString = host.length ? [@"http://" stringByAppendingString:host] : nil;
+        }
+
+        while ([baseURLString hasSuffix:@"/"]) {
+            baseURLString = [baseURLString substringToIndex:baseURLString.length - 1];
+        }
+
+        urlString = baseURLString ? [baseURLString stringByAppendingString:target] : nil;
+    }
+
+    NSURL *url = urlString ? [NSURL URLWithString:urlString] : nil;
+
+    if (!url.host) {
+        return nil;
+    }
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
+    NSSet<NSString *> *hopByHopHeaders = [[self class] hopByHopHeaders];
+    request.HTTPMethod = method;
+
+    for (NSString *header in headers) {
+        NSString *lowercaseHeader = header.lowercaseString;
+
+        if (![hopByHopHeaders containsObject:lowercaseHeader] && ![lowercaseHeader isEqualToString:@"host"]) {
+            [request setValue:headers[header] forHTTPHeaderField:header];
+        }
+    }
+
+    if (body.length) {
+        request.HTTPBody = body;
+    }
+
+    return [request copy];
+}
+
+- (void)handleRequest:(NSURLRequest *)request {
+
+    if (![YHVVCR canPlayResponseForRequest:request]) {
+        NSString *message = [NSString stringWithFormat:@"There is no recorded response for %@ %@.", request.HTTPMethod,
+                             request.URL.absoluteString];
+
+        [self writeResponseWithStatusCode:404 message:message];
+        [self finishRequest];
+        return;
+    }
+
+    // Connection act as protocol's client, so cassette will play scenes same way as for URL loading system.
+    self.protocol = [[YHVNSURLProtocol alloc] initWithRequest:request cachedResponse:nil client:self];
+    [self.protocol startLoading];
+}
+
+- (void)finishRequest {
+
+    [self.protocol stopLoading];
+    self.protocol = nil;
+    self.processing = NO;
+
+    if (!self.keepAlive) {
+        [self closeConnection];
+        return;
+    }
+
+    [self processBuffer];
+}
+
+
+#pragma mark - Writing
+
+- (void)writeResponseHead:(NSHTTPURLResponse *)response {
+
+    NSInteger statusCode = response.statusCode;
+    NSSet<NSString *> *hopByHopHeaders = [[self class] hopByHopHeaders];
+    NSMutableString *head = [NSMutableString stringWithFormat:@"HTTP/1.1 %@ %@\r\n", @(statusCode),
+                             [NSHTTPURLResponse localizedStringForStatusCode:statusCode]];
+
+    self.bodyAllowed = self.bodyAllowed && statusCode >= 200 && statusCode != 204 && statusCode != 304;
+    self.chunked = self.chunked && self.bodyAllowed;
+    self.responseSent = YES;
+
+    [response.allHeaderFields enumerateKeysAndObjectsUsingBlock:^(NSString *header, NSString *value, BOOL *stop) {
+        NSString *lowercaseHeader = header.lowercaseString;
+
+        // Recorded body already decoded and it's length will be known only at the end of playback.
+        if (![hopByHopHeaders containsObject:lowercaseHeader] && ![lowercaseHeader isEqualToString:@"content-encoding"]) {
+            [head appendFormat:@"%@: %@\r\n", header, value];
+        }
+    }];
+
+    if (self.chunked) {
+        [head appendString:@"Transfer-Encoding: chunked\r\n"];
+    }
+
+    [head appendString:self.keepAlive ? @"Connection: keep-alive\r\n\r\n" : @"Connection: close\r\n\r\n"];
+    [self writeData:[head dataUsingEncoding:NSUTF8StringEncoding]];
+}
+
+- (void)writeResponseWithStatusCode:(NSInteger)statusCode message:(NSString *)message {
+
+    NSData *body = [message dataUsingEncoding:NSUTF8StringEncoding];
+    NSMutableString *head = [NSMutableString stringWithFormat:@"HTTP/1.1 %@ %@\r\n", @(statusCode),
+                             [NSHTTPURLResponse localizedStringForStatusCode:statusCode]];
+    [head appendFormat:@"Content-Type: text/plain; charset=utf-8\r\nContent-Length: %@\r\n", @(body.length)];
+    [head appendString:self.keepAlive ? @"Connection: keep-alive\r\n\r\n" : @"Connection: close\r\n\r\n"];
+
+    NSMutableData *response = [[head dataUsingEncoding:NSUTF8StringEncoding] mutableCopy];
+
+    if (self.bodyAllowed) {
+        [response appendData:body];
+    }
+
+    self.responseSent = YES;
+    [self writeData:response];
+}
+
+- (void)writeBodyData:(NSData *)data {
+
+    if (!self.bodyAllowed || !data.length) {
+        return;
+    }
+
+    if (!self.chunked) {
+        [self writeData:data];
+        return;
+    }
+
+    NSString *chunkSize = [NSString stringWithFormat:@"%lx\r\n", (unsigned long)data.length];
+    NSMutableData *chunk = [[chunkSize dataUsingEncoding:NSASCIIStringEncoding] mutableCopy];
+    [chunk appendData:data];
+    [chunk appendBytes:"\r\n" length:2];
+
+    [self writeData:chunk];
+}
+
+- (BOOL)writeData:(NSData *)data {
+
+    const uint8_t *bytes = data.bytes;
+    NSUInteger offset = 0;
+
+    while (!self.isClosed && offset < data.length) {
+        ssize_t writtenLength = send(self.socket, bytes + offset, data.length - offset, 0);
+
+        if (writtenLength < 0 && errno == EINTR) {
+            continue;
+        }
+
+        // Send timeout reported as EAGAIN, so connection with client which doesn't read responses will be closed.
+        if (writtenLength <= 0) {
+            [self closeConnection];
+            break;
+        }
+
+        offset += (NSUInteger)writtenLength;
+    }
+
+    return offset == data.length;
+}
+
+
+#pragma mark - NSURLProtocolClient
+
+- (void)URLProtocol:(NSURLProtocol *)protocol
+  didReceiveResponse:(NSURLResponse *)response
+  cacheStoragePolicy:(NSURLCacheStoragePolicy)__unused policy {
+
+    dispatch_async(self.resourceAccessQueue, ^{
+        if (self.isClosed || protocol != self.protocol || self.responseSent) {
+            return;
+        }
+
+        if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+            [self writeResponseHead:(NSHTTPURLResponse *)response];
+        } else {
+            NSHTTPURLResponse *httpResponse = [[NSHTTPURLResponse alloc] initWithURL:response.URL statusCode:200
+                                                                         HTTPVersion:@"HTTP/1.1" headerFields:nil];
+            [self writeResponseHead:httpResponse];
+        }
+    });
+}
+
+- (void)URLProtocol:(NSURLProtocol *)protocol didLoadData:(NSData *)data {
+
+    dispatch_async(self.resourceAccessQueue, ^{
+        if (self.isClosed || protocol != self.protocol || !self.responseSent) {
+            return;
+        }
+
+        [self writeBodyData:data];
+    });
+}
+
+- (void)URLProtocolDidFinishLoading:(NSURLProtocol *)protocol {
+
+    dispatch_async(self.resourceAccessQueue, ^{
+        if (self.isClosed || protocol != self.protocol) {
+            return;
+        }
+
+        if (!self.responseSent) {
+            [self writeResponseWithStatusCode:502 message:@"Recorded chapter doesn't contain response."];
+        } else if (self.chunked) {
+            [self writeData:[@"0\r\n\r\n" dataUsingEncoding:NSASCIIStringEncoding]];
+        } else if (self.bodyAllowed) {
+            // Without chunked encoding body end can be reported only by connection close.
+            self.keepAlive = NO;
+        }
+
+        [self finishRequest];
+    });
+}
+
+- (void)URLProtocol:(NSURLProtocol *)protocol didFailWithError:(NSError *)error {
+
+    dispatch_async(self.resourceAccessQueue, ^{
+        if (self.isClosed || protocol != self.protocol) {
+            return;
+        }
+
+        if (self.responseSent) {
+            // Truncate response, so client will be able to detect error.
+            self.keepAlive = NO;
+        } else {
+            [self writeResponseWithStatusCode:502 message:error.localizedDescription ?: @"Recorded request failed."];
+        }
+
+        [self finishRequest];
+    });
+}
+
+- (void)URLProtocol:(NSURLProtocol *)__unused protocol
+wasRedirectedToRequest:(NSURLRequest *)__unused request
+   redirectResponse:(NSURLResponse *)__unused redirectResponse {
+
+    // Redirects recorded as regular response scenes.
+}
+
+- (void)URLProtocol:(NSURLProtocol *)__unused protocol cachedResponseIsValid:(NSCachedURLResponse *)__unused cachedResponse {
+
+    // Cached responses not used by cassette.
+}
+
+- (void)URLProtocol:(NSURLProtocol *)__unused protocol
+didReceiveAuthenticationChallenge:(NSURLAuthenticationChallenge *)__unused challenge {
+
+    // Authentication challenges not played by cassette.
+}
+
+- (void)URLProtocol:(NSURLProtocol *)__unused protocol
+didCancelAuthenticationChallenge:(NSURLAuthenticationChallenge *)__unused challenge {
+
+    // Authentication challenges not played by cassette.
+}
+
+
+#pragma mark - Misc
+
+- (void)closeConnection {
+
+    if (self.isClosed) {
+        return;
+    }
+
+    self.closed = YES;
+    [self.protocol stopLoading];
+    self.protocol = nil;
+
+    if (self.readSource) {
+        dispatch_source_cancel(self.readSource);
+        self.readSource = nil;
+    } else {
+        close(self.socket);
+    }
+
+    if (self.closeHandler) {
+        self.closeHandler(self);
+        self.closeHandler = nil;
+    }
+}
+
++ (NSSet<NSString *> *)hopByHopHeaders {
+
+    static NSSet<NSString *> *_hopByHopHeaders;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _hopByHopHeaders = [NSSet setWithArray:@[@"connection", @"keep-alive", @"proxy-connection", @"transfer-encoding",
+                                                 @"content-length", @"te", @"trailer", @"upgrade"]];
+    });
+
+    return _hopByHopHeaders;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,14 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVSerializationHelper.h"
+
+
+#pragma mark Constants
+
+/**
+ * @brief      Stores reference on class tag which is used for data stored as inline UTF-8 string.
+ * @discussion Such objects restored as \a NSData instances.
+ */
+extern NSString * const kYHVTextDataClassTag;
@@ -2,10 +2,15 @@
  * @author Serhii Mamontov
  * @since 1.0.0
  */
-#import "YHVSerializationHelper.h"
+#import "YHVSerializationHelper+Private.h"
 
 
-#pragma mark Constants
+#pragma mark Extern
+
+NSString * const kYHVTextDataClassTag = @"YHVText";
+
+
+#pragma mark - Constants
 
 /**
  * @brief  Stores reference on key under which name of serialized object class stored inside of serialized dictionary.
@@ -38,7 +43,8 @@ static NSString * const kYHVObjectClassKey = @"cls";
     }
     
     if (dictionary[kYHVObjectClassKey]) {
-        cls = NSClassFromString(dictionary[kYHVObjectClassKey]);
+        NSString *classTag = dictionary[kYHVObjectClassKey];
+        cls = [classTag isEqualToString:kYHVTextDataClassTag] ? [NSData class] : NSClassFromString(classTag);
         NSMutableDictionary *updatedDictionary = [dictionary mutableCopy];
         [updatedDictionary removeObjectForKey:kYHVObjectClassKey];
     }
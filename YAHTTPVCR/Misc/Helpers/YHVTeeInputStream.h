@@ -0,0 +1,72 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Types
+
+/**
+ * @brief  Streamed body capture completion block.
+ *
+ * @param path   Full path to file which contain all bytes which has been read from source stream.
+ * @param digest SHA-256 digest of bytes which has been read from source stream.
+ */
+typedef void(^YHVTeeInputStreamCompletionBlock)(NSString *path, NSData *digest);
+
+
+/**
+ * @brief      Input stream which forward source stream bytes to reader and copy them to file.
+ * @discussion Stream used to capture \c HTTPBodyStream of requests: while URL loading system read request body, every chunk written
+ *             to spill file and used to update body digest, so body can be recorded and matched w/o keeping it in memory.
+ *             Stream can be drained before it will be opened by URL loading system. In this case source stream bytes will be captured
+ *             and reader will receive them from spill file.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVTeeInputStream : NSInputStream
+
+
+#pragma mark Information
+
+/**
+ * @brief  Stores reference on full path to file into which source stream bytes is written.
+ */
+@property (nonatomic, readonly, copy) NSString *path;
+
+/**
+ * @brief  Stores reference on SHA-256 digest of source stream bytes.
+ * @note   Digest available only after source stream end has been reached.
+ */
+@property (nonatomic, nullable, readonly, strong) NSData *digest;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Create and configure tee stream.
+ *
+ * @param stream     Reference on stream from which bytes will be read.
+ * @param completion Reference on block which will be called when all source stream bytes will be written to file.
+ *
+ * @return Configured and ready to use tee stream.
+ */
++ (instancetype)streamWithInputStream:(NSInputStream *)stream completion:(nullable YHVTeeInputStreamCompletionBlock)completion;
+
+
+#pragma mark - Capture
+
+/**
+ * @brief      Read all bytes from source stream before URL loading system will open it.
+ * @discussion If stream already opened, it won't be drained and result will depend from whether capture already completed or not.
+ *
+ * @return Whether source stream body has been captured or not.
+ */
+- (BOOL)drain;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
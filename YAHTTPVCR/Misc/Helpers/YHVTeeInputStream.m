@@ -0,0 +1,416 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVTeeInputStream.h"
+#import <CommonCrypto/CommonDigest.h>
+
+
+#pragma mark Constants
+
+/**
+ * @brief  Stores size of buffer which is used to read source stream during drain.
+ */
+static NSUInteger const kYHVTeeInputStreamDrainBufferSize = 65536;
+
+
+#pragma mark - Private interface declaration
+
+@interface YHVTeeInputStream () {
+
+    /**
+     * @brief  Stores SHA-256 context which is updated with every chunk read from source stream.
+     */
+    CC_SHA256_CTX _context;
+
+    /**
+     * @brief  Stores reference on object which should receive stream events.
+     */
+    __weak id<NSStreamDelegate> _streamDelegate;
+}
+
+
+#pragma mark - Information
+
+/**
+ * @brief  Stores reference on stream from which body bytes is read.
+ */
+@property (nonatomic, strong) NSInputStream *stream;
+
+/**
+ * @brief      Stores reference on stream which is used to provide bytes to reader.
+ * @discussion Source stream or stream which read from spill file in case if source stream has been drained.
+ */
+@property (nonatomic, nullable, strong) NSInputStream *readStream;
+
+/**
+ * @brief  Stores reference on stream which is used to write source stream bytes into spill file.
+ */
+@property (nonatomic, nullable, strong) NSOutputStream *file;
+
+/**
+ * @brief  Stores reference on block which should be called when capture will be completed.
+ */
+@property (nonatomic, nullable, copy) YHVTeeInputStreamCompletionBlock completion;
+
+/**
+ * @brief  Stores reference on queue which is used to serialize stream open, drain and close.
+ */
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+
+@property (nonatomic, copy) NSString *path;
+@property (nonatomic, nullable, strong) NSData *digest;
+
+/**
+ * @brief  Stores current stream status.
+ */
+@property (nonatomic, assign) NSStreamStatus status;
+
+/**
+ * @brief  Stores reference on error which has been reported by source stream.
+ */
+@property (nonatomic, nullable, strong) NSError *error;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize tee stream.
+ *
+ * @param stream     Reference on stream from which bytes will be read.
+ * @param completion Reference on block which will be called when all source stream bytes will be written to file.
+ *
+ * @return Initialized and ready to use tee stream.
+ */
+- (instancetype)initWithInputStream:(NSInputStream *)stream completion:(nullable YHVTeeInputStreamCompletionBlock)completion;
+
+
+#pragma mark - Capture
+
+/**
+ * @brief  Open spill file and prepare digest context.
+ *
+ * @return Whether capture can be started or not.
+ */
+- (BOOL)beginCapture;
+
+/**
+ * @brief      Write bytes from source stream into spill file and update digest.
+ * @discussion If spill file write will fail, capture will be cancelled.
+ *
+ * @param bytes  Pointer on bytes which has been read from source stream.
+ * @param length Number of bytes which has been read from source stream.
+ */
+- (void)captureBytes:(const uint8_t *)bytes length:(NSUInteger)length;
+
+/**
+ * @brief  Close spill file, finalize digest and notify about capture completion.
+ */
+- (void)completeCapture;
+
+/**
+ * @brief  Close spill file and remove it because it doesn't contain whole source stream body.
+ */
+- (void)cancelCapture;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVTeeInputStream
+
+
+#pragma mark - Information
+
+- (id<NSStreamDelegate>)delegate {
+
+    return _streamDelegate;
+}
+
+- (void)setDelegate:(id<NSStreamDelegate>)delegate {
+
+    _streamDelegate = delegate ?: self;
+}
+
+- (NSStreamStatus)streamStatus {
+
+    return self.status;
+}
+
+- (NSError *)streamError {
+
+    return self.error;
+}
+
+- (BOOL)hasBytesAvailable {
+
+    return self.status == NSStreamStatusOpen && self.readStream.hasBytesAvailable;
+}
+
+- (id)propertyForKey:(NSStreamPropertyKey)key {
+
+    return [self.stream propertyForKey:key];
+}
+
+- (BOOL)setProperty:(id)property forKey:(NSStreamPropertyKey)key {
+
+    return [self.stream setProperty:property forKey:key];
+}
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)streamWithInputStream:(NSInputStream *)stream completion:(YHVTeeInputStreamCompletionBlock)completion {
+
+    return [[self alloc] initWithInputStream:stream completion:completion];
+}
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream completion:(YHVTeeInputStreamCompletionBlock)completion {
+
+    if ((self = [super init])) {
+        NSString *directory = [NSTemporaryDirectory() stringByAppendingPathComponent:@"com.yetanotherhttpvcr.request"];
+
+        _path = [directory stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+        _resourceAccessQueue = dispatch_queue_create("com.yetanotherhttpvcr.stream", DISPATCH_QUEUE_SERIAL);
+        _completion = [completion copy];
+        _status = NSStreamStatusNotOpen;
+        _streamDelegate = self;
+        _stream = stream;
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+
+    [_file close];
+    [NSFileManager.defaultManager removeItemAtPath:_path error:nil];
+}
+
+
+#pragma mark - Stream
+
+- (void)open {
+
+    dispatch_sync(self.resourceAccessQueue, ^{
+        if (self.status != NSStreamStatusNotOpen) {
+            return;
+        }
+
+        if (!self.readStream) {
+            self.readStream = self.stream;
+            [self beginCapture];
+        }
+
+        [self.readStream open];
+        self.status = NSStreamStatusOpen;
+    });
+}
+
+- (void)close {
+
+    dispatch_sync(self.resourceAccessQueue, ^{
+        if (self.status == NSStreamStatusClosed) {
+            return;
+        }
+
+        [self.readStream close];
+        [self cancelCapture];
+        self.status = NSStreamStatusClosed;
+    });
+}
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len {
+
+    NSInteger length = [self.readStream read:buffer maxLength:len];
+    BOOL capturing = self.readStream == self.stream;
+
+    if (length < 0) {
+        self.error = self.readStream.streamError;
+        self.status = NSStreamStatusError;
+
+        if (capturing) {
+            [self cancelCapture];
+        }
+
+        return length;
+    }
+
+    if (capturing && length > 0) {
+        [self captureBytes:buffer length:(NSUInteger)length];
+    }
+
+    if (length == 0 || self.readStream.streamStatus == NSStreamStatusAtEnd) {
+        self.status = NSStreamStatusAtEnd;
+
+        if (capturing) {
+            [self completeCapture];
+        }
+    }
+
+    return length;
+}
+
+- (BOOL)getBuffer:(uint8_t * _Nullable *)__unused buffer length:(NSUInteger *)__unused len {
+
+    return NO;
+}
+
+- (void)scheduleInRunLoop:(NSRunLoop *)__unused aRunLoop forMode:(NSRunLoopMode)__unused mode {
+
+    // Stream is read synchronously, so there is no events to schedule.
+}
+
+- (void)removeFromRunLoop:(NSRunLoop *)__unused aRunLoop forMode:(NSRunLoopMode)__unused mode {
+
+    // Stream is read synchronously, so there is no events to unschedule.
+}
+
+
+#pragma mark - CFReadStream bridging
+
+/**
+ * @brief      CFNetwork use toll-free bridged \a CFReadStream API with \c HTTPBodyStream.
+ * @discussion Declining client callbacks make CFNetwork to read body synchronously.
+ */
+- (void)_scheduleInCFRunLoop:(CFRunLoopRef)__unused runLoop forMode:(CFStringRef)__unused mode {
+}
+
+- (void)_unscheduleFromCFRunLoop:(CFRunLoopRef)__unused runLoop forMode:(CFStringRef)__unused mode {
+}
+
+- (BOOL)_setCFClientFlags:(CFOptionFlags)__unused flags
+                 callback:(CFReadStreamClientCallBack)__unused callback
+                  context:(CFStreamClientContext *)__unused context {
+
+    return NO;
+}
+
+
+#pragma mark - Capture
+
+- (BOOL)drain {
+
+    __block BOOL drained = NO;
+
+    dispatch_sync(self.resourceAccessQueue, ^{
+        if (self.status != NSStreamStatusNotOpen || self.readStream) {
+            drained = self.digest != nil;
+            return;
+        }
+
+        if (![self beginCapture]) {
+            return;
+        }
+
+        uint8_t *buffer = malloc(kYHVTeeInputStreamDrainBufferSize);
+        NSInteger length = 0;
+
+        [self.stream open];
+
+        while (self.file && (length = [self.stream read:buffer maxLength:kYHVTeeInputStreamDrainBufferSize]) > 0) {
+            [self captureBytes:buffer length:(NSUInteger)length];
+        }
+
+        [self.stream close];
+        free(buffer);
+
+        if (length == 0 && self.file) {
+            [self completeCapture];
+            self.readStream = [NSInputStream inputStreamWithFileAtPath:self.path];
+            drained = YES;
+        } else {
+            // Source stream partially consumed and can't be used by reader anymore.
+            self.error = self.stream.streamError ?: [NSError errorWithDomain:NSPOSIXErrorDomain code:EIO userInfo:nil];
+            self.status = NSStreamStatusError;
+            [self cancelCapture];
+        }
+    });
+
+    return drained;
+}
+
+- (BOOL)beginCapture {
+
+    NSString *directory = [self.path stringByDeletingLastPathComponent];
+
+    if (![NSFileManager.defaultManager createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil]) {
+        return NO;
+    }
+
+    self.file = [NSOutputStream outputStreamToFileAtPath:self.path append:NO];
+    [self.file open];
+
+    if (self.file.streamStatus != NSStreamStatusOpen) {
+        self.file = nil;
+
+        return NO;
+    }
+
+    CC_SHA256_Init(&_context);
+
+    return YES;
+}
+
+- (void)captureBytes:(const uint8_t *)bytes length:(NSUInteger)length {
+
+    if (!self.file) {
+        return;
+    }
+
+    CC_SHA256_Update(&_context, bytes, (CC_LONG)length);
+
+    while (length > 0) {
+        NSInteger written = [self.file write:bytes maxLength:length];
+
+        if (written <= 0) {
+            [self cancelCapture];
+            break;
+        }
+
+        bytes += written;
+        length -= (NSUInteger)written;
+    }
+}
+
+- (void)completeCapture {
+
+    if (!self.file) {
+        return;
+    }
+
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    YHVTeeInputStreamCompletionBlock completion = self.completion;
+
+    [self.file close];
+    self.file = nil;
+    self.completion = nil;
+
+    CC_SHA256_Final(digest, &_context);
+    self.digest = [NSData dataWithBytes:digest length:CC_SHA256_DIGEST_LENGTH];
+
+    if (completion) {
+        completion(self.path, self.digest);
+    }
+}
+
+- (void)cancelCapture {
+
+    if (!self.file) {
+        return;
+    }
+
+    [self.file close];
+    self.file = nil;
+
+    [NSFileManager.defaultManager removeItemAtPath:self.path error:nil];
+}
+
+#pragma mark -
+
+
+@end
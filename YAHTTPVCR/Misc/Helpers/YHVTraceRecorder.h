@@ -0,0 +1,92 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      Cassette's timeline recorder.
+ * @discussion Recorder collect events in Chrome trace-event format, so timeline can be opened in any trace viewer (like
+ *             \c chrome://tracing or Perfetto). Each recorder represented as separate process in trace and each chapter as separate
+ *             thread (track) of this process.
+ *             Events can be added from any thread.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVTraceRecorder : NSObject
+
+
+#pragma mark Initialization and Configuration
+
+/**
+ * @brief  Create and configure timeline recorder.
+ *
+ * @param name Reference on name under which recorder's events will be shown in trace viewer.
+ *
+ * @return Configured and ready to use recorder.
+ */
++ (instancetype)recorderWithName:(NSString *)name;
+
+
+#pragma mark - Events
+
+/**
+ * @brief  Set name which should be shown in trace viewer for track.
+ *
+ * @param name       Reference on track's name.
+ * @param identifier Unique track identifier (chapter identifier).
+ */
+- (void)setName:(NSString *)name forTrack:(nullable NSString *)identifier;
+
+/**
+ * @brief  Start span on specified track.
+ *
+ * @param name       Reference on span's name.
+ * @param category   Reference on span's category.
+ * @param identifier Unique track identifier (chapter identifier).
+ */
+- (void)beginSpanWithName:(NSString *)name category:(NSString *)category onTrack:(nullable NSString *)identifier;
+
+/**
+ * @brief      Complete span on specified track.
+ * @discussion Call ignored if span with same \c name hasn't been started on track.
+ *
+ * @param name       Reference on span's name.
+ * @param identifier Unique track identifier (chapter identifier).
+ * @param arguments  Reference on additional information which should be shown for span.
+ */
+- (void)endSpanWithName:(NSString *)name onTrack:(nullable NSString *)identifier arguments:(nullable NSDictionary *)arguments;
+
+/**
+ * @brief  Add instant event to specified track.
+ *
+ * @param name       Reference on event's name.
+ * @param category   Reference on event's category.
+ * @param identifier Unique track identifier (chapter identifier).
+ * @param arguments  Reference on additional information which should be shown for event.
+ */
+- (void)markEventWithName:(NSString *)name
+                 category:(NSString *)category
+                  onTrack:(nullable NSString *)identifier
+                arguments:(nullable NSDictionary *)arguments;
+
+
+#pragma mark - Storage
+
+/**
+ * @brief      Append collected events to trace file.
+ * @discussion File truncated when first recorder write into it in current process, so events from all cassettes used by test suite
+ *             stored in same file. Written events removed from recorder.
+ *
+ * @param path Reference on path to trace file.
+ *
+ * @return Whether events has been written or not.
+ */
+- (BOOL)appendToFileAtPath:(NSString *)path;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,329 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVTraceRecorder.h"
+#import <stdatomic.h>
+
+
+#pragma mark Statics
+
+/**
+ * @brief  Storage for identifier which has been assigned to last created recorder.
+ */
+static atomic_uint YHVTraceRecorderLastProcessIdentifier = 0;
+
+
+#pragma mark - Functions
+
+/**
+ * @brief  Current time in trace-event format units.
+ *
+ * @return Number of microseconds since 1970.
+ */
+static double YHVTraceTimestamp(void) {
+
+    return (CFAbsoluteTimeGetCurrent() + kCFAbsoluteTimeIntervalSince1970) * 1000000.f;
+}
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Protected interface declaration
+
+@interface YHVTraceRecorder ()
+
+
+#pragma mark - Information
+
+/**
+ * @brief  Stores identifier which is used as recorder's process identifier in trace.
+ */
+@property (nonatomic, assign) NSUInteger processIdentifier;
+
+/**
+ * @brief  Stores reference on list of collected and not written events.
+ */
+@property (nonatomic, strong) NSMutableArray<NSDictionary *> *events;
+
+/**
+ * @brief  Stores reference on dictionary which maps track identifier to it's thread identifier in trace.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *tracks;
+
+/**
+ * @brief  Stores reference on dictionary which maps track and span name to started span information.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary *> *openedSpans;
+
+/**
+ * @brief  Stores reference on queue which is used to serialize access to collected events.
+ */
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize timeline recorder.
+ *
+ * @param name Reference on name under which recorder's events will be shown in trace viewer.
+ *
+ * @return Initialized and ready to use recorder.
+ */
+- (instancetype)initWithName:(NSString *)name;
+
+
+#pragma mark - Events
+
+/**
+ * @brief      Find thread identifier for track.
+ * @discussion Identifier assigned on first track usage. Should be called on \c resourceAccessQueue.
+ *
+ * @param identifier Unique track identifier.
+ *
+ * @return Thread identifier which should be used for track's events.
+ */
+- (NSNumber *)threadIdentifierForTrack:(NSString *)identifier;
+
+
+#pragma mark - Storage
+
+/**
+ * @brief  Retrieve queue which is used to serialize trace files access.
+ *
+ * @return Reference on shared serial queue.
+ */
++ (dispatch_queue_t)storageQueue;
+
+/**
+ * @brief  Retrieve list of trace files which has been written in current process.
+ *
+ * @return Reference on shared set of trace file paths.
+ */
++ (NSMutableSet<NSString *> *)writtenPaths;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVTraceRecorder
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)recorderWithName:(NSString *)name {
+
+    return [[self alloc] initWithName:name];
+}
+
+- (instancetype)initWithName:(NSString *)name {
+
+    if ((self = [super init])) {
+        _resourceAccessQueue = dispatch_queue_create("com.yetanotherhttpvcr.trace", DISPATCH_QUEUE_SERIAL);
+        _processIdentifier = atomic_fetch_add(&YHVTraceRecorderLastProcessIdentifier, 1) + 1;
+        _openedSpans = [NSMutableDictionary new];
+        _tracks = [NSMutableDictionary new];
+        _events = [NSMutableArray new];
+
+        [_events addObject:@{
+            @"name": @"process_name",
+            @"ph": @"M",
+            @"pid": @(_processIdentifier),
+            @"args": @{ @"name": name ?: @"cassette" }
+        }];
+    }
+
+    return self;
+}
+
+
+#pragma mark - Events
+
+- (void)setName:(NSString *)name forTrack:(NSString *)identifier {
+
+    if (!identifier || !name) {
+        return;
+    }
+
+    dispatch_async(self.resourceAccessQueue, ^{
+        [self.events addObject:@{
+            @"name": @"thread_name",
+            @"ph": @"M",
+            @"pid": @(self.processIdentifier),
+            @"tid": [self threadIdentifierForTrack:identifier],
+            @"args": @{ @"name": name }
+        }];
+    });
+}
+
+- (void)beginSpanWithName:(NSString *)name category:(NSString *)category onTrack:(NSString *)identifier {
+
+    double timestamp = YHVTraceTimestamp();
+
+    if (!identifier) {
+        return;
+    }
+
+    dispatch_async(self.resourceAccessQueue, ^{
+        NSString *spanKey = [@[identifier, name] componentsJoinedByString:@"/"];
+        self.openedSpans[spanKey] = @{ @"ts": @(timestamp), @"cat": category };
+    });
+}
+
+- (void)endSpanWithName:(NSString *)name onTrack:(NSString *)identifier arguments:(NSDictionary *)arguments {
+
+    double timestamp = YHVTraceTimestamp();
+
+    if (!identifier) {
+        return;
+    }
+
+    dispatch_async(self.resourceAccessQueue, ^{
+        NSString *spanKey = [@[identifier, name] componentsJoinedByString:@"/"];
+        NSDictionary *span = self.openedSpans[spanKey];
+
+        if (!span) {
+            return;
+        }
+
+        [self.openedSpans removeObjectForKey:spanKey];
+        [self.events addObject:@{
+            @"name": name,
+            @"cat": span[@"cat"],
+            @"ph": @"X",
+            @"ts": span[@"ts"],
+            @"dur": @(MAX(timestamp - [span[@"ts"] doubleValue], 0.f)),
+            @"pid": @(self.processIdentifier),
+            @"tid": [self threadIdentifierForTrack:identifier],
+            @"args": arguments ?: @{}
+        }];
+    });
+}
+
+- (void)markEventWithName:(NSString *)name
+                 category:(NSString *)category
+                  onTrack:(NSString *)identifier
+                arguments:(NSDictionary *)arguments {
+
+    double timestamp = YHVTraceTimestamp();
+
+    if (!identifier) {
+        return;
+    }
+
+    dispatch_async(self.resourceAccessQueue, ^{
+        [self.events addObject:@{
+            @"name": name,
+            @"cat": category,
+            @"ph": @"i",
+            @"s": @"t",
+            @"ts": @(timestamp),
+            @"pid": @(self.processIdentifier),
+            @"tid": [self threadIdentifierForTrack:identifier],
+            @"args": arguments ?: @{}
+        }];
+    });
+}
+
+- (NSNumber *)threadIdentifierForTrack:(NSString *)identifier {
+
+    NSNumber *threadIdentifier = self.tracks[identifier];
+
+    if (!threadIdentifier) {
+        threadIdentifier = @(self.tracks.count + 1);
+        self.tracks[identifier] = threadIdentifier;
+    }
+
+    return threadIdentifier;
+}
+
+
+#pragma mark - Storage
+
++ (dispatch_queue_t)storageQueue {
+
+    static dispatch_queue_t _storageQueue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _storageQueue = dispatch_queue_create("com.yetanotherhttpvcr.trace.storage", DISPATCH_QUEUE_SERIAL);
+    });
+
+    return _storageQueue;
+}
+
++ (NSMutableSet<NSString *> *)writtenPaths {
+
+    static NSMutableSet<NSString *> *_writtenPaths;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _writtenPaths = [NSMutableSet new];
+    });
+
+    return _writtenPaths;
+}
+
+- (BOOL)appendToFileAtPath:(NSString *)path {
+
+    __block NSArray<NSDictionary *> *events = nil;
+    __block BOOL written = NO;
+
+    dispatch_sync(self.resourceAccessQueue, ^{
+        events = [self.events copy];
+        [self.events removeAllObjects];
+    });
+
+    if (!events.count) {
+        return YES;
+    }
+
+    dispatch_sync([[self class] storageQueue], ^{
+        NSFileManager *fileManager = NSFileManager.defaultManager;
+        NSMutableSet<NSString *> *writtenPaths = [[self class] writtenPaths];
+
+        // JSON array format allow to omit closing bracket, so events from next cassettes can be appended to same file.
+        if (![writtenPaths containsObject:path] || ![fileManager fileExistsAtPath:path]) {
+            [fileManager createDirectoryAtPath:[path stringByDeletingLastPathComponent]
+                   withIntermediateDirectories:YES
+                                    attributes:nil
+                                         error:nil];
+
+            if (![[@"[\n" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:path atomically:YES]) {
+                return;
+            }
+
+            [writtenPaths addObject:path];
+        }
+
+        NSFileHandle *file = [NSFileHandle fileHandleForWritingAtPath:path];
+        NSMutableData *content = [NSMutableData new];
+        NSData *separator = [@",\n" dataUsingEncoding:NSUTF8StringEncoding];
+
+        for (NSDictionary *event in events) {
+            NSData *eventData = [NSJSONSerialization dataWithJSONObject:event options:(NSJSONWritingOptions)0 error:nil];
+
+            if (eventData) {
+                [content appendData:eventData];
+                [content appendData:separator];
+            }
+        }
+
+        [file seekToEndOfFile];
+        [file writeData:content];
+        [file closeFile];
+        written = file != nil;
+    });
+
+    return written;
+}
+
+#pragma mark -
+
+
+@end
@@ -0,0 +1,54 @@
+#import <Foundation/Foundation.h>
+#import "YHVStructures.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      Cassette's URL rewriter.
+ * @discussion Rewriter parse URL once and apply path and query parameters filters to parsed components. Query segment replaced in
+ *             place, so rest of URL doesn't change.
+ *             When filters depend only from URL (default path filter and query parameters filter created from dictionary), results
+ *             memoized per original URL for rewriter's lifetime.
+ *             URL can be rewritten from any thread.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVURLRewriter : NSObject
+
+
+#pragma mark Initialization and Configuration
+
+/**
+ * @brief  Create and configure URL rewriter.
+ *
+ * @param pathFilter  Reference on block which should be used to get filtered URL path.
+ * @param queryFilter Reference on block which should be used to filter URL query parameters.
+ * @param memoize     Whether filters result depends only from URL and can be stored for next calls with same URL or not.
+ *
+ * @return Configured and ready to use URL rewriter.
+ */
++ (instancetype)rewriterWithPathFilter:(nullable YHVPathFilterBlock)pathFilter
+                 queryParametersFilter:(nullable YHVQueryParametersFilterBlock)queryFilter
+                               memoize:(BOOL)memoize;
+
+
+#pragma mark - Rewrite
+
+/**
+ * @brief  Apply filters to passed URL.
+ *
+ * @param url     Reference on URL which should be filtered.
+ * @param request Reference on request for which URL should be filtered.
+ *
+ * @return Filtered URL.
+ */
+- (NSURL *)rewrittenURL:(NSURL *)url forRequest:(NSURLRequest *)request;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,192 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVURLRewriter.h"
+#import "NSDictionary+YHVNSURL.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark Protected interface declaration
+
+@interface YHVURLRewriter ()
+
+
+#pragma mark - Information
+
+/**
+ * @brief  Stores reference on block which should be used to get filtered URL path.
+ */
+@property (nonatomic, nullable, copy) YHVPathFilterBlock pathFilter;
+
+/**
+ * @brief  Stores reference on block which should be used to filter URL query parameters.
+ */
+@property (nonatomic, nullable, copy) YHVQueryParametersFilterBlock queryFilter;
+
+/**
+ * @brief  Stores reference on dictionary which maps original URL string to rewritten URL.
+ * @discussion Dictionary exists only if rewrite results can be memoized.
+ */
+@property (nonatomic, nullable, strong) NSMutableDictionary<NSString *, NSURL *> *rewrittenURLs;
+
+/**
+ * @brief  Stores reference on queue which is used to serialize access to memoized URLs.
+ */
+@property (nonatomic, strong) dispatch_queue_t resourceAccessQueue;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize URL rewriter.
+ *
+ * @param pathFilter  Reference on block which should be used to get filtered URL path.
+ * @param queryFilter Reference on block which should be used to filter URL query parameters.
+ * @param memoize     Whether filters result depends only from URL and can be stored for next calls with same URL or not.
+ *
+ * @return Initialized and ready to use URL rewriter.
+ */
+- (instancetype)initWithPathFilter:(nullable YHVPathFilterBlock)pathFilter
+             queryParametersFilter:(nullable YHVQueryParametersFilterBlock)queryFilter
+                           memoize:(BOOL)memoize;
+
+
+#pragma mark - Rewrite
+
+/**
+ * @brief  Apply filters to passed URL w/o memoized results usage.
+ *
+ * @param url     Reference on URL which should be filtered.
+ * @param request Reference on request for which URL should be filtered.
+ *
+ * @return Filtered URL.
+ */
+- (NSURL *)filteredURL:(NSURL *)url forRequest:(NSURLRequest *)request;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVURLRewriter
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)rewriterWithPathFilter:(YHVPathFilterBlock)pathFilter
+                 queryParametersFilter:(YHVQueryParametersFilterBlock)queryFilter
+                               memoize:(BOOL)memoize {
+
+    return [[self alloc] initWithPathFilter:pathFilter queryParametersFilter:queryFilter memoize:memoize];
+}
+
+- (instancetype)initWithPathFilter:(YHVPathFilterBlock)pathFilter
+             queryParametersFilter:(YHVQueryParametersFilterBlock)queryFilter
+                           memoize:(BOOL)memoize {
+
+    if ((self = [super init])) {
+        _resourceAccessQueue = dispatch_queue_create("com.yetanotherhttpvcr.url-rewriter", DISPATCH_QUEUE_SERIAL);
+        _rewrittenURLs = memoize ? [NSMutableDictionary new] : nil;
+        _queryFilter = [queryFilter copy];
+        _pathFilter = [pathFilter copy];
+    }
+
+    return self;
+}
+
+
+#pragma mark - Rewrite
+
+- (NSURL *)rewrittenURL:(NSURL *)url forRequest:(NSURLRequest *)request {
+
+    if (!url || (!self.pathFilter && !self.queryFilter)) {
+        return url;
+    }
+
+    if (!self.rewrittenURLs) {
+        return [self filteredURL:url forRequest:request];
+    }
+
+    NSString *originalURLString = url.absoluteString;
+    __block NSURL *rewrittenURL = nil;
+
+    dispatch_sync(self.resourceAccessQueue, ^{
+        rewrittenURL = self.rewrittenURLs[originalURLString];
+    });
+
+    if (!rewrittenURL) {
+        rewrittenURL = [self filteredURL:url forRequest:request];
+
+        dispatch_sync(self.resourceAccessQueue, ^{
+            self.rewrittenURLs[originalURLString] = rewrittenURL;
+        });
+    }
+
+    return rewrittenURL;
+}
+
+- (NSURL *)filteredURL:(NSURL *)url forRequest:(NSURLRequest *)request {
+
+    NSURLComponents *components = [NSURLComponents componentsWithURL:url resolvingAgainstBaseURL:NO];
+    NSURLRequest *filteredRequest = request;
+
+    if (!components) {
+        return url;
+    }
+
+    // Filters expect to receive request with URL which is filtered.
+    if (![request.URL isEqual:url]) {
+        NSMutableURLRequest *mutableRequest = [request mutableCopy];
+        mutableRequest.URL = url;
+        filteredRequest = mutableRequest;
+    }
+
+    if (self.pathFilter) {
+        components.path = self.pathFilter(filteredRequest);
+    }
+
+    NSString *query = components.percentEncodedQuery;
+
+    if (!self.queryFilter || !query.length) {
+        return components.URL ?: url;
+    }
+
+    NSDictionary *queryParameters = [NSDictionary YHV_dictionaryWithQuery:query sortQueryListOnMatch:NO];
+    NSMutableDictionary *filteredQueryParameters = [queryParameters mutableCopy];
+    self.queryFilter(filteredRequest, filteredQueryParameters);
+
+    if ([filteredQueryParameters isEqualToDictionary:queryParameters]) {
+        return components.URL ?: url;
+    }
+
+    NSString *filteredQuery = [filteredQueryParameters YHV_toQueryString];
+
+    if (!filteredQuery) {
+        components.percentEncodedQuery = nil;
+
+        return components.URL ?: url;
+    }
+
+    NSString *urlString = components.string;
+    NSRange queryRange = components.rangeOfQuery;
+
+    if (!urlString || queryRange.location == NSNotFound) {
+        return url;
+    }
+
+    urlString = [urlString stringByReplacingCharactersInRange:queryRange withString:filteredQuery];
+
+    return [NSURL URLWithString:urlString] ?: url;
+}
+
+#pragma mark -
+
+
+@end
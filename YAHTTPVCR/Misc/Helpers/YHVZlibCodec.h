@@ -0,0 +1,85 @@
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * @brief      Streaming zlib compression / decompression helper.
+ * @discussion Codec accept input in chunks and accumulate output in buffer which grow geometrically, so large bodies processed in
+ *             linear time. Inflater understand both \c gzip and \c zlib wrapped data, deflater produce \c gzip wrapped data.
+ *
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+@interface YHVZlibCodec : NSObject
+
+
+#pragma mark Information
+
+/**
+ * @brief  Stores whether codec reached end of compressed stream or has been finished.
+ */
+@property (nonatomic, readonly, assign, getter = isFinished) BOOL finished;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Create and configure codec which decompress \c gzip or \c zlib wrapped data.
+ *
+ * @return Configured and ready to use codec or \c nil in case if zlib stream can't be initialized.
+ */
++ (nullable instancetype)inflater;
+
+/**
+ * @brief  Create and configure codec which compress data into \c gzip wrapped data.
+ *
+ * @return Configured and ready to use codec or \c nil in case if zlib stream can't be initialized.
+ */
++ (nullable instancetype)deflater;
+
+/**
+ * @brief  Decompress \c gzip or \c zlib wrapped data.
+ *
+ * @param data Reference on compressed data.
+ *
+ * @return Decompressed data or \c nil in case of decompression error.
+ */
++ (nullable NSData *)inflateData:(NSData *)data;
+
+/**
+ * @brief  Compress data into \c gzip wrapped data.
+ *
+ * @param data Reference on data which should be compressed.
+ *
+ * @return Compressed data or \c nil in case of compression error.
+ */
++ (nullable NSData *)deflateData:(NSData *)data;
+
+
+#pragma mark - Processing
+
+/**
+ * @brief      Process next chunk of input data.
+ * @discussion Output which has been produced for passed chunk appended to codec's output buffer.
+ *
+ * @param data Reference on next chunk of data which should be processed.
+ *
+ * @return Whether chunk has been processed or error happened.
+ */
+- (BOOL)appendData:(NSData *)data;
+
+/**
+ * @brief      Complete processing and retrieve whole output.
+ * @discussion Codec can't be used after this method call.
+ *
+ * @return Reference on codec's output or \c nil in case of processing error or if inflater didn't reach end of compressed stream.
+ */
+- (nullable NSData *)finish;
+
+#pragma mark -
+
+
+@end
+
+NS_ASSUME_NONNULL_END
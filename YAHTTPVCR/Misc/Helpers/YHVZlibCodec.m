@@ -0,0 +1,294 @@
+/**
+ * @author Serhii Mamontov
+ * @since 1.6.0
+ */
+#import "YHVZlibCodec.h"
+#import <zlib.h>
+
+
+#pragma mark Constants
+
+/**
+ * @brief  Stores window bits which allow inflater to detect \c gzip and \c zlib headers automatically.
+ */
+static int const kYHVZlibCodecInflateWindowBits = 47;
+
+/**
+ * @brief  Stores window bits which force deflater to use \c gzip header and trailer.
+ */
+static int const kYHVZlibCodecDeflateWindowBits = 31;
+
+/**
+ * @brief  Stores minimum size of output buffer.
+ */
+static NSUInteger const kYHVZlibCodecMinimumBufferLength = 16384;
+
+
+#pragma mark - Private interface declaration
+
+@interface YHVZlibCodec () {
+
+    /**
+     * @brief  Stores zlib stream state.
+     */
+    z_stream _stream;
+}
+
+
+#pragma mark - Information
+
+/**
+ * @brief  Stores whether codec decompress or compress data.
+ */
+@property (nonatomic, assign) BOOL inflating;
+
+/**
+ * @brief  Stores whether zlib stream has been initialized and not released yet.
+ */
+@property (nonatomic, assign) BOOL streamActive;
+
+/**
+ * @brief  Stores whether zlib reported error during data processing.
+ */
+@property (nonatomic, assign) BOOL failed;
+
+/**
+ * @brief  Stores reference on buffer into which output is written.
+ */
+@property (nonatomic, strong) NSMutableData *output;
+
+/**
+ * @brief  Stores number of bytes which has been written into output buffer.
+ */
+@property (nonatomic, assign) NSUInteger outputLength;
+
+@property (nonatomic, assign, getter = isFinished) BOOL finished;
+
+
+#pragma mark - Initialization and Configuration
+
+/**
+ * @brief  Initialize codec.
+ *
+ * @param inflating Whether codec should decompress or compress data.
+ *
+ * @return Initialized and ready to use codec or \c nil in case if zlib stream can't be initialized.
+ */
+- (nullable instancetype)initForInflating:(BOOL)inflating;
+
+
+#pragma mark - Processing
+
+/**
+ * @brief      Make sure what output buffer has at least specified number of free bytes.
+ * @discussion Buffer length doubled each time when it should grow, so number of reallocations is logarithmic to output size.
+ *
+ * @param length Number of bytes which should be available in output buffer.
+ */
+- (void)reserveOutputCapacity:(NSUInteger)length;
+
+/**
+ * @brief  Pass input which is set on zlib stream through codec.
+ *
+ * @param flush zlib flush mode which should be used.
+ *
+ * @return Whether input has been processed or error happened.
+ */
+- (BOOL)processWithFlush:(int)flush;
+
+#pragma mark -
+
+
+@end
+
+
+#pragma mark - Interface implementation
+
+@implementation YHVZlibCodec
+
+
+#pragma mark - Initialization and Configuration
+
++ (instancetype)inflater {
+
+    return [[self alloc] initForInflating:YES];
+}
+
++ (instancetype)deflater {
+
+    return [[self alloc] initForInflating:NO];
+}
+
++ (NSData *)inflateData:(NSData *)data {
+
+    YHVZlibCodec *codec = [self inflater];
+    [codec reserveOutputCapacity:data.length * 2];
+
+    return [codec appendData:data] ? [codec finish] : nil;
+}
+
++ (NSData *)deflateData:(NSData *)data {
+
+    YHVZlibCodec *codec = [self deflater];
+
+    if (codec) {
+        [codec reserveOutputCapacity:(NSUInteger)deflateBound(&codec->_stream, (uLong)data.length)];
+    }
+
+    return [codec appendData:data] ? [codec finish] : nil;
+}
+
+- (instancetype)initForInflating:(BOOL)inflating {
+
+    if ((self = [super init])) {
+        int status = Z_OK;
+
+        bzero(&_stream, sizeof(_stream));
+        _stream.zalloc = Z_NULL;
+        _stream.zfree = Z_NULL;
+        _stream.opaque = Z_NULL;
+        _output = [NSMutableData new];
+        _inflating = inflating;
+
+        if (inflating) {
+            status = inflateInit2(&_stream, kYHVZlibCodecInflateWindowBits);
+        } else {
+            status = deflateInit2(&_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, kYHVZlibCodecDeflateWindowBits, 8, Z_DEFAULT_STRATEGY);
+        }
+
+        if (status != Z_OK) {
+            return nil;
+        }
+
+        _streamActive = YES;
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+
+    if (!_streamActive) {
+        return;
+    }
+
+    if (_inflating) {
+        inflateEnd(&_stream);
+    } else {
+        deflateEnd(&_stream);
+    }
+}
+
+
+#pragma mark - Processing
+
+- (BOOL)appendData:(NSData *)data {
+
+    if (!self.streamActive || self.failed) {
+        return NO;
+    }
+
+    [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+        const Bytef *chunk = bytes;
+        NSUInteger length = byteRange.length;
+
+        // zlib stream use 32-bit counter for input, so huge ranges passed in parts.
+        while (length > 0 && !self.failed && !self.finished) {
+            uInt chunkLength = (uInt)MIN(length, (NSUInteger)UINT_MAX);
+
+            self->_stream.next_in = (Bytef *)chunk;
+            self->_stream.avail_in = chunkLength;
+
+            [self processWithFlush:Z_NO_FLUSH];
+
+            chunk += chunkLength;
+            length -= chunkLength;
+        }
+
+        *stop = self.failed || self.finished;
+    }];
+
+    _stream.next_in = Z_NULL;
+    _stream.avail_in = 0;
+
+    return !self.failed;
+}
+
+- (NSData *)finish {
+
+    if (!self.streamActive) {
+        return nil;
+    }
+
+    BOOL processed = [self processWithFlush:Z_FINISH];
+
+    // Inflater which hasn't reached end of compressed stream received truncated input.
+    if (self.inflating && !self.finished) {
+        processed = NO;
+    }
+
+    if (self.inflating) {
+        inflateEnd(&_stream);
+    } else {
+        deflateEnd(&_stream);
+    }
+
+    self.streamActive = NO;
+    self.finished = YES;
+
+    if (!processed) {
+        return nil;
+    }
+
+    [self.output setLength:self.outputLength];
+
+    return self.output;
+}
+
+- (void)reserveOutputCapacity:(NSUInteger)length {
+
+    NSUInteger requiredLength = self.outputLength + MAX(length, 1);
+    NSUInteger bufferLength = MAX(self.output.length, kYHVZlibCodecMinimumBufferLength);
+
+    if (requiredLength <= self.output.length) {
+        return;
+    }
+
+    while (bufferLength < requiredLength) {
+        bufferLength *= 2;
+    }
+
+    [self.output setLength:bufferLength];
+}
+
+- (BOOL)processWithFlush:(int)flush {
+
+    while (!self.failed && !self.finished) {
+        [self reserveOutputCapacity:1];
+
+        uInt availableOutput = (uInt)MIN(self.output.length - self.outputLength, (NSUInteger)UINT_MAX);
+        _stream.next_out = (Bytef *)self.output.mutableBytes + self.outputLength;
+        _stream.avail_out = availableOutput;
+
+        int status = self.inflating ? inflate(&_stream, flush) : deflate(&_stream, flush);
+        self.outputLength += availableOutput - _stream.avail_out;
+
+        if (status == Z_STREAM_END) {
+            self.finished = YES;
+        } else if (status != Z_OK && status != Z_BUF_ERROR) {
+            self.failed = YES;
+        } else if (_stream.avail_out > 0 && (_stream.avail_in == 0 || status == Z_BUF_ERROR)) {
+            // All input consumed and there is no pending output. Deflater keep going till end of stream on finish.
+            if (flush != Z_FINISH || self.inflating || status == Z_BUF_ERROR) {
+                break;
+            }
+        }
+    }
+
+    return !self.failed;
+}
+
+#pragma mark -
+
+
+@end
@@ -10,6 +10,17 @@
 @interface YHVNSURLProtocol : NSURLProtocol
 
 
+#pragma mark Information
+
+/**
+ * @brief      Stores reference on context which should be stamped on requests handled by protocol.
+ * @discussion Context set for protocol subclasses which is bound to specific session configurations.
+ *
+ * @since 1.6.0
+ */
+@property (class, nonatomic, nullable, copy) NSString *context;
+
+
 #pragma mark -
 
 
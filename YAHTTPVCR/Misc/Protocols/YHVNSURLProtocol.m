@@ -5,6 +5,17 @@
 #import "YHVNSURLProtocol.h"
 #import "NSURLRequest+YHVPlayer.h"
 #import "YHVVCR+Player.h"
+#import <objc/runtime.h>
+
+
+#pragma mark Statics
+
+/**
+ * @brief  Key under which protocol's context stored as associated object of protocol class.
+ *
+ * @since 1.6.0
+ */
+static char YHVNSURLProtocolContextKey;
 
 
 #pragma mark Interface implementation
@@ -12,10 +23,29 @@
 @implementation YHVNSURLProtocol
 
 
+#pragma mark - Information
+
++ (NSString *)context {
+    
+    return objc_getAssociatedObject(self, &YHVNSURLProtocolContextKey);
+}
+
++ (void)setContext:(NSString *)context {
+    
+    objc_setAssociatedObject(self, &YHVNSURLProtocolContextKey, context, OBJC_ASSOCIATION_COPY);
+}
+
+
 #pragma mark - Request handling
 
 + (BOOL)canInitWithRequest:(NSURLRequest *)request {
     
+    NSString *context = self.context;
+    
+    if (context && !request.YHV_context) {
+        request.YHV_context = context;
+    }
+    
     return [YHVVCR canPlayResponseForRequest:request];
 }
 
@@ -11,6 +11,10 @@
 #import "YHVConfiguration.h"
 #import "YHVStructures.h"
 #import "YHVCassette.h"
+#import "YHVCassetteStatistics.h"
+#import "YHVReplayServer.h"
+#import "YHVLoadReplayer.h"
+#import "YHVLoadReplayReport.h"
 #import "YHVVCR.h"
 
 #import "YHVTestCase.h"